@@ -0,0 +1,26 @@
+# P.H.2025: cadena arm-none-eabi-gcc para el LPC2105 (ARM7TDMI)
+#
+# Todo en modo ARM: las rutinas __irq y el acceso al CPSR no existen en
+# Thumb-1. Si el compilador no esta en el PATH: ARM_NONE_EABI_DIR=/ruta/bin
+
+set(CMAKE_SYSTEM_NAME Generic)
+set(CMAKE_SYSTEM_PROCESSOR arm7tdmi)
+
+if(DEFINED ENV{ARM_NONE_EABI_DIR})
+    set(_p5_bin "$ENV{ARM_NONE_EABI_DIR}/")
+endif()
+
+set(CMAKE_C_COMPILER   ${_p5_bin}arm-none-eabi-gcc)
+set(CMAKE_ASM_COMPILER ${_p5_bin}arm-none-eabi-gcc)
+set(CMAKE_OBJCOPY      ${_p5_bin}arm-none-eabi-objcopy CACHE FILEPATH "")
+set(CMAKE_SIZE         ${_p5_bin}arm-none-eabi-size CACHE FILEPATH "")
+
+set(_p5_cpu "-mcpu=arm7tdmi -marm -mfloat-abi=soft")
+set(CMAKE_C_FLAGS_INIT   "${_p5_cpu}")
+set(CMAKE_ASM_FLAGS_INIT "${_p5_cpu} -x assembler-with-cpp")
+set(CMAKE_EXE_LINKER_FLAGS_INIT "${_p5_cpu} -nostartfiles --specs=nano.specs --specs=nosys.specs")
+
+set(CMAKE_TRY_COMPILE_TARGET_TYPE STATIC_LIBRARY)
+set(CMAKE_FIND_ROOT_PATH_MODE_PROGRAM NEVER)
+set(CMAKE_FIND_ROOT_PATH_MODE_LIBRARY ONLY)
+set(CMAKE_FIND_ROOT_PATH_MODE_INCLUDE ONLY)
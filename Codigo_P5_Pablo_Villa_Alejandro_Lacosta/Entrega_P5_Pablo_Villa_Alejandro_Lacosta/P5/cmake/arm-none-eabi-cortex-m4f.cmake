@@ -0,0 +1,26 @@
+# P.H.2025: cadena arm-none-eabi-gcc para el nRF52840 (Cortex-M4F, FPU hard)
+#
+# Si el compilador no esta en el PATH: ARM_NONE_EABI_DIR=/ruta/bin
+
+set(CMAKE_SYSTEM_NAME Generic)
+set(CMAKE_SYSTEM_PROCESSOR cortex-m4)
+
+if(DEFINED ENV{ARM_NONE_EABI_DIR})
+    set(_p5_bin "$ENV{ARM_NONE_EABI_DIR}/")
+endif()
+
+set(CMAKE_C_COMPILER   ${_p5_bin}arm-none-eabi-gcc)
+set(CMAKE_ASM_COMPILER ${_p5_bin}arm-none-eabi-gcc)
+set(CMAKE_OBJCOPY      ${_p5_bin}arm-none-eabi-objcopy CACHE FILEPATH "")
+set(CMAKE_SIZE         ${_p5_bin}arm-none-eabi-size CACHE FILEPATH "")
+
+set(_p5_cpu "-mcpu=cortex-m4 -mthumb -mfloat-abi=hard -mfpu=fpv4-sp-d16")
+set(CMAKE_C_FLAGS_INIT   "${_p5_cpu}")
+set(CMAKE_ASM_FLAGS_INIT "${_p5_cpu} -x assembler-with-cpp")
+set(CMAKE_EXE_LINKER_FLAGS_INIT "${_p5_cpu} --specs=nano.specs --specs=nosys.specs")
+
+# Sin sistema operativo no se puede enlazar un ejecutable de prueba
+set(CMAKE_TRY_COMPILE_TARGET_TYPE STATIC_LIBRARY)
+set(CMAKE_FIND_ROOT_PATH_MODE_PROGRAM NEVER)
+set(CMAKE_FIND_ROOT_PATH_MODE_LIBRARY ONLY)
+set(CMAKE_FIND_ROOT_PATH_MODE_INCLUDE ONLY)
@@ -0,0 +1,20 @@
+# P.H.2025: ejecuta dos veces el simulador con el mismo guion y falla si
+# la salida (UART, LEDs e informe) no es identica byte a byte.
+#
+#   cmake -DSIM=p5_sim -DGUION=partida.txt -P comparar_ejecuciones.cmake
+
+foreach(i 1 2)
+    execute_process(
+        COMMAND ${CMAKE_COMMAND} -E env P5_GUION=${GUION} ${SIM}
+        OUTPUT_VARIABLE salida_${i}
+        ERROR_VARIABLE  errores_${i}
+        RESULT_VARIABLE codigo_${i})
+endforeach()
+
+if(NOT codigo_1 EQUAL 0 OR NOT codigo_2 EQUAL 0)
+    message(FATAL_ERROR "El simulador acaba con ${codigo_1} / ${codigo_2}:\n${errores_1}")
+endif()
+if(NOT salida_1 STREQUAL salida_2 OR NOT errores_1 STREQUAL errores_2)
+    message(FATAL_ERROR "Dos ejecuciones con el mismo guion dan salidas distintas")
+endif()
+message(STATUS "Salidas identicas")
@@ -0,0 +1,77 @@
+/******************************************************************************
+ * Fichero: fuzz.h
+ * Proyecto: P.H.2025
+ *
+ * Comun a los arneses de fuzzing del runtime (rt_FIFO, svc_GE, svc_alarmas).
+ *
+ * Cada arnes es un LLVMFuzzerTestOneInput que interpreta la entrada como una
+ * secuencia de operaciones sobre el modulo real y sobre un modelo de
+ * referencia sencillo, y aborta en cuanto los dos no coinciden. Las
+ * violaciones de memoria las caza ASan/UBSan.
+ *
+ * Dos formas de ejecutarlos (objetivos fuzz_* de CMakeLists.txt, placa
+ * HOST_POSIX):
+ *  - Con clang: -fsanitize=fuzzer; ./fuzz_rt_fifo corpus/ -max_total_time=60
+ *  - Con gcc: fuzz_driver.c hace de libFuzzer sin cobertura; reproduce los
+ *    ficheros que se le pasen o prueba FUZZ_ITERACIONES entradas
+ *    pseudoaleatorias (semilla FUZZ_SEMILLA). Es lo que corre ctest.
+ *
+ * Los bloqueos de los modulos (cola llena, tabla de suscripciones llena)
+ * llaman a un driver que el arnes sustituye por un longjmp: asi se
+ * comprueba que solo ocurren cuando el modelo los espera.
+ *
+ * Autores:
+ *   Alejandro Lacosta
+ *   Pablo Villa
+ *
+ * Universidad de Zaragoza
+ *
+ *****************************************************************************/
+
+#ifndef FUZZ_H
+#define FUZZ_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+int LLVMFuzzerTestOneInput(const uint8_t *datos, size_t tam);
+
+typedef struct {
+    const uint8_t *p;
+    size_t         quedan;
+} fuzz_entrada_t;
+
+static inline bool fuzz_quedan(const fuzz_entrada_t *e) {
+    return e->quedan != 0;
+}
+
+/* Un byte de la entrada (0 cuando se acaba) */
+static inline uint8_t fuzz_u8(fuzz_entrada_t *e) {
+    if (e->quedan == 0) return 0;
+    e->quedan--;
+    return *e->p++;
+}
+
+static inline uint16_t fuzz_u16(fuzz_entrada_t *e) {
+    uint16_t v = fuzz_u8(e);
+    return (uint16_t)(v | (fuzz_u8(e) << 8));
+}
+
+static inline uint32_t fuzz_u32(fuzz_entrada_t *e) {
+    uint32_t v = fuzz_u16(e);
+    return v | ((uint32_t)fuzz_u16(e) << 16);
+}
+
+static inline void fuzz_fallo(const char *fichero, int linea, const char *cond) {
+    fprintf(stderr, "[fuzz] %s:%d: no se cumple %s\n", fichero, linea, cond);
+    abort();
+}
+
+/* Divergencia entre el modulo y el modelo: libFuzzer guarda la entrada */
+#define FUZZ_COMPROBAR(cond) \
+    do { if (!(cond)) fuzz_fallo(__FILE__, __LINE__, #cond); } while (0)
+
+#endif // FUZZ_H
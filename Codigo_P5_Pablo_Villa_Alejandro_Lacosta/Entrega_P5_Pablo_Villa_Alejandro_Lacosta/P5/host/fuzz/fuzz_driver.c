@@ -0,0 +1,92 @@
+/* *****************************************************************************
+ * P.H.2025: fuzz_driver.c
+ * Sustituto de libFuzzer para compiladores sin -fsanitize=fuzzer
+ *
+ * Autores: Alejandro Lacosta, Pablo Villa
+ *
+ * Uso:
+ *   fuzz_xxx fichero|directorio...   reproduce esas entradas (p.ej. un
+ *                                    crash-* guardado por libFuzzer)
+ *   fuzz_xxx                         FUZZ_ITERACIONES entradas al azar
+ *                                    (10000 por defecto) con semilla
+ *                                    FUZZ_SEMILLA: siempre las mismas
+ *
+ * No hay cobertura: las entradas son ruido, pero los arneses las leen como
+ * operaciones y cualquier secuencia es valida, asi que sirve igual para
+ * recorrer intercalados que un caso a mano no pensaria.
+ * *****************************************************************************/
+
+#include "fuzz.h"
+#include <dirent.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#define FUZZ_MAX_ENTRADA  4096u
+
+static uint8_t s_buf[FUZZ_MAX_ENTRADA];
+
+static uint32_t xorshift(uint32_t *s) {
+    uint32_t x = *s;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *s = x;
+}
+
+static uint32_t entero_entorno(const char *nombre, uint32_t defecto) {
+    const char *v = getenv(nombre);
+    return (v && *v) ? (uint32_t)strtoul(v, NULL, 0) : defecto;
+}
+
+static void ejecutar_fichero(const char *ruta) {
+    FILE *f = fopen(ruta, "rb");
+    if (!f) {
+        fprintf(stderr, "[fuzz] no se puede abrir %s\n", ruta);
+        exit(2);
+    }
+    size_t n = fread(s_buf, 1, sizeof(s_buf), f);
+    fclose(f);
+    LLVMFuzzerTestOneInput(s_buf, n);
+}
+
+static uint32_t ejecutar_ruta(const char *ruta) {
+    struct stat st;
+    if (stat(ruta, &st) != 0 || !S_ISDIR(st.st_mode)) {
+        ejecutar_fichero(ruta);
+        return 1;
+    }
+
+    uint32_t n = 0;
+    DIR *d = opendir(ruta);
+    struct dirent *e;
+    while (d && (e = readdir(d)) != NULL) {
+        if (e->d_name[0] == '.') continue;
+        char hijo[1024];
+        snprintf(hijo, sizeof(hijo), "%s/%s", ruta, e->d_name);
+        ejecutar_fichero(hijo);
+        n++;
+    }
+    if (d) closedir(d);
+    return n;
+}
+
+int main(int argc, char **argv) {
+    uint32_t n = 0;
+
+    if (argc > 1) {
+        for (int i = 1; i < argc; i++) n += ejecutar_ruta(argv[i]);
+    } else {
+        uint32_t iteraciones = entero_entorno("FUZZ_ITERACIONES", 10000u);
+        uint32_t semilla = entero_entorno("FUZZ_SEMILLA", 0x2025u);
+        if (semilla == 0) semilla = 1;
+
+        for (; n < iteraciones; n++) {
+            // Longitudes variadas: las cortas cubren los estados iniciales
+            size_t tam = xorshift(&semilla) % (FUZZ_MAX_ENTRADA / 4u << (n & 2u));
+            for (size_t i = 0; i < tam; i++) s_buf[i] = (uint8_t)xorshift(&semilla);
+            LLVMFuzzerTestOneInput(s_buf, tam);
+        }
+    }
+    printf("[fuzz] %s: %lu entradas sin divergencias\n", argv[0], (unsigned long)n);
+    return 0;
+}
@@ -0,0 +1,179 @@
+/* *****************************************************************************
+ * P.H.2025: fuzz_rt_fifo.c
+ * Arnes de fuzzing de rt_FIFO contra una cola de referencia
+ *
+ * Autores: Alejandro Lacosta, Pablo Villa
+ *
+ * Operaciones: encolar (sueltos y en rafagas hasta desbordar), extraer,
+ * vaciar, avanzar el reloj, resetear estadisticas y reiniciar la cola.
+ * Tras cada una se comparan ocupacion, maximo y contadores por tipo; cada
+ * extraccion compara ID, dato auxiliar (sus RT_FIFO_AUX_BITS), marca de
+ * tiempo y el valor devuelto. Los saltos de reloj grandes fuerzan la vuelta
+ * de la epoca de las marcas con eventos pendientes.
+ * El desbordamiento solo puede ocurrir con la cola del modelo llena y debe
+ * marcar el monitor de overflow sin tocar el contenido.
+ * *****************************************************************************/
+
+#include "fuzz.h"
+#include "rt_fifo.h"
+#include "drv_tiempo.h"
+#include "drv_monitor.h"
+#include "drv_consumo.h"
+#include <setjmp.h>
+
+// -----------------------------------------------------------------------------
+// Drivers que usa rt_fifo.c
+// -----------------------------------------------------------------------------
+
+static Tiempo_us_t s_ahora_us;
+static uint32_t    s_monitor_marcado;
+static jmp_buf     s_bloqueo;
+static bool        s_bloqueo_armado = false;
+
+Tiempo_us_t drv_tiempo_actual_us(void) {
+    return s_ahora_us;
+}
+
+void drv_monitor_marcar(uint32_t id) {
+    s_monitor_marcado = id;
+}
+
+/* El while(1) del overflow: se sale por aqui de vuelta al arnes */
+void drv_consumo_dormir(void) {
+    FUZZ_COMPROBAR(s_bloqueo_armado);
+    longjmp(s_bloqueo, 1);
+}
+
+// -----------------------------------------------------------------------------
+// Modelo
+// -----------------------------------------------------------------------------
+
+typedef struct {
+    uint32_t    id;
+    uint32_t    aux;
+    Tiempo_us_t ts;
+} modelo_evento_t;
+
+static modelo_evento_t m_cola[RT_FIFO_TAM];
+static uint32_t m_primero, m_num, m_max;
+static uint32_t m_cuenta[EVENT_TYPES];
+static uint32_t m_monitor;
+
+static void iniciar(uint32_t monitor) {
+    rt_FIFO_inicializar(monitor);
+    m_primero = m_num = m_max = 0;
+    for (uint32_t i = 0; i < EVENT_TYPES; i++) m_cuenta[i] = 0;
+    m_monitor = monitor;
+}
+
+static void encolar(uint32_t id, uint32_t aux) {
+    bool llena = (m_num == RT_FIFO_TAM);
+    s_monitor_marcado = 0xFFFFFFFFu;
+
+    if (setjmp(s_bloqueo) == 0) {
+        s_bloqueo_armado = true;
+        rt_FIFO_encolar(id, aux);
+        s_bloqueo_armado = false;
+        FUZZ_COMPROBAR(!llena);
+
+        modelo_evento_t *e = &m_cola[(m_primero + m_num) % RT_FIFO_TAM];
+        e->id = id;
+        e->aux = aux & RT_FIFO_AUX_MAX;
+        e->ts = s_ahora_us;
+        m_num++;
+        if (m_num > m_max) m_max = m_num;
+        if (id < EVENT_TYPES) m_cuenta[id]++;
+    } else {
+        s_bloqueo_armado = false;
+        FUZZ_COMPROBAR(llena);
+        FUZZ_COMPROBAR(s_monitor_marcado == m_monitor);
+    }
+}
+
+static void extraer(void) {
+    EVENTO_T id = ev_VOID;
+    uint32_t aux = 0;
+    Tiempo_us_t ts = 0;
+    uint8_t r = rt_FIFO_extraer(&id, &aux, &ts);
+
+    if (m_num == 0) {
+        FUZZ_COMPROBAR(r == 0);
+        return;
+    }
+    modelo_evento_t *e = &m_cola[m_primero];
+    FUZZ_COMPROBAR(r == m_num);                 // incluye el extraido
+    FUZZ_COMPROBAR((uint32_t)id == e->id);
+    FUZZ_COMPROBAR(aux == e->aux);
+    FUZZ_COMPROBAR(ts == e->ts);
+    m_primero = (m_primero + 1) % RT_FIFO_TAM;
+    m_num--;
+}
+
+static void comprobar_estadisticas(void) {
+    FUZZ_COMPROBAR(rt_FIFO_estadisticas(ev_VOID) == m_num);
+    FUZZ_COMPROBAR(rt_FIFO_max_ocupacion() == m_max);
+    for (uint32_t i = 1; i < EVENT_TYPES; i++)
+        FUZZ_COMPROBAR(rt_FIFO_estadisticas((EVENTO_T)i) == m_cuenta[i]);
+    FUZZ_COMPROBAR(rt_FIFO_estadisticas((EVENTO_T)(EVENT_TYPES + 3)) == 0);
+}
+
+// -----------------------------------------------------------------------------
+// Arnes
+// -----------------------------------------------------------------------------
+
+/* IDs de tipo conocidos y algunos fuera de rango (no se cuentan) */
+static uint32_t leer_id(fuzz_entrada_t *e) {
+    return fuzz_u8(e) % (EVENT_TYPES + 4u);
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *datos, size_t tam) {
+    fuzz_entrada_t e = { datos, tam };
+
+    s_ahora_us = (Tiempo_us_t)fuzz_u32(&e) << (fuzz_u8(&e) & 31u);
+    iniciar(1u + fuzz_u8(&e) % 4u);
+
+    while (fuzz_quedan(&e)) {
+        uint8_t op = fuzz_u8(&e) % 12u;
+        switch (op) {
+        case 0: case 1: case 2: case 3: {
+            uint32_t id = leer_id(&e);
+            encolar(id, fuzz_u32(&e));
+            break;
+        }
+        case 4: case 5:
+            extraer();
+            break;
+        case 6:
+            s_ahora_us += fuzz_u8(&e);
+            break;
+        case 7: {
+            // Ningun evento puede esperar 2^32 us (ver rt_fifo.c): se vacia antes
+            Tiempo_us_t salto = fuzz_u32(&e);
+            if (m_num && s_ahora_us + salto - m_cola[m_primero].ts > 0xFFFFFFFFu)
+                while (m_num) extraer();
+            s_ahora_us += salto;
+            break;
+        }
+        case 8: {                               // rafaga, puede desbordar
+            uint32_t n = fuzz_u8(&e) % (RT_FIFO_TAM + 2u);
+            uint32_t id = leer_id(&e);
+            for (uint32_t i = 0; i < n; i++) encolar(id, i);
+            break;
+        }
+        case 9:
+            while (m_num) extraer();
+            extraer();                          // vacia: devuelve 0
+            break;
+        case 10:
+            rt_FIFO_resetear_estadisticas();
+            m_max = m_num;
+            for (uint32_t i = 0; i < EVENT_TYPES; i++) m_cuenta[i] = 0;
+            break;
+        default:
+            iniciar(1u + fuzz_u8(&e) % 4u);
+            break;
+        }
+        comprobar_estadisticas();
+    }
+    return 0;
+}
@@ -0,0 +1,227 @@
+/* *****************************************************************************
+ * P.H.2025: fuzz_svc_GE.c
+ * Arnes de fuzzing de svc_GE contra una lista ordenada de suscripciones
+ *
+ * Autores: Alejandro Lacosta, Pablo Villa
+ *
+ * Modelo: las suscripciones dinamicas forman una lista en orden de alta;
+ * cancelar quita la primera que coincide (evento y callback) y conserva el
+ * orden del resto. Despachar un evento llama primero a sus suscripciones
+ * estaticas y despues recorre la lista tal como estaba al empezar: cada
+ * entrada del evento se llama una vez si sigue suscrita cuando le toca, y
+ * las altas hechas durante el despacho no lo reciben.
+ *
+ * Los callbacks dinamicos, al ser llamados, pueden suscribir o cancelar
+ * (lo decide la entrada), que es lo que hacen svc_grabacion o el shell.
+ * Suscribir con la tabla llena debe bloquear (LED 1) y solo entonces.
+ * *****************************************************************************/
+
+#include "fuzz.h"
+#include "svc_GE.h"
+#include "drv_leds.h"
+#include <setjmp.h>
+
+#define FUZZ_GE_EVENTOS    6u
+#define FUZZ_GE_CALLBACKS  4u
+
+// -----------------------------------------------------------------------------
+// Drivers que usa svc_GE.c
+// -----------------------------------------------------------------------------
+
+static jmp_buf s_bloqueo;
+static bool    s_bloqueo_armado = false;
+
+/* Aviso de tabla llena; el while(1) que le sigue se evita con el longjmp */
+int drv_led_establecer(LED_id_t id, LED_status_t estado) {
+    FUZZ_COMPROBAR(s_bloqueo_armado);
+    FUZZ_COMPROBAR(id == 1 && estado == LED_ON);
+    longjmp(s_bloqueo, 1);
+}
+
+// -----------------------------------------------------------------------------
+// Modelo
+// -----------------------------------------------------------------------------
+
+typedef struct {
+    EVENTO_T evento;
+    uint8_t  callback;
+    uint32_t serie;                 // identifica la alta (puede haber repetidas)
+} modelo_sub_t;
+
+static modelo_sub_t m_subs[rt_GE_MAX_SUSCRITOS];
+static uint32_t     m_num;
+static uint32_t     m_serie;
+
+// Despacho en curso: la lista al empezar y por donde va
+static modelo_sub_t m_foto[rt_GE_MAX_SUSCRITOS];
+static uint32_t     m_num_foto, m_pos;
+static EVENTO_T     m_evento;
+static uint32_t     m_aux;
+static uint32_t     m_llamadas_estaticas;
+static bool         m_despachando = false;
+
+static fuzz_entrada_t *s_entrada;   // para que los callbacks decidan que hacer
+
+static bool presente(uint32_t serie) {
+    for (uint32_t i = 0; i < m_num; i++)
+        if (m_subs[i].serie == serie) return true;
+    return false;
+}
+
+/* Siguiente entrada de la foto que aun debe recibir el evento */
+static bool siguiente(void) {
+    while (m_pos < m_num_foto) {
+        if (m_foto[m_pos].evento == m_evento && presente(m_foto[m_pos].serie)) return true;
+        m_pos++;
+    }
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+// Operaciones (sobre svc_GE y sobre el modelo a la vez)
+// -----------------------------------------------------------------------------
+
+static void suscribir(EVENTO_T ev, uint8_t prioridad, uint8_t cb);
+static void cancelar(EVENTO_T ev, uint8_t cb);
+
+static EVENTO_T leer_evento(fuzz_entrada_t *e) {
+    return (EVENTO_T)(1u + fuzz_u8(e) % FUZZ_GE_EVENTOS);
+}
+
+/* Lo que hace un callback dinamico al ser llamado */
+static void reaccionar(void) {
+    uint8_t accion = fuzz_u8(s_entrada) % 4u;
+    EVENTO_T ev = leer_evento(s_entrada);
+    uint8_t cb = fuzz_u8(s_entrada) % FUZZ_GE_CALLBACKS;
+
+    if (accion == 1) {
+        cancelar(ev, cb);
+    } else if (accion == 2 && m_num < rt_GE_MAX_SUSCRITOS) {
+        suscribir(ev, 2, cb);               // llena bloquearia a medio despacho
+    } else if (accion == 3) {
+        cancelar(m_evento, cb);             // a menudo a si mismo o a un vecino
+    }
+}
+
+static void llamado(uint8_t cb, EVENTO_T ev, uint32_t aux) {
+    FUZZ_COMPROBAR(m_despachando);
+    FUZZ_COMPROBAR(ev == m_evento && aux == m_aux);
+
+    if (cb >= FUZZ_GE_CALLBACKS) {          // estatica: antes que las dinamicas
+        FUZZ_COMPROBAR(m_pos == 0);
+        m_llamadas_estaticas++;
+        return;
+    }
+    FUZZ_COMPROBAR(siguiente());
+    FUZZ_COMPROBAR(m_foto[m_pos].callback == cb);
+    m_pos++;
+    reaccionar();
+}
+
+static void cb0(EVENTO_T ev, uint32_t aux) { llamado(0, ev, aux); }
+static void cb1(EVENTO_T ev, uint32_t aux) { llamado(1, ev, aux); }
+static void cb2(EVENTO_T ev, uint32_t aux) { llamado(2, ev, aux); }
+static void cb3(EVENTO_T ev, uint32_t aux) { llamado(3, ev, aux); }
+static void estatica_a(EVENTO_T ev, uint32_t aux) { llamado(FUZZ_GE_CALLBACKS, ev, aux); }
+static void estatica_b(EVENTO_T ev, uint32_t aux) { llamado(FUZZ_GE_CALLBACKS + 1, ev, aux); }
+
+static const SVC_CALLBACK_T s_callbacks[FUZZ_GE_CALLBACKS] = { cb0, cb1, cb2, cb3 };
+
+SVC_GE_SUSCRIPCION_ESTATICA(ev_T_PERIODICO, 0, estatica_a);
+SVC_GE_SUSCRIPCION_ESTATICA(ev_PULSAR_BOTON, 0, estatica_b);
+#define FUZZ_GE_ESTATICAS(ev)  (((ev) == ev_T_PERIODICO) + ((ev) == ev_PULSAR_BOTON))
+
+static void suscribir(EVENTO_T ev, uint8_t prioridad, uint8_t cb) {
+    bool llena = (m_num == rt_GE_MAX_SUSCRITOS);
+
+    if (setjmp(s_bloqueo) == 0) {
+        s_bloqueo_armado = true;
+        svc_GE_suscribir(ev, prioridad, s_callbacks[cb]);
+        s_bloqueo_armado = false;
+        FUZZ_COMPROBAR(!llena);
+        m_subs[m_num].evento = ev;
+        m_subs[m_num].callback = cb;
+        m_subs[m_num].serie = ++m_serie;
+        m_num++;
+    } else {
+        s_bloqueo_armado = false;
+        FUZZ_COMPROBAR(llena);
+    }
+}
+
+static void cancelar(EVENTO_T ev, uint8_t cb) {
+    svc_GE_cancelar(ev, s_callbacks[cb]);
+    for (uint32_t i = 0; i < m_num; i++) {
+        if (m_subs[i].evento == ev && m_subs[i].callback == cb) {
+            m_num--;
+            for (uint32_t j = i; j < m_num; j++) m_subs[j] = m_subs[j + 1];
+            return;
+        }
+    }
+}
+
+static void vaciar(void) {
+    while (m_num) cancelar(m_subs[0].evento, m_subs[0].callback);
+    FUZZ_COMPROBAR(svc_GE_num_suscritos() == 0);
+}
+
+static void despachar(EVENTO_T ev, uint32_t aux) {
+    for (uint32_t i = 0; i < m_num; i++) m_foto[i] = m_subs[i];
+    m_num_foto = m_num;
+    m_pos = 0;
+    m_evento = ev;
+    m_aux = aux;
+    m_llamadas_estaticas = 0;
+
+    m_despachando = true;
+    svc_GE_despachar(ev, aux);
+    m_despachando = false;
+
+    FUZZ_COMPROBAR(!siguiente());           // nadie se ha quedado sin llamar
+    FUZZ_COMPROBAR(m_llamadas_estaticas == FUZZ_GE_ESTATICAS(ev));
+}
+
+// -----------------------------------------------------------------------------
+// Arnes
+// -----------------------------------------------------------------------------
+
+int LLVMFuzzerTestOneInput(const uint8_t *datos, size_t tam) {
+    fuzz_entrada_t e = { datos, tam };
+    s_entrada = &e;
+
+    // La tabla es global y sobrevive entre entradas: se parte de vacia
+    vaciar();
+    FUZZ_COMPROBAR(svc_GE_num_estaticas() == 2);
+
+    while (fuzz_quedan(&e)) {
+        uint8_t op = fuzz_u8(&e) % 8u;
+        switch (op) {
+        case 0: case 1: case 2: {
+            EVENTO_T ev = leer_evento(&e);
+            uint8_t prioridad = fuzz_u8(&e);
+            suscribir(ev, prioridad, fuzz_u8(&e) % FUZZ_GE_CALLBACKS);
+            break;
+        }
+        case 3: {
+            EVENTO_T ev = leer_evento(&e);
+            cancelar(ev, fuzz_u8(&e) % FUZZ_GE_CALLBACKS);
+            break;
+        }
+        case 4: case 5: {
+            EVENTO_T ev = leer_evento(&e);
+            despachar(ev, fuzz_u32(&e));
+            break;
+        }
+        case 6:                                 // todos, incluido uno sin nadie
+            for (uint32_t ev = 0; ev <= FUZZ_GE_EVENTOS + 1u; ev++)
+                despachar((EVENTO_T)ev, ev);
+            break;
+        default:
+            if (fuzz_u8(&e) < 16u) vaciar();
+            break;
+        }
+        FUZZ_COMPROBAR(svc_GE_num_suscritos() == m_num);
+    }
+    s_entrada = NULL;
+    return 0;
+}
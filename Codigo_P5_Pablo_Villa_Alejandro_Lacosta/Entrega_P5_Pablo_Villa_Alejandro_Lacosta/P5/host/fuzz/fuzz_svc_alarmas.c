@@ -0,0 +1,280 @@
+/* *****************************************************************************
+ * P.H.2025: fuzz_svc_alarmas.c
+ * Arnes de fuzzing de svc_alarmas contra un modelo con tiempo de 64 bits
+ *
+ * Autores: Alejandro Lacosta, Pablo Villa
+ *
+ * El modelo guarda el vencimiento absoluto de cada alarma en ms de 64 bits,
+ * mientras el servicio trabaja con drv_tiempo_actual_ms de 32: el reloj
+ * arranca cerca de la vuelta de los 32 bits para que se cruce a menudo.
+ *
+ * Operaciones: activar (periodica o no, retardo 0 = desactivar), activar_en,
+ * desactivar, avanzar el reloj de ms en ms con tick y saltar mucho de golpe
+ * con un unico tick (despacho tardio o vuelta de un sueno). Se comprueba:
+ *  - que alarmas vencen en cada tick, en que orden y con que evento/aux;
+ *  - activas, proximo_ms y la contabilidad de suspensiones del tick;
+ *  - que el periodico esta habilitado si y solo si hay alarmas.
+ *
+ * Las alarmas ocupan huecos (el primero libre, o el suyo si ya existe): el
+ * orden de aviso dentro de un tick es el de los huecos, y el modelo tambien.
+ * *****************************************************************************/
+
+#include "fuzz.h"
+#include "svc_alarmas.h"
+#include "drv_tiempo.h"
+#include "rt_fifo.h"
+
+#define FUZZ_AL_EVENTOS  4u
+#define FUZZ_AL_AUX      3u
+#define FUZZ_AL_MAX_AVISOS  (SVC_ALARMAS_MAX * 2u)
+
+// -----------------------------------------------------------------------------
+// Drivers que usa svc_alarmas.c
+// -----------------------------------------------------------------------------
+
+static uint64_t s_ahora_ms;
+static bool     s_tick_habilitado;
+static void   (*s_tick_cb)(void);
+static uint32_t s_ticks_encolados;
+
+Tiempo_ms_t drv_tiempo_actual_ms(void) {
+    return (Tiempo_ms_t)s_ahora_ms;
+}
+
+void drv_tiempo_periodico_ms(Tiempo_ms_t ms, void (*funcion_callback_app)(), uint32_t ID_evento) {
+    FUZZ_COMPROBAR(ms == 1 && ID_evento == ev_T_PERIODICO);
+    s_tick_cb = funcion_callback_app;
+    s_tick_habilitado = true;
+}
+
+void drv_tiempo_periodico_habilitar(bool habilitar) {
+    s_tick_habilitado = habilitar;
+}
+
+/* El tick del periodico solo encola; el lanzador llama luego a actualizar */
+void rt_FIFO_encolar(uint32_t ID_evento, uint32_t auxData) {
+    FUZZ_COMPROBAR(ID_evento == ev_T_PERIODICO && auxData == 0);
+    s_ticks_encolados++;
+}
+
+// -----------------------------------------------------------------------------
+// Avisos recibidos por el callback del servicio
+// -----------------------------------------------------------------------------
+
+typedef struct {
+    EVENTO_T evento;
+    uint32_t aux;
+} aviso_t;
+
+static aviso_t  s_avisos[FUZZ_AL_MAX_AVISOS];
+static uint32_t s_num_avisos;
+
+static void avisar(uint32_t evento, uint32_t aux) {
+    FUZZ_COMPROBAR(s_num_avisos < FUZZ_AL_MAX_AVISOS);
+    s_avisos[s_num_avisos].evento = (EVENTO_T)evento;
+    s_avisos[s_num_avisos].aux = aux;
+    s_num_avisos++;
+}
+
+// -----------------------------------------------------------------------------
+// Modelo
+// -----------------------------------------------------------------------------
+
+typedef struct {
+    bool     activa;
+    bool     periodica;
+    EVENTO_T evento;
+    uint32_t aux;
+    uint32_t retardo;
+    uint64_t vence;
+} modelo_alarma_t;
+
+static modelo_alarma_t m_al[SVC_ALARMAS_MAX];
+static bool     m_suspendido;
+static uint32_t m_suspensiones;
+static uint64_t m_suspension_inicio;
+static uint32_t m_suspendido_ms;
+
+static uint32_t m_activas(void) {
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < SVC_ALARMAS_MAX; i++) n += m_al[i].activa;
+    return n;
+}
+
+/* La suya si existe, si no el primer hueco libre; NULL si no cabe */
+static modelo_alarma_t *m_hueco(EVENTO_T ev, uint32_t aux) {
+    for (uint32_t i = 0; i < SVC_ALARMAS_MAX; i++)
+        if (m_al[i].activa && m_al[i].evento == ev && m_al[i].aux == aux) return &m_al[i];
+    for (uint32_t i = 0; i < SVC_ALARMAS_MAX; i++)
+        if (!m_al[i].activa) return &m_al[i];
+    return NULL;
+}
+
+static void m_programar(EVENTO_T ev, uint32_t aux, bool periodica, uint32_t retardo) {
+    modelo_alarma_t *a = m_hueco(ev, aux);
+    if (!a) return;
+    a->activa = true;
+    a->periodica = periodica;
+    a->evento = ev;
+    a->aux = aux;
+    a->retardo = retardo;
+    a->vence = s_ahora_ms + retardo;
+}
+
+static void m_desactivar(EVENTO_T ev, uint32_t aux) {
+    for (uint32_t i = 0; i < SVC_ALARMAS_MAX; i++) {
+        if (m_al[i].activa && m_al[i].evento == ev && m_al[i].aux == aux) {
+            m_al[i].activa = false;
+            return;
+        }
+    }
+}
+
+/* El tick se para al quedarse sin alarmas y vuelve con la primera */
+static void m_contabilizar_tick(void) {
+    bool ocioso = (m_activas() == 0);
+    if (ocioso && !m_suspendido) {
+        m_suspendido = true;
+        m_suspensiones++;
+        m_suspension_inicio = s_ahora_ms;
+    } else if (!ocioso && m_suspendido) {
+        m_suspendido = false;
+        m_suspendido_ms += (uint32_t)(s_ahora_ms - m_suspension_inicio);
+    }
+}
+
+static uint32_t m_proximo(void) {
+    uint32_t proximo = SVC_ALARMA_NINGUNA;
+    for (uint32_t i = 0; i < SVC_ALARMAS_MAX; i++) {
+        if (!m_al[i].activa) continue;
+        uint32_t falta = (m_al[i].vence > s_ahora_ms) ? (uint32_t)(m_al[i].vence - s_ahora_ms) : 0;
+        if (falta < proximo) proximo = falta;
+    }
+    return proximo;
+}
+
+// -----------------------------------------------------------------------------
+// Operaciones
+// -----------------------------------------------------------------------------
+
+/* Un tick atendido como en rt_GE_lanzador, comparando los avisos */
+static void atender_tick(void) {
+    s_num_avisos = 0;
+    svc_alarma_actualizar(ev_T_PERIODICO, 0);
+
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < SVC_ALARMAS_MAX; i++) {
+        modelo_alarma_t *a = &m_al[i];
+        if (!a->activa || s_ahora_ms < a->vence) continue;
+
+        FUZZ_COMPROBAR(n < s_num_avisos);
+        FUZZ_COMPROBAR(s_avisos[n].evento == a->evento && s_avisos[n].aux == a->aux);
+        n++;
+
+        if (a->periodica) {
+            a->vence += a->retardo;
+            if (s_ahora_ms >= a->vence) a->vence = s_ahora_ms + a->retardo;
+        } else {
+            a->activa = false;
+        }
+    }
+    FUZZ_COMPROBAR(n == s_num_avisos);
+    m_contabilizar_tick();
+}
+
+/* El periodico "interrumpe": encola su evento y el lanzador lo atiende */
+static void avanzar(uint64_t ms, bool de_golpe) {
+    uint64_t pasos = de_golpe ? 1u : ms;
+    uint64_t paso = de_golpe ? ms : 1u;
+
+    for (uint64_t i = 0; i < pasos; i++) {
+        s_ahora_ms += paso;
+        if (!s_tick_habilitado) continue;
+        s_ticks_encolados = 0;
+        s_tick_cb();
+        FUZZ_COMPROBAR(s_ticks_encolados == 1);
+        atender_tick();
+    }
+}
+
+static void comprobar(void) {
+    uint32_t activas = m_activas();
+    FUZZ_COMPROBAR(svc_alarma_activas() == activas);
+    FUZZ_COMPROBAR(s_tick_habilitado == (activas != 0));
+    FUZZ_COMPROBAR(svc_alarma_tick_suspendido() == m_suspendido);
+    FUZZ_COMPROBAR(svc_alarma_tick_suspensiones() == m_suspensiones);
+
+    uint32_t suspendido_ms = m_suspendido_ms;
+    if (m_suspendido) suspendido_ms += (uint32_t)(s_ahora_ms - m_suspension_inicio);
+    FUZZ_COMPROBAR(svc_alarma_tick_suspendido_ms() == suspendido_ms);
+    FUZZ_COMPROBAR(svc_alarma_proximo_ms() == m_proximo());
+}
+
+// -----------------------------------------------------------------------------
+// Arnes
+// -----------------------------------------------------------------------------
+
+/* Retardos cortos casi siempre (para que venzan), a veces de hasta 24 bits */
+static uint32_t leer_retardo(fuzz_entrada_t *e) {
+    uint8_t tipo = fuzz_u8(e);
+    if (tipo < 200u) return tipo % 40u;
+    if (tipo < 250u) return fuzz_u16(e);
+    return fuzz_u32(e) & 0x00FFFFFFu;
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *datos, size_t tam) {
+    fuzz_entrada_t e = { datos, tam };
+
+    // Menos de un minuto antes de la vuelta de los 32 bits
+    s_ahora_ms = 0xFFFFFFFFu - fuzz_u16(&e);
+    for (uint32_t i = 0; i < SVC_ALARMAS_MAX; i++) m_al[i].activa = false;
+    m_suspendido = false;
+    m_suspensiones = 0;
+    m_suspendido_ms = 0;
+    s_tick_cb = NULL;
+
+    svc_alarma_iniciar(0, avisar, ev_T_PERIODICO);
+    FUZZ_COMPROBAR(s_tick_cb != NULL);
+    m_contabilizar_tick();
+    comprobar();
+
+    while (fuzz_quedan(&e)) {
+        uint8_t op = fuzz_u8(&e) % 8u;
+        EVENTO_T ev = (EVENTO_T)(1u + fuzz_u8(&e) % FUZZ_AL_EVENTOS);
+        uint32_t aux = fuzz_u8(&e) % FUZZ_AL_AUX;
+
+        switch (op) {
+        case 0: case 1: {
+            bool periodica = fuzz_u8(&e) & 1u;
+            uint32_t retardo = leer_retardo(&e);
+            svc_alarma_activar(svc_alarma_codificar(periodica, retardo, fuzz_u8(&e)), ev, aux);
+            if (retardo == 0) m_desactivar(ev, aux);
+            else              m_programar(ev, aux, periodica, retardo);
+            break;
+        }
+        case 2: {
+            // Vencimientos cercanos, pasados (vencen ya) o cualquiera
+            int32_t delta = (fuzz_u8(&e) & 1u) ? (int16_t)fuzz_u16(&e) : (int32_t)fuzz_u32(&e);
+            svc_alarma_activar_en((uint32_t)s_ahora_ms + (uint32_t)delta, ev, aux);
+            m_programar(ev, aux, false, delta > 0 ? (uint32_t)delta : 0);
+            break;
+        }
+        case 3:
+            svc_alarma_desactivar(ev, aux);
+            m_desactivar(ev, aux);
+            break;
+        case 4: case 5:
+            avanzar(fuzz_u8(&e) % 48u, false);
+            break;
+        case 6:
+            avanzar(fuzz_u16(&e), true);
+            break;
+        default:
+            avanzar(fuzz_u32(&e) & 0x00FFFFFFu, true);
+            break;
+        }
+        m_contabilizar_tick();
+        comprobar();
+    }
+    return 0;
+}
@@ -0,0 +1,51 @@
+/* *****************************************************************************
+ * P.H.2025: definicion de la placa "host" (firmware ejecutado en Linux)
+ *
+ * Pines virtuales sobre dos puertos de 32 bits, como el nRF52840. Los
+ * botones se pulsan desde el teclado (teclas 1..4) y los LEDs se pintan en
+ * el terminal; ver hal_host.h.
+ */
+
+#ifndef BOARD_HOST
+#define BOARD_HOST
+
+// LEDs
+#define LEDS_NUMBER    4
+
+#define LED_1          0
+#define LED_2          1
+#define LED_3          2
+#define LED_4          3
+
+#define LEDS_ACTIVE_STATE 1
+
+#define LEDS_LIST { LED_1, LED_2, LED_3, LED_4 }
+
+// Botones (activos a nivel bajo, con pull-up como en las placas)
+#define BUTTONS_NUMBER 4
+
+#define BUTTON_1       11
+#define BUTTON_2       12
+#define BUTTON_3       13
+#define BUTTON_4       14
+
+#define BUTTON_PULL    1
+
+#define BUTTONS_ACTIVE_STATE 0
+
+#define BUTTONS_LIST { BUTTON_1, BUTTON_2, BUTTON_3, BUTTON_4 }
+
+// MONITORES
+#define MONITOR_NUMBER 4
+
+#define MONITOR1       28
+#define MONITOR2       29
+#define MONITOR3       30
+#define MONITOR4       31
+
+#define MONITOR_LIST {MONITOR1, MONITOR2, MONITOR3, MONITOR4}
+
+// RAM "retenida": en host el apagado no reinicia el proceso
+#define RAM_RETENIDA_BYTES  256
+
+#endif
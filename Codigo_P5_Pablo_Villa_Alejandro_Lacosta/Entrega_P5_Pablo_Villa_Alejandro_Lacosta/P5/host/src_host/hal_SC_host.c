@@ -0,0 +1,25 @@
+/* *****************************************************************************
+ * P.H.2025: hal_SC_host.c
+ *
+ * Secciones criticas en host: las "interrupciones" solo se atienden dentro
+ * de hal_host_esperar, asi que no hay nada que enmascarar. Se lleva el
+ * anidamiento para devolver lo mismo que en las placas.
+ *
+ * Autores: Alejandro Lacosta y Pablo Villa
+ * Universidad de Zaragoza
+ * ****************************************************************************/
+
+#include "hal_SC.h"
+
+static uint32_t nesting = 0;
+
+uint32_t hal_sc_entrar(void) {
+    nesting++;
+    return nesting;
+}
+
+void hal_sc_salir(void) {
+    if (nesting == 0)
+        return;
+    nesting--;
+}
@@ -0,0 +1,55 @@
+/* *****************************************************************************
+ * P.H.2025: hal_consumo_host.c
+ *
+ * HAL de consumo en host
+ * Autores: Alejandro Lacosta, Pablo Villa
+ *
+ *  - Esperar y reposo bloquean el proceso hasta la siguiente "interrupcion"
+ *    (hal_host_esperar): el firmware ocioso no gasta CPU.
+ *  - Dormir se comporta como el power-down del LPC: se paran el tick y el
+ *    watchdog, se espera a que se pulse un boton y se vuelve sin reiniciar.
+ *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include "hal_consumo.h"
+#include "hal_tiempo.h"
+#include "hal_host.h"
+#include "board.h"
+
+void hal_consumo_iniciar(void) {}
+
+void hal_consumo_esperar(void) {
+    hal_host_esperar();
+}
+
+void hal_consumo_reposo(void) {
+    hal_host_esperar();
+}
+
+void hal_consumo_hfclk(bool encender) {
+    (void)encender;
+}
+
+void hal_consumo_dormir(void) {
+    bool tick = hal_tiempo_host_periodico_activo();
+    uint32_t flancos = hal_ext_int_host_flancos();
+
+    fprintf(stderr, "[host] apagado: pulsa un boton para despertar\n");
+    hal_tiempo_periodico_enable(false);
+    hal_wdt_host_pausar(true);
+    while (hal_ext_int_host_flancos() == flancos)
+        hal_host_esperar();
+    hal_wdt_host_pausar(false);
+    if (tick) hal_tiempo_periodico_enable(true);
+}
+
+bool hal_consumo_despertado(void) {
+    return false;
+}
+
+void* hal_consumo_ram_retenida(uint32_t *bytes) {
+    static uint32_t s_ram[RAM_RETENIDA_BYTES / sizeof(uint32_t)];
+    if (bytes) *bytes = sizeof(s_ram);
+    return s_ram;
+}
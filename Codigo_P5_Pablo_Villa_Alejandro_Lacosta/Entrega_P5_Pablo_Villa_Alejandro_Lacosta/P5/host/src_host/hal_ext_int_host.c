@@ -0,0 +1,98 @@
+/* *****************************************************************************
+ * P.H.2025: hal_ext_int_host.c
+ * HAL de interrupciones externas en host
+ *
+ * Los flancos llegan de la consola (hal_host.c). La marca de tiempo es la
+ * de la lectura de la tecla, en la base de hal_tiempo_actual_tick64().
+ * *****************************************************************************/
+
+#include "hal_ext_int.h"
+#include "hal_tiempo.h"
+#include "hal_gpio.h"
+#include "hal_host.h"
+#include "board.h"
+
+#define NUM_LINEAS  4u
+
+static hal_ext_int_callback_t    s_cb = 0;
+static hal_ext_int_ts_callback_t s_cb_ts = 0;
+static uint32_t s_habilitadas = 0;
+static uint32_t s_despertar = 0;
+static uint32_t s_flancos = 0;
+
+static const HAL_GPIO_PIN_T s_pines_boton[BUTTONS_NUMBER] = BUTTONS_LIST;
+static uint64_t s_soltar_us[BUTTONS_NUMBER];
+
+void hal_ext_int_iniciar(hal_ext_int_callback_t cb) {
+    s_cb = cb;
+    s_cb_ts = 0;
+    s_habilitadas = 0;
+}
+
+void hal_ext_int_iniciar_ts(hal_ext_int_ts_callback_t cb) {
+    hal_ext_int_iniciar(0);
+    s_cb_ts = cb;
+}
+
+void hal_ext_int_habilitar(hal_ext_int_id_t id) {
+    if ((uint32_t)id < NUM_LINEAS) s_habilitadas |= 1u << id;
+}
+
+void hal_ext_int_deshabilitar(hal_ext_int_id_t id) {
+    if ((uint32_t)id < NUM_LINEAS) s_habilitadas &= ~(1u << id);
+}
+
+uint32_t hal_ext_int_leer_pin(uint8_t pin) {
+    return hal_gpio_leer(pin);
+}
+
+void hal_ext_int_habilitar_despertar(hal_ext_int_id_t id) {
+    if ((uint32_t)id < NUM_LINEAS) s_despertar |= 1u << id;
+}
+
+void hal_ext_int_deshabilitar_despertar(hal_ext_int_id_t id) {
+    if ((uint32_t)id < NUM_LINEAS) s_despertar &= ~(1u << id);
+}
+
+void hal_ext_int_host_flanco(hal_ext_int_id_t id) {
+    if ((uint32_t)id >= NUM_LINEAS) return;
+    if (s_despertar & (1u << id)) s_flancos++;
+    if (!(s_habilitadas & (1u << id))) return;
+
+    if (s_cb_ts)   s_cb_ts(id, hal_tiempo_actual_tick64());
+    else if (s_cb) s_cb(id);
+}
+
+uint32_t hal_ext_int_host_flancos(void) {
+    return s_flancos;
+}
+
+/* Suelta los botones cuyo plazo ha vencido y programa el siguiente */
+static void soltar_botones(void) {
+    uint64_t ahora = hal_tiempo_actual_tick64();
+    uint64_t proximo = 0;
+    for (uint8_t i = 0; i < BUTTONS_NUMBER; i++) {
+        if (s_soltar_us[i] == 0) continue;
+        if (s_soltar_us[i] <= ahora) {
+            s_soltar_us[i] = 0;
+            hal_gpio_host_forzar(s_pines_boton[i], 1);
+        } else if (proximo == 0 || s_soltar_us[i] < proximo) {
+            proximo = s_soltar_us[i];
+        }
+    }
+    if (proximo != 0) hal_host_plazo(proximo, soltar_botones);
+}
+
+void hal_ext_int_host_pulsar(hal_ext_int_id_t id) {
+    if ((uint32_t)id >= BUTTONS_NUMBER) return;
+    hal_gpio_host_forzar(s_pines_boton[id], 0);
+    hal_ext_int_host_flanco(id);
+    s_soltar_us[id] = hal_tiempo_actual_tick64() + HAL_HOST_PULSACION_MS * 1000u;
+    soltar_botones();
+}
+
+void hal_ext_int_host_soltar(hal_ext_int_id_t id) {
+    if ((uint32_t)id >= BUTTONS_NUMBER) return;
+    s_soltar_us[id] = 0;
+    hal_gpio_host_forzar(s_pines_boton[id], 1);
+}
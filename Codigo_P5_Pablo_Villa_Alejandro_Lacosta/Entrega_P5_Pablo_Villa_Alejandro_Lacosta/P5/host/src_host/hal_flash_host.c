@@ -0,0 +1,68 @@
+/* *****************************************************************************
+ * P.H.2025: Flash de datos en host
+ * Implementacion para cumplir el hal_flash.h
+ *
+ * - Misma emulacion que en el LPC (paginas en RAM con semantica NOR).
+ * - Si la variable de entorno P5_FLASH nombra un fichero, las paginas se
+ *   cargan de el al iniciar y se escriben en el tras cada cambio: svc_kv
+ *   conserva los valores entre ejecuciones.
+ * *****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "hal_flash.h"
+
+#define PALABRAS_PAGINA  128u
+
+static uint32_t s_paginas[HAL_FLASH_PAGINAS][PALABRAS_PAGINA];
+static const char *s_fichero = NULL;
+
+static void volcar(void) {
+    if (s_fichero == NULL) return;
+    FILE *f = fopen(s_fichero, "wb");
+    if (f == NULL) return;
+    fwrite(s_paginas, sizeof(s_paginas), 1, f);
+    fclose(f);
+}
+
+void hal_flash_iniciar(void) {
+    static bool s_iniciada = false;
+    if (s_iniciada) return;
+    s_iniciada = true;
+
+    for (uint8_t p = 0; p < HAL_FLASH_PAGINAS; p++)
+        for (uint32_t i = 0; i < PALABRAS_PAGINA; i++)
+            s_paginas[p][i] = HAL_FLASH_BORRADO;
+
+    s_fichero = getenv("P5_FLASH");
+    if (s_fichero != NULL) {
+        FILE *f = fopen(s_fichero, "rb");
+        if (f != NULL) {
+            if (fread(s_paginas, sizeof(s_paginas), 1, f) != 1) { }
+            fclose(f);
+        }
+    }
+}
+
+uint32_t hal_flash_palabras_pagina(void) {
+    return PALABRAS_PAGINA;
+}
+
+const uint32_t* hal_flash_pagina(uint8_t pagina) {
+    return (pagina < HAL_FLASH_PAGINAS) ? s_paginas[pagina] : 0;
+}
+
+void hal_flash_escribir(uint8_t pagina, uint32_t offset, const uint32_t *datos, uint32_t n) {
+    if (pagina >= HAL_FLASH_PAGINAS || offset + n > PALABRAS_PAGINA) return;
+    for (uint32_t i = 0; i < n; i++)
+        s_paginas[pagina][offset + i] &= datos[i];      // solo 1 -> 0
+    volcar();
+}
+
+bool hal_flash_borrar_paso(uint8_t pagina) {
+    if (pagina >= HAL_FLASH_PAGINAS) return true;
+    for (uint32_t i = 0; i < PALABRAS_PAGINA; i++)
+        s_paginas[pagina][i] = HAL_FLASH_BORRADO;
+    volcar();
+    return true;
+}
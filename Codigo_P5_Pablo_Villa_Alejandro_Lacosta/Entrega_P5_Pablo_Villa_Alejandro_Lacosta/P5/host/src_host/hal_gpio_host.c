@@ -0,0 +1,108 @@
+/* *****************************************************************************
+ * P.H.2025: GPIOs virtuales en host
+ * Implementacion para cumplir el hal_gpio.h
+ *
+ * - Dos puertos de 32 pines. Las entradas leen a 1 (pull-up) salvo que la
+ *   consola las fuerce (botones).
+ * - Cada vez que cambia algun LED (por GPIO o por PWM) se pinta una linea
+ *   en stderr:  "   1234 ms leds [#.o.]"  (# encendido, o nivel intermedio,
+ *   . apagado).
+ *   stdout queda para la UART.
+ * *****************************************************************************/
+
+#include <stdio.h>
+#include "board.h"
+#include "hal_gpio.h"
+#include "hal_tiempo.h"
+#include "hal_host.h"
+
+#define NUM_PUERTOS  2u
+
+static uint32_t s_salida[NUM_PUERTOS];     // bit = pin de salida
+static uint32_t s_escrito[NUM_PUERTOS];    // nivel escrito en las salidas
+static uint32_t s_forzado[NUM_PUERTOS];    // nivel de las entradas
+
+static const HAL_GPIO_PIN_T s_leds[LEDS_NUMBER] = LEDS_LIST;
+static int32_t s_pwm[LEDS_NUMBER];         // -1: manda el GPIO
+static char    s_pintado[LEDS_NUMBER + 1];
+
+static inline uint32_t puerto(HAL_GPIO_PIN_T gpio) { return (gpio >> 5) % NUM_PUERTOS; }
+static inline uint32_t bit(HAL_GPIO_PIN_T gpio)    { return 1u << (gpio & 31u); }
+
+static void pintar_leds(void) {
+    char linea[LEDS_NUMBER + 1];
+    for (uint32_t i = 0; i < LEDS_NUMBER; i++) {
+        HAL_GPIO_PIN_T pin = s_leds[i];
+        uint32_t on;
+        if (s_pwm[i] >= 0) {
+            on = (s_pwm[i] == 0) ? 0u : (s_pwm[i] >= 255) ? 2u : 1u;
+        } else {
+            uint32_t nivel = (s_escrito[puerto(pin)] & bit(pin)) ? 1u : 0u;
+            on = (nivel == LEDS_ACTIVE_STATE) ? 2u : 0u;
+        }
+        linea[i] = (on == 2u) ? '#' : (on == 1u) ? 'o' : '.';
+    }
+    linea[LEDS_NUMBER] = '\0';
+
+    bool igual = true;
+    for (uint32_t i = 0; i <= LEDS_NUMBER; i++)
+        if (linea[i] != s_pintado[i]) igual = false;
+    if (igual) return;
+
+    for (uint32_t i = 0; i <= LEDS_NUMBER; i++) s_pintado[i] = linea[i];
+    fprintf(stderr, "%7lu ms leds [%s]\n",
+            (unsigned long)(hal_tiempo_actual_tick64() / 1000u), linea);
+}
+
+void hal_gpio_iniciar(void) {
+    for (uint32_t p = 0; p < NUM_PUERTOS; p++) {
+        s_salida[p] = 0;
+        s_escrito[p] = 0;
+        s_forzado[p] = 0xFFFFFFFFu;
+    }
+    for (uint32_t i = 0; i < LEDS_NUMBER; i++) {
+        HAL_GPIO_PIN_T pin = s_leds[i];
+        s_pwm[i] = -1;
+        s_salida[puerto(pin)] |= bit(pin);
+        if (LEDS_ACTIVE_STATE) s_escrito[puerto(pin)] &= ~bit(pin);
+        else                   s_escrito[puerto(pin)] |= bit(pin);
+    }
+    pintar_leds();
+}
+
+void hal_gpio_sentido(HAL_GPIO_PIN_T gpio, hal_gpio_pin_dir_t direccion) {
+    if (direccion == HAL_GPIO_PIN_DIR_OUTPUT) s_salida[puerto(gpio)] |= bit(gpio);
+    else                                      s_salida[puerto(gpio)] &= ~bit(gpio);
+}
+
+uint32_t hal_gpio_leer_puerto(uint32_t p) {
+    p %= NUM_PUERTOS;
+    return (s_escrito[p] & s_salida[p]) | (s_forzado[p] & ~s_salida[p]);
+}
+
+uint32_t hal_gpio_leer(HAL_GPIO_PIN_T gpio) {
+    return (hal_gpio_leer_puerto(puerto(gpio)) & bit(gpio)) != 0;
+}
+
+void hal_gpio_escribir(HAL_GPIO_PIN_T gpio, uint32_t valor) {
+    if ((valor & 0x01) == 0) s_escrito[puerto(gpio)] &= ~bit(gpio);
+    else                     s_escrito[puerto(gpio)] |= bit(gpio);
+    pintar_leds();
+}
+
+void hal_gpio_escribir_puerto(uint32_t p, uint32_t alto, uint32_t bajo) {
+    p %= NUM_PUERTOS;
+    s_escrito[p] = (s_escrito[p] | alto) & ~bajo;
+    pintar_leds();
+}
+
+void hal_gpio_host_forzar(HAL_GPIO_PIN_T gpio, uint32_t nivel) {
+    if (nivel) s_forzado[puerto(gpio)] |= bit(gpio);
+    else       s_forzado[puerto(gpio)] &= ~bit(gpio);
+}
+
+void hal_gpio_host_pwm(HAL_GPIO_PIN_T gpio, int32_t nivel) {
+    for (uint32_t i = 0; i < LEDS_NUMBER; i++)
+        if (s_leds[i] == gpio) s_pwm[i] = nivel;
+    pintar_leds();
+}
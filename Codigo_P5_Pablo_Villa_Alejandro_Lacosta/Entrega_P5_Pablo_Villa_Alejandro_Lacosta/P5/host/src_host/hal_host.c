@@ -0,0 +1,195 @@
+/* *****************************************************************************
+ * P.H.2025: hal_host.c
+ * Bucle de "interrupciones" de la HAL POSIX y consola
+ *
+ * Autores: Alejandro Lacosta, Pablo Villa
+ *
+ * Notas:
+ *  - hal_host_esperar hace un poll() sobre los descriptores registrados con
+ *    el plazo mas proximo como timeout; es el equivalente al WFI.
+ *  - La consola se prepara en la primera espera: antes el firmware solo
+ *    esta arrancando y no lee entradas.
+ *  - El terminal se deja como estaba al salir (exit o Ctrl-C).
+ * *****************************************************************************/
+
+#define _GNU_SOURCE
+#include "hal_host.h"
+#include "hal_tiempo.h"
+#include "board.h"
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef struct {
+    int                fd;
+    hal_host_atender_t atender;
+} fuente_t;
+
+typedef struct {
+    uint64_t           us;
+    hal_host_atender_t cb;
+} plazo_t;
+
+static fuente_t s_fuentes[HAL_HOST_MAX_FUENTES];
+static uint8_t  s_num_fuentes = 0;
+static plazo_t  s_plazos[HAL_HOST_MAX_PLAZOS];
+
+// -----------------------------------------------------------------------------
+// Fuentes y plazos
+// -----------------------------------------------------------------------------
+
+void hal_host_fuente(int fd, hal_host_atender_t atender) {
+    for (uint8_t i = 0; i < s_num_fuentes; i++) {
+        if (s_fuentes[i].fd == fd) {
+            s_fuentes[i].atender = atender;
+            return;
+        }
+    }
+    if (s_num_fuentes >= HAL_HOST_MAX_FUENTES) return;
+    s_fuentes[s_num_fuentes].fd = fd;
+    s_fuentes[s_num_fuentes].atender = atender;
+    s_num_fuentes++;
+}
+
+void hal_host_quitar_fuente(int fd) {
+    for (uint8_t i = 0; i < s_num_fuentes; i++) {
+        if (s_fuentes[i].fd == fd) {
+            s_fuentes[i] = s_fuentes[--s_num_fuentes];
+            return;
+        }
+    }
+}
+
+void hal_host_plazo(uint64_t us, hal_host_atender_t cb) {
+    plazo_t *libre = NULL;
+    for (uint8_t i = 0; i < HAL_HOST_MAX_PLAZOS; i++) {
+        if (s_plazos[i].cb == cb) {
+            s_plazos[i].us = us;
+            return;
+        }
+        if (s_plazos[i].cb == NULL && libre == NULL) libre = &s_plazos[i];
+    }
+    if (libre != NULL) {
+        libre->us = us;
+        libre->cb = cb;
+    }
+}
+
+void hal_host_cancelar_plazo(hal_host_atender_t cb) {
+    for (uint8_t i = 0; i < HAL_HOST_MAX_PLAZOS; i++)
+        if (s_plazos[i].cb == cb) s_plazos[i].cb = NULL;
+}
+
+uint32_t hal_host_semilla(void) {
+    return (uint32_t)time(NULL);
+}
+
+// -----------------------------------------------------------------------------
+// Consola: botones y recepcion de la UART
+// -----------------------------------------------------------------------------
+
+static struct termios s_termios;
+static bool s_termios_guardado = false;
+static bool s_linea_en_curso = false;    // caracteres enviados a la UART sin '\n'
+
+static void restaurar_terminal(void) {
+    if (s_termios_guardado) tcsetattr(STDIN_FILENO, TCSANOW, &s_termios);
+}
+
+static void al_interrumpir(int sig) {
+    (void)sig;
+    restaurar_terminal();
+    _exit(130);
+}
+
+static void tecla(char c) {
+    if (!s_linea_en_curso && c >= '1' && c < '1' + BUTTONS_NUMBER) {
+        hal_ext_int_host_pulsar((hal_ext_int_id_t)(c - '1'));
+        return;
+    }
+    if (c == '\r') c = '\n';
+    if (!hal_uart_host_recibir(c)) return;
+
+    if (s_termios_guardado) {
+        if (c == 0x7F || c == '\b') c = '\b';
+        if (write(STDOUT_FILENO, &c, 1) < 0) { }
+    }
+    s_linea_en_curso = (c != '\n');
+}
+
+static void leer_consola(void) {
+    char buf[64];
+    ssize_t n = read(STDIN_FILENO, buf, sizeof(buf));
+    if (n <= 0) {                               // fin del guion o error
+        if (n == 0 || errno != EINTR) hal_host_quitar_fuente(STDIN_FILENO);
+        return;
+    }
+    for (ssize_t i = 0; i < n; i++) tecla(buf[i]);
+}
+
+static void iniciar_consola(void) {
+    static bool s_iniciada = false;
+    if (s_iniciada) return;
+    s_iniciada = true;
+
+    if (isatty(STDIN_FILENO) && tcgetattr(STDIN_FILENO, &s_termios) == 0) {
+        struct termios t = s_termios;
+        t.c_lflag &= ~(ICANON | ECHO);          // tecla a tecla, Ctrl-C sigue
+        t.c_cc[VMIN] = 1;
+        t.c_cc[VTIME] = 0;
+        tcsetattr(STDIN_FILENO, TCSANOW, &t);
+        s_termios_guardado = true;
+        atexit(restaurar_terminal);
+        signal(SIGINT, al_interrumpir);
+        signal(SIGTERM, al_interrumpir);
+    }
+    hal_host_fuente(STDIN_FILENO, leer_consola);
+}
+
+// -----------------------------------------------------------------------------
+// Espera
+// -----------------------------------------------------------------------------
+
+void hal_host_esperar(void) {
+    iniciar_consola();
+
+    uint64_t ahora = hal_tiempo_actual_tick64();
+    int timeout_ms = -1;
+    for (uint8_t i = 0; i < HAL_HOST_MAX_PLAZOS; i++) {
+        if (s_plazos[i].cb == NULL) continue;
+        uint64_t falta = (s_plazos[i].us > ahora) ? s_plazos[i].us - ahora : 0;
+        int ms = (int)((falta + 999u) / 1000u);
+        if (timeout_ms < 0 || ms < timeout_ms) timeout_ms = ms;
+    }
+
+    struct pollfd pfd[HAL_HOST_MAX_FUENTES];
+    uint8_t n = s_num_fuentes;
+    for (uint8_t i = 0; i < n; i++) {
+        pfd[i].fd = s_fuentes[i].fd;
+        pfd[i].events = POLLIN;
+        pfd[i].revents = 0;
+    }
+    if (n == 0 && timeout_ms < 0) {             // nada puede despertar
+        pause();
+        return;
+    }
+    if (poll(pfd, n, timeout_ms) < 0) return;   // EINTR: se vuelve a mirar
+
+    for (uint8_t i = 0; i < n; i++) {
+        if (pfd[i].revents == 0) continue;
+        for (uint8_t j = 0; j < s_num_fuentes; j++)
+            if (s_fuentes[j].fd == pfd[i].fd) { s_fuentes[j].atender(); break; }
+    }
+
+    ahora = hal_tiempo_actual_tick64();
+    for (uint8_t i = 0; i < HAL_HOST_MAX_PLAZOS; i++) {
+        hal_host_atender_t cb = s_plazos[i].cb;
+        if (cb == NULL || s_plazos[i].us > ahora) continue;
+        s_plazos[i].cb = NULL;
+        cb();
+    }
+}
@@ -0,0 +1,105 @@
+/******************************************************************************
+ * Fichero: hal_host.h
+ * Proyecto: P.H.2025
+ *
+ * Nucleo comun de la HAL POSIX (firmware ejecutado como proceso Linux).
+ *
+ * Un solo hilo y sin senales: las "interrupciones" (tick periodico por
+ * timerfd, teclado, plazos internos) se atienden dentro de
+ * hal_host_esperar, que es lo que hace hal_consumo_esperar. Fuera de ahi
+ * nada interrumpe al codigo, con lo que hal_SC solo lleva el anidamiento.
+ * Como en las placas, el firmware solo espera interrupciones desde el
+ * lanzador con la cola vacia.
+ *
+ * Consola (entrada estandar, sin eco ni buffer de linea si es un terminal):
+ *  - '1'..'4' al principio de linea: pulsa el boton (lo suelta a los
+ *    HAL_HOST_PULSACION_MS).
+ *  - Cualquier otro caracter va a la UART (si alguien escucha) con eco.
+ *  - Con una tuberia se puede guionizar la partida:
+ *      (sleep 2; printf 1; sleep 0.4; printf 3) | ./p5_host
+ *
+ * Compilacion: objetivo p5_host de CMakeLists.txt (placa HOST_POSIX).
+ *
+ * Autores:
+ *   Alejandro Lacosta
+ *   Pablo Villa
+ *
+ * Universidad de Zaragoza
+ *
+ *****************************************************************************/
+
+#ifndef HAL_HOST_H
+#define HAL_HOST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hal_gpio.h"
+#include "hal_ext_int.h"
+
+#define HAL_HOST_PULSACION_MS  80u
+#define HAL_HOST_MAX_FUENTES   4
+#define HAL_HOST_MAX_PLAZOS    4
+
+typedef void (*hal_host_atender_t)(void);
+
+/**
+ * @brief Atiende 'atender' cada vez que el descriptor tenga datos.
+ */
+void hal_host_fuente(int fd, hal_host_atender_t atender);
+
+/**
+ * @brief Deja de vigilar un descriptor.
+ */
+void hal_host_quitar_fuente(int fd);
+
+/**
+ * @brief Programa 'cb' para el instante 'us' (base hal_tiempo_actual_tick64).
+ *        Un mismo cb solo tiene un plazo: reprogramarlo sustituye al anterior.
+ */
+void hal_host_plazo(uint64_t us, hal_host_atender_t cb);
+
+/**
+ * @brief Anula el plazo de 'cb', si lo tiene.
+ */
+void hal_host_cancelar_plazo(hal_host_atender_t cb);
+
+/**
+ * @brief Bloquea hasta que haya algo que atender y lo atiende.
+ */
+void hal_host_esperar(void);
+
+/**
+ * @brief Semilla para hal_random_iniciar(0).
+ */
+uint32_t hal_host_semilla(void);
+
+// --- Entre modulos de la HAL host ---
+
+/* Nivel de un pin de entrada impuesto desde fuera (boton) */
+void hal_gpio_host_forzar(HAL_GPIO_PIN_T gpio, uint32_t nivel);
+
+/* Nivel PWM de un pin de LED para pintarlo (-1: vuelve a mandar el GPIO) */
+void hal_gpio_host_pwm(HAL_GPIO_PIN_T gpio, int32_t nivel);
+
+/* Flanco de bajada en la linea de interrupcion 'id' */
+void hal_ext_int_host_flanco(hal_ext_int_id_t id);
+
+/* Pulsacion del boton 'id': flanco ahora y se suelta a HAL_HOST_PULSACION_MS */
+void hal_ext_int_host_pulsar(hal_ext_int_id_t id);
+
+/* Suelta el boton 'id' ya (rebotes): anula la suelta programada */
+void hal_ext_int_host_soltar(hal_ext_int_id_t id);
+
+/* Flancos vistos desde el arranque (para salir del apagado) */
+uint32_t hal_ext_int_host_flancos(void);
+
+/* Caracter recibido por la UART; false si nadie escucha */
+bool hal_uart_host_recibir(char c);
+
+/* Para el watchdog durante el apagado (como el PCLK del LPC) y lo rearma */
+void hal_wdt_host_pausar(bool pausar);
+
+/* Estado del reloj periodico (para pararlo durante el apagado) */
+bool hal_tiempo_host_periodico_activo(void);
+
+#endif // HAL_HOST_H
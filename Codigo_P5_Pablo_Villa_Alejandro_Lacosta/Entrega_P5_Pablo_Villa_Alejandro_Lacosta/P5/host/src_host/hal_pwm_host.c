@@ -0,0 +1,33 @@
+/* *****************************************************************************
+ * P.H.2025: PWM en host
+ * Implementacion para cumplir el hal_pwm.h
+ *
+ * No hay senal que modular: el nivel se entrega a hal_gpio_host para
+ * pintarlo. Un fundido deja directamente el nivel final.
+ * *****************************************************************************/
+
+#include "hal_pwm.h"
+#include "hal_host.h"
+
+static HAL_GPIO_PIN_T s_pin[HAL_PWM_CANALES];
+static uint8_t s_num = 0;
+
+void hal_pwm_iniciar(const HAL_GPIO_PIN_T pines[], uint8_t num, uint32_t activo_alto) {
+    (void)activo_alto;
+    s_num = (num <= HAL_PWM_CANALES) ? num : HAL_PWM_CANALES;
+    for (uint8_t i = 0; i < s_num; i++) s_pin[i] = pines[i];
+}
+
+void hal_pwm_nivel(uint8_t canal, uint8_t nivel) {
+    if (canal < s_num) hal_gpio_host_pwm(s_pin[canal], nivel);
+}
+
+void hal_pwm_rampa(uint8_t canal, uint8_t desde, uint8_t hasta, uint32_t ms) {
+    (void)desde;
+    (void)ms;
+    hal_pwm_nivel(canal, hasta);
+}
+
+void hal_pwm_soltar(uint8_t canal) {
+    if (canal < s_num) hal_gpio_host_pwm(s_pin[canal], -1);
+}
@@ -0,0 +1,42 @@
+/* *****************************************************************************
+ * P.H.2025: hal_random_host.c
+ * HAL de numeros aleatorios en host
+ *
+ * Mismo xorshift32 y mismo reparto en [1..max] que en el LPC: con la misma
+ * semilla (p.ej. reproduccion de una grabacion) la secuencia es identica.
+ * Con semilla 0 se toma hal_host_semilla() (la hora; fija en simulacion).
+ * *****************************************************************************/
+
+#include <stdint.h>
+#include "hal_random.h"
+#include "hal_host.h"
+
+static uint32_t s_state = 1u;
+
+static inline uint32_t xorshift32_step(uint32_t x) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+void hal_random_iniciar(uint32_t seed) {
+    uint32_t s = seed;
+    if (s == 0) {
+        s = xorshift32_step(hal_host_semilla());
+        if (s == 0) s = 0xA3C59AC3u;
+    }
+    s_state = s;
+}
+
+uint32_t hal_random(uint32_t max) {
+    if (max == 0) return 0;
+
+    uint32_t x = s_state;
+    if (x == 0) x = 1u;
+    x = xorshift32_step(x);
+    x = xorshift32_step(x);
+    s_state = x;
+
+    return (uint32_t)(((uint64_t)x * (uint64_t)max) >> 32) + 1u;
+}
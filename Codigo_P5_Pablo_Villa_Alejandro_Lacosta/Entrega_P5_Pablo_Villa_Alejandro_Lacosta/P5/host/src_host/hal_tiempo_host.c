@@ -0,0 +1,132 @@
+/* *****************************************************************************
+ * P.H.2025: hal_tiempo_host.c
+ * HAL de tiempo para el firmware ejecutado en Linux
+ *
+ * Autores: Alejandro Lacosta, Pablo Villa
+ *
+ * Implementa:
+ *  - Reloj monotono en us sobre clock_gettime(CLOCK_MONOTONIC).
+ *  - Reloj periodico sobre un timerfd: su "IRQ" se atiende en
+ *    hal_host_esperar (una llamada al callback aunque se hayan perdido
+ *    varios periodos, como el flag de interrupcion de un timer real).
+ *
+ * Los periodos siguen llegando en ticks de 32768 Hz, como en las placas.
+ * *****************************************************************************/
+
+#define _GNU_SOURCE
+#include "hal_tiempo.h"
+#include "hal_host.h"
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+static uint64_t s_base_ns = 0;
+static bool     s_iniciado = false;
+
+static int      s_fd = -1;
+static void   (*s_cb)(void) = 0;
+static uint32_t s_periodo = 0;          // periodo en ticks de 32768 Hz
+static bool     s_pospuesto = false;
+static bool     s_habilitado = false;
+
+static uint64_t ahora_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static struct timespec ticks_a_timespec(uint32_t ticks) {
+    uint64_t ns = ((uint64_t)ticks * 1000000000ull) / 32768u;
+    struct timespec ts = { (time_t)(ns / 1000000000ull), (long)(ns % 1000000000ull) };
+    return ts;
+}
+
+/* Primer disparo a 'primero' ticks y despues cada periodo */
+static void programar(uint32_t primero) {
+    struct itimerspec it;
+    it.it_value    = ticks_a_timespec(primero);
+    it.it_interval = ticks_a_timespec(s_periodo);
+    timerfd_settime(s_fd, 0, &it, NULL);
+}
+
+static void atender_periodico(void) {
+    uint64_t expiraciones;
+    if (read(s_fd, &expiraciones, sizeof(expiraciones)) != sizeof(expiraciones)) return;
+    s_pospuesto = false;                 // el intervalo ya es el periodo
+    if (s_cb) s_cb();
+}
+
+/* ========================== Reloj monotono ========================== */
+
+void hal_tiempo_iniciar_tick(hal_tiempo_info_t *out_info) {
+    if (!s_iniciado) {
+        s_base_ns = ahora_ns();
+        s_iniciado = true;
+    }
+    if (out_info) {
+        out_info->ticks_per_us = 1u;
+        out_info->counter_bits = 32u;
+        out_info->counter_max  = 0xFFFFFFFFu;
+    }
+}
+
+uint64_t hal_tiempo_actual_tick64(void) {
+    if (!s_iniciado) hal_tiempo_iniciar_tick(0);
+    return (ahora_ns() - s_base_ns) / 1000u;
+}
+
+/* ========================== Reloj periodico ========================== */
+
+void hal_tiempo_periodico_config_tick(uint32_t periodo_en_tick) {
+    if (s_fd < 0) {
+        s_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        if (s_fd < 0) return;
+    }
+    hal_tiempo_periodico_enable(false);
+    s_periodo = periodo_en_tick;
+}
+
+void hal_tiempo_periodico_set_callback(void (*cb)()) {
+    s_cb = cb;
+}
+
+void hal_tiempo_periodico_enable(bool enable) {
+    if (s_fd < 0) return;
+    s_habilitado = enable && s_periodo != 0;
+    s_pospuesto = false;
+    if (s_habilitado) {
+        programar(s_periodo);            // primer disparo un periodo despues
+        hal_host_fuente(s_fd, atender_periodico);
+    } else {
+        struct itimerspec it = { { 0, 0 }, { 0, 0 } };
+        timerfd_settime(s_fd, 0, &it, NULL);
+        hal_host_quitar_fuente(s_fd);
+    }
+}
+
+void hal_tiempo_periodico_posponer(uint32_t ticks) {
+    if (!s_habilitado) hal_tiempo_periodico_enable(true);
+    if (ticks <= s_periodo || !s_habilitado) return;
+    programar(ticks);
+    s_pospuesto = true;
+}
+
+void hal_tiempo_periodico_reanudar(void) {
+    if (!s_pospuesto) return;
+    programar(s_periodo);
+    s_pospuesto = false;
+}
+
+void hal_tiempo_reloj_periodico_tick(uint32_t periodo_en_tick, void (*cb)()) {
+    if (periodo_en_tick == 0 || cb == 0) {
+        hal_tiempo_periodico_enable(false);
+        return;
+    }
+    hal_tiempo_periodico_set_callback(cb);
+    hal_tiempo_periodico_config_tick(periodo_en_tick);
+    hal_tiempo_periodico_enable(true);
+}
+
+bool hal_tiempo_host_periodico_activo(void) {
+    return s_habilitado;
+}
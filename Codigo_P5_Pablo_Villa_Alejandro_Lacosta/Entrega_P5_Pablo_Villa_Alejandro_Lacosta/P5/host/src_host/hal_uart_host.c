@@ -0,0 +1,59 @@
+/* *****************************************************************************
+ * P.H.2025: hal_uart_host.c
+ * HAL de UART en host: transmision a stdout, recepcion desde la consola
+ *
+ * La transmision es sincrona: hal_uart_tx_arrancar vacia el callback de
+ * una vez con write(), asi que nunca queda nada "en curso".
+ * *****************************************************************************/
+
+#include <unistd.h>
+#include "hal_uart.h"
+#include "hal_host.h"
+
+static hal_uart_rx_callback_t s_rx_cb = 0;
+static hal_uart_tx_callback_t s_tx_cb = 0;
+
+static void escribir(const uint8_t *buf, uint32_t n) {
+    while (n > 0) {
+        ssize_t w = write(STDOUT_FILENO, buf, n);
+        if (w <= 0) return;
+        buf += w;
+        n -= (uint32_t)w;
+    }
+}
+
+void hal_uart_init(void) {}
+
+int hal_uart_sendchar(char ch) {
+    escribir((const uint8_t *)&ch, 1);
+    return 0;
+}
+
+void hal_uart_rx_iniciar(hal_uart_rx_callback_t cb) {
+    s_rx_cb = cb;
+}
+
+void hal_uart_tx_iniciar(hal_uart_tx_callback_t cb) {
+    s_tx_cb = cb;
+}
+
+void hal_uart_tx_arrancar(void) {
+    uint8_t buf[64];
+    uint32_t n;
+    if (s_tx_cb == 0) return;
+    while ((n = s_tx_cb(buf, sizeof(buf))) > 0) escribir(buf, n);
+}
+
+bool hal_uart_tx_ocupada(void) {
+    return false;
+}
+
+void hal_uart_alimentar(bool encender) {
+    (void)encender;
+}
+
+bool hal_uart_host_recibir(char c) {
+    if (s_rx_cb == 0) return false;
+    s_rx_cb(c);
+    return true;
+}
@@ -0,0 +1,51 @@
+/* *****************************************************************************
+ * P.H.2025: hal_wdt_host.c
+ *
+ * Watchdog en host sobre un temporizador de proceso (setitimer/SIGALRM):
+ * si el firmware se cuelga en un bucle sin alimentarlo, el proceso acaba
+ * con un mensaje en vez de reiniciarse.
+ *
+ * Autores: Alejandro Lacosta y Pablo Villa
+ * Universidad de Zaragoza
+ * ****************************************************************************/
+
+#include "hal_wdt.h"
+#include "hal_host.h"
+#include <signal.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#define CODIGO_SALIDA_WDT  3
+
+static uint32_t s_timeout_ms = 0;
+
+static void al_vencer(int sig) {
+    static const char msg[] = "\n[host] WDT vencido: reinicio\n";
+    (void)sig;
+    if (write(STDERR_FILENO, msg, sizeof(msg) - 1) < 0) { }
+    _exit(CODIGO_SALIDA_WDT);
+}
+
+void hal_wdt_iniciar(uint32_t timeout_ms) {
+    s_timeout_ms = timeout_ms;
+    signal(SIGALRM, al_vencer);
+    hal_wdt_alimentar();
+}
+
+void hal_wdt_alimentar(void) {
+    if (s_timeout_ms == 0) return;
+    struct itimerval it = {
+        { 0, 0 },
+        { (time_t)(s_timeout_ms / 1000u), (suseconds_t)((s_timeout_ms % 1000u) * 1000u) }
+    };
+    setitimer(ITIMER_REAL, &it, NULL);
+}
+
+void hal_wdt_host_pausar(bool pausar) {
+    if (!pausar) {
+        hal_wdt_alimentar();
+        return;
+    }
+    struct itimerval it = { { 0, 0 }, { 0, 0 } };
+    setitimer(ITIMER_REAL, &it, NULL);
+}
@@ -0,0 +1,247 @@
+/* *****************************************************************************
+ * P.H.2025: hal_sim.c
+ * Nucleo del simulador en tiempo virtual: reloj, plazos, guion e informe
+ *
+ * Autores: Alejandro Lacosta, Pablo Villa
+ *
+ * Notas:
+ *  - Implementa la interfaz de hal_host.h sobre el reloj virtual. No hay
+ *    descriptores que vigilar: hal_host_fuente no hace nada.
+ *  - Los plazos que vencen a la vez se atienden por orden de hora y, a
+ *    igual hora, por posicion en la tabla; despues van las acciones del
+ *    guion. Todo es determinista.
+ *  - Los eventos procesados salen de los contadores de rt_FIFO (los que
+ *    se han encolado menos los que siguen en la cola).
+ * *****************************************************************************/
+
+#include "hal_sim.h"
+#include "rt_fifo.h"
+#include "svc_energia.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    uint64_t           us;
+    hal_host_atender_t cb;
+} plazo_t;
+
+typedef enum { ACCION_BOTON, ACCION_SUELTA, ACCION_UART, ACCION_FIN } accion_tipo_t;
+
+typedef struct {
+    uint64_t      us;
+    accion_tipo_t tipo;
+    uint8_t       boton;
+    char          texto[HAL_SIM_MAX_TEXTO];
+} accion_t;
+
+static plazo_t  s_plazos[HAL_HOST_MAX_PLAZOS];
+
+static accion_t s_acciones[HAL_SIM_MAX_ACCIONES];
+static uint32_t s_num_acciones = 0;
+static uint32_t s_siguiente = 0;
+static uint64_t s_fin_us = 0;
+static bool     s_guion_cargado = false;
+
+static uint64_t s_ahora_us = 0;
+static uint64_t s_dormido_us = 0;
+static uint32_t s_despertares = 0;
+static uint32_t s_coste_us = HAL_SIM_COSTE_US;
+
+uint64_t hal_sim_ahora_us(void) {
+    return s_ahora_us;
+}
+
+// -----------------------------------------------------------------------------
+// Fuentes y plazos
+// -----------------------------------------------------------------------------
+
+void hal_host_fuente(int fd, hal_host_atender_t atender) {
+    (void)fd;
+    (void)atender;
+}
+
+void hal_host_quitar_fuente(int fd) {
+    (void)fd;
+}
+
+void hal_host_plazo(uint64_t us, hal_host_atender_t cb) {
+    plazo_t *libre = NULL;
+    for (uint8_t i = 0; i < HAL_HOST_MAX_PLAZOS; i++) {
+        if (s_plazos[i].cb == cb) {
+            s_plazos[i].us = us;
+            return;
+        }
+        if (s_plazos[i].cb == NULL && libre == NULL) libre = &s_plazos[i];
+    }
+    if (libre == NULL) {
+        hal_sim_terminar("tabla de plazos llena", 2);
+        return;
+    }
+    libre->us = us;
+    libre->cb = cb;
+}
+
+void hal_host_cancelar_plazo(hal_host_atender_t cb) {
+    for (uint8_t i = 0; i < HAL_HOST_MAX_PLAZOS; i++)
+        if (s_plazos[i].cb == cb) s_plazos[i].cb = NULL;
+}
+
+uint32_t hal_host_semilla(void) {
+    const char *s = getenv("P5_SEMILLA");
+    return (s != NULL) ? (uint32_t)strtoul(s, NULL, 0) : HAL_SIM_SEMILLA;
+}
+
+/* Plazo vencido mas antiguo, o -1 */
+static int plazo_vencido(void) {
+    int elegido = -1;
+    for (uint8_t i = 0; i < HAL_HOST_MAX_PLAZOS; i++) {
+        if (s_plazos[i].cb == NULL || s_plazos[i].us > s_ahora_us) continue;
+        if (elegido < 0 || s_plazos[i].us < s_plazos[elegido].us) elegido = i;
+    }
+    return elegido;
+}
+
+// -----------------------------------------------------------------------------
+// Guion
+// -----------------------------------------------------------------------------
+
+static void error_guion(uint32_t linea, const char *msg) {
+    fprintf(stderr, "[sim] guion, linea %lu: %s\n", (unsigned long)linea, msg);
+    exit(2);
+}
+
+static void cargar_guion(void) {
+    char linea[128];
+    uint32_t n_linea = 0;
+    uint64_t ultimo_us = 0;
+    bool con_fin = false;
+
+    s_guion_cargado = true;
+    const char *coste = getenv("P5_SIM_COSTE_US");
+    if (coste != NULL) s_coste_us = (uint32_t)strtoul(coste, NULL, 0);
+
+    FILE *guion = stdin;
+    const char *fichero = getenv("P5_GUION");
+    if (fichero != NULL && (guion = fopen(fichero, "r")) == NULL)
+        error_guion(0, "no se puede abrir P5_GUION");
+
+    while (!con_fin && fgets(linea, sizeof(linea), guion) != NULL) {
+        n_linea++;
+        char *p = linea + strspn(linea, " \t");
+        if (*p == '#' || *p == '\n' || *p == '\r' || *p == '\0') continue;
+
+        char *fin;
+        unsigned long long ms = strtoull(p, &fin, 10);
+        if (fin == p) error_guion(n_linea, "falta el instante en ms");
+        if (ms * 1000u < ultimo_us) error_guion(n_linea, "instante anterior al de la linea previa");
+        if (s_num_acciones >= HAL_SIM_MAX_ACCIONES) error_guion(n_linea, "demasiadas acciones");
+
+        accion_t *a = &s_acciones[s_num_acciones];
+        a->us = ultimo_us = (uint64_t)ms * 1000u;
+        p = fin + strspn(fin, " \t");
+        p[strcspn(p, "\r\n")] = '\0';
+
+        if (strncmp(p, "boton ", 6) == 0 || strncmp(p, "suelta ", 7) == 0) {
+            bool pulsar = (p[0] == 'b');
+            unsigned long b = strtoul(p + (pulsar ? 6 : 7), &fin, 10);
+            if (b < 1 || b > 4) error_guion(n_linea, "boton fuera de 1..4");
+            a->tipo = pulsar ? ACCION_BOTON : ACCION_SUELTA;
+            a->boton = (uint8_t)(b - 1);
+        } else if (strncmp(p, "uart ", 5) == 0) {
+            if (strlen(p + 5) >= HAL_SIM_MAX_TEXTO) error_guion(n_linea, "texto demasiado largo");
+            a->tipo = ACCION_UART;
+            strcpy(a->texto, p + 5);
+        } else if (strcmp(p, "fin") == 0) {
+            a->tipo = ACCION_FIN;
+            con_fin = true;
+        } else {
+            error_guion(n_linea, "accion desconocida (boton, suelta, uart, fin)");
+        }
+        s_num_acciones++;
+    }
+
+    if (guion != stdin) fclose(guion);
+    s_fin_us = con_fin ? ultimo_us : ultimo_us + (uint64_t)HAL_SIM_COLA_MS * 1000u;
+}
+
+static void ejecutar(const accion_t *a) {
+    switch (a->tipo) {
+        case ACCION_BOTON:
+            hal_ext_int_host_pulsar((hal_ext_int_id_t)a->boton);
+            break;
+        case ACCION_SUELTA:
+            hal_ext_int_host_soltar((hal_ext_int_id_t)a->boton);
+            break;
+        case ACCION_UART:
+            for (const char *c = a->texto; *c != '\0'; c++) hal_uart_host_recibir(*c);
+            hal_uart_host_recibir('\n');
+            break;
+        case ACCION_FIN:
+            break;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Espera e informe
+// -----------------------------------------------------------------------------
+
+void hal_sim_terminar(const char *motivo, int codigo) {
+    uint32_t total_ms = (uint32_t)(s_ahora_us / 1000u);
+    uint32_t dormido_ms = (uint32_t)(s_dormido_us / 1000u);
+    uint32_t despierto_ms = total_ms - dormido_ms;
+    uint32_t permil = (total_ms > 0) ? (uint32_t)((uint64_t)despierto_ms * 1000u / total_ms) : 0;
+
+    uint32_t eventos = 0;
+    for (uint32_t ev = ev_VOID + 1; ev < EVENT_TYPES; ev++)
+        eventos += rt_FIFO_estadisticas((EVENTO_T)ev);
+    eventos -= rt_FIFO_estadisticas(ev_VOID);
+
+    fflush(stdout);
+    fprintf(stderr, "[sim] %s en %lu ms simulados\n", motivo, (unsigned long)total_ms);
+    fprintf(stderr, "[sim] despertares: %lu\n", (unsigned long)s_despertares);
+    fprintf(stderr, "[sim] eventos procesados: %lu\n", (unsigned long)eventos);
+    fprintf(stderr, "[sim] despierto: %lu ms (%lu.%lu%%), dormido: %lu ms\n",
+            (unsigned long)despierto_ms, (unsigned long)(permil / 10u),
+            (unsigned long)(permil % 10u), (unsigned long)dormido_ms);
+    for (svc_energia_modo_t m = SVC_ENERGIA_ESPERA; m < SVC_ENERGIA_MODOS; m++)
+        fprintf(stderr, "[sim]   %s: %lu veces, %lu ms\n", svc_energia_nombre(m),
+                (unsigned long)svc_energia_entradas(m),
+                (unsigned long)svc_energia_residencia_ms(m));
+    exit(codigo);
+}
+
+void hal_host_esperar(void) {
+    if (!s_guion_cargado) cargar_guion();
+
+    // Siguiente instante en el que algo despierta al sistema
+    bool hay_fuente = s_siguiente < s_num_acciones;
+    uint64_t proximo = s_fin_us;
+    for (uint8_t i = 0; i < HAL_HOST_MAX_PLAZOS; i++) {
+        if (s_plazos[i].cb == NULL) continue;
+        hay_fuente = true;
+        if (s_plazos[i].us < proximo) proximo = s_plazos[i].us;
+    }
+    if (s_siguiente < s_num_acciones && s_acciones[s_siguiente].us < proximo)
+        proximo = s_acciones[s_siguiente].us;
+
+    if (!hay_fuente) hal_sim_terminar("nada puede despertar", 0);
+
+    if (proximo > s_ahora_us) {
+        s_dormido_us += proximo - s_ahora_us;
+        s_ahora_us = proximo;
+    }
+    if (s_ahora_us >= s_fin_us) hal_sim_terminar("fin del guion", 0);
+    s_despertares++;
+
+    int i;
+    while ((i = plazo_vencido()) >= 0) {
+        hal_host_atender_t cb = s_plazos[i].cb;
+        s_plazos[i].cb = NULL;
+        cb();
+    }
+    while (s_siguiente < s_num_acciones && s_acciones[s_siguiente].us <= s_ahora_us)
+        ejecutar(&s_acciones[s_siguiente++]);
+
+    s_ahora_us += s_coste_us;
+}
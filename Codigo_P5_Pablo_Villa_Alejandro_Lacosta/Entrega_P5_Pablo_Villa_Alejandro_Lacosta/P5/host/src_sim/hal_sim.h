@@ -0,0 +1,60 @@
+/******************************************************************************
+ * Fichero: hal_sim.h
+ * Proyecto: P.H.2025
+ *
+ * Simulador en tiempo virtual: sustituye el nucleo de la HAL host
+ * (hal_host.c, hal_tiempo_host.c, hal_wdt_host.c) y reutiliza el resto de
+ * host/src_host (GPIO, PWM, UART, flash, consumo...).
+ *
+ * - El reloj no avanza mientras el firmware ejecuta: hal_host_esperar salta
+ *   directamente al plazo mas proximo (tick periodico, boton por soltar,
+ *   watchdog o siguiente accion del guion). Cada despertar se cobra
+ *   HAL_SIM_COSTE_US de tiempo despierto (P5_SIM_COSTE_US lo cambia).
+ * - Sin hilos, sin senales y sin leer la hora: dos ejecuciones con el mismo
+ *   guion dan exactamente la misma salida.
+ * - El guion se lee del fichero P5_GUION (variable de entorno) o, si no
+ *   esta, de la entrada estandar; una accion por linea con el
+ *   instante absoluto en ms de tiempo simulado (no decreciente):
+ *      # comentario
+ *      1500 boton 1        pulsa el boton 1..4
+ *      1504 suelta 1       lo suelta antes de tiempo (para simular rebotes)
+ *      2000 uart stats     envia "stats\n" a la UART
+ *      3600000 fin         acaba la simulacion
+ *   Sin "fin", acaba HAL_SIM_COLA_MS despues de la ultima accion, o antes
+ *   si ya nada puede despertar al sistema (apagado sin botones pendientes).
+ * - Al acabar escribe en stderr los despertares, los eventos procesados, el
+ *   tiempo despierto y la residencia en cada modo de svc_energia.
+ *
+ * Compilacion: objetivo p5_sim de CMakeLists.txt (placa HOST_POSIX).
+ *
+ * Autores:
+ *   Alejandro Lacosta
+ *   Pablo Villa
+ *
+ * Universidad de Zaragoza
+ *
+ *****************************************************************************/
+
+#ifndef HAL_SIM_H
+#define HAL_SIM_H
+
+#include <stdint.h>
+#include "hal_host.h"
+
+#define HAL_SIM_COSTE_US     20u
+#define HAL_SIM_COLA_MS      60000u
+#define HAL_SIM_SEMILLA      0x2025u
+#define HAL_SIM_MAX_ACCIONES 1024
+#define HAL_SIM_MAX_TEXTO    48
+
+/**
+ * @brief Instante simulado en us desde el arranque.
+ */
+uint64_t hal_sim_ahora_us(void);
+
+/**
+ * @brief Acaba la simulacion: escribe el informe y sale con 'codigo'.
+ */
+void hal_sim_terminar(const char *motivo, int codigo);
+
+#endif // HAL_SIM_H
@@ -0,0 +1,100 @@
+/* *****************************************************************************
+ * P.H.2025: hal_tiempo_sim.c
+ * HAL de tiempo sobre el reloj virtual del simulador
+ *
+ * Autores: Alejandro Lacosta, Pablo Villa
+ *
+ * El reloj periodico es un plazo de hal_sim que se reprograma al vencer.
+ * Como en un timer real, los periodos perdidos se funden en una sola
+ * llamada al callback.
+ * *****************************************************************************/
+
+#include "hal_tiempo.h"
+#include "hal_sim.h"
+
+static void   (*s_cb)(void) = 0;
+static uint64_t s_periodo_us = 0;
+static uint64_t s_proximo_us = 0;
+static bool     s_pospuesto = false;
+static bool     s_habilitado = false;
+
+/* Ticks de 32768 Hz a us, redondeando */
+static uint64_t ticks_a_us(uint32_t ticks) {
+    return ((uint64_t)ticks * 1000000u + 16384u) / 32768u;
+}
+
+static void vencer(void);
+
+static void armar(uint64_t us) {
+    s_proximo_us = us;
+    hal_host_plazo(s_proximo_us, vencer);
+}
+
+static void vencer(void) {
+    uint64_t ahora = hal_sim_ahora_us();
+    uint64_t siguiente = s_pospuesto ? ahora + s_periodo_us : s_proximo_us + s_periodo_us;
+    while (siguiente <= ahora) siguiente += s_periodo_us;
+    s_pospuesto = false;
+    armar(siguiente);
+    if (s_cb) s_cb();
+}
+
+/* ========================== Reloj monotono ========================== */
+
+void hal_tiempo_iniciar_tick(hal_tiempo_info_t *out_info) {
+    if (out_info) {
+        out_info->ticks_per_us = 1u;
+        out_info->counter_bits = 32u;
+        out_info->counter_max  = 0xFFFFFFFFu;
+    }
+}
+
+uint64_t hal_tiempo_actual_tick64(void) {
+    return hal_sim_ahora_us();
+}
+
+/* ========================== Reloj periodico ========================== */
+
+void hal_tiempo_periodico_config_tick(uint32_t periodo_en_tick) {
+    hal_tiempo_periodico_enable(false);
+    s_periodo_us = ticks_a_us(periodo_en_tick);
+}
+
+void hal_tiempo_periodico_set_callback(void (*cb)()) {
+    s_cb = cb;
+}
+
+void hal_tiempo_periodico_enable(bool enable) {
+    s_habilitado = enable && s_periodo_us != 0;
+    s_pospuesto = false;
+    if (s_habilitado) armar(hal_sim_ahora_us() + s_periodo_us);
+    else              hal_host_cancelar_plazo(vencer);
+}
+
+void hal_tiempo_periodico_posponer(uint32_t ticks) {
+    if (!s_habilitado) hal_tiempo_periodico_enable(true);
+    uint64_t us = ticks_a_us(ticks);
+    if (us <= s_periodo_us || !s_habilitado) return;
+    armar(hal_sim_ahora_us() + us);
+    s_pospuesto = true;
+}
+
+void hal_tiempo_periodico_reanudar(void) {
+    if (!s_pospuesto) return;
+    armar(hal_sim_ahora_us() + s_periodo_us);
+    s_pospuesto = false;
+}
+
+void hal_tiempo_reloj_periodico_tick(uint32_t periodo_en_tick, void (*cb)()) {
+    if (periodo_en_tick == 0 || cb == 0) {
+        hal_tiempo_periodico_enable(false);
+        return;
+    }
+    hal_tiempo_periodico_set_callback(cb);
+    hal_tiempo_periodico_config_tick(periodo_en_tick);
+    hal_tiempo_periodico_enable(true);
+}
+
+bool hal_tiempo_host_periodico_activo(void) {
+    return s_habilitado;
+}
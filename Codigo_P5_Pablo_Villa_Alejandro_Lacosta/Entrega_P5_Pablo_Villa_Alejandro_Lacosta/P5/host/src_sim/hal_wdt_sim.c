@@ -0,0 +1,36 @@
+/* *****************************************************************************
+ * P.H.2025: hal_wdt_sim.c
+ *
+ * Watchdog en tiempo virtual: un plazo de hal_sim que se aplaza al
+ * alimentarlo. Si vence, la simulacion acaba con el informe y codigo 3,
+ * como el watchdog del host.
+ *
+ * Autores: Alejandro Lacosta y Pablo Villa
+ * Universidad de Zaragoza
+ * ****************************************************************************/
+
+#include "hal_wdt.h"
+#include "hal_sim.h"
+
+#define CODIGO_SALIDA_WDT  3
+
+static uint64_t s_timeout_us = 0;
+
+static void vencer(void) {
+    hal_sim_terminar("WDT vencido", CODIGO_SALIDA_WDT);
+}
+
+void hal_wdt_iniciar(uint32_t timeout_ms) {
+    s_timeout_us = (uint64_t)timeout_ms * 1000u;
+    hal_wdt_alimentar();
+}
+
+void hal_wdt_alimentar(void) {
+    if (s_timeout_us == 0) return;
+    hal_host_plazo(hal_sim_ahora_us() + s_timeout_us, vencer);
+}
+
+void hal_wdt_host_pausar(bool pausar) {
+    if (pausar) hal_host_cancelar_plazo(vencer);
+    else        hal_wdt_alimentar();
+}
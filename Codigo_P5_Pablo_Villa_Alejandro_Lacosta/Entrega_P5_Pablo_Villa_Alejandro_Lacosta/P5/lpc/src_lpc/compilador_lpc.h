@@ -0,0 +1,39 @@
+/* *****************************************************************************
+ * P.H.2025: compilador_lpc.h
+ * Extensiones de armcc que usa la HAL del LPC2105 (__irq, __nop,
+ * __disable_irq, __enable_irq), definidas para arm-none-eabi-gcc.
+ * Con armcc no hace nada: son palabras clave e intrinsecos del compilador.
+ *
+ * Las rutinas de interrupcion se declaran con __irq delante
+ * ("__irq void T0_ISR(void)"), que es la forma que aceptan los dos.
+ * *****************************************************************************/
+
+#ifndef COMPILADOR_LPC_H
+#define COMPILADOR_LPC_H
+
+#if defined(__GNUC__) && !defined(__ARMCC_VERSION)
+
+#include <stdint.h>
+
+#define __irq  __attribute__((interrupt("IRQ")))
+
+static inline void __nop(void) {
+    __asm__ volatile ("nop");
+}
+
+/* Como en armcc: sin efecto en modo usuario (el CPSR no se puede tocar) */
+static inline void __disable_irq(void) {
+    uint32_t cpsr;
+    __asm__ volatile ("mrs %0, cpsr\n\torr %0, %0, #0x80\n\tmsr cpsr_c, %0"
+                      : "=r" (cpsr) : : "memory");
+}
+
+static inline void __enable_irq(void) {
+    uint32_t cpsr;
+    __asm__ volatile ("mrs %0, cpsr\n\tbic %0, %0, #0x80\n\tmsr cpsr_c, %0"
+                      : "=r" (cpsr) : : "memory");
+}
+
+#endif
+
+#endif // COMPILADOR_LPC_H
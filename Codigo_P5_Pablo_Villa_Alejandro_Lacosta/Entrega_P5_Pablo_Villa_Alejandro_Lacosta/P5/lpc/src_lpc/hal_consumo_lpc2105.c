@@ -11,6 +11,7 @@
  * *****************************************************************************/
 
 #include <LPC210x.H>
+#include "compilador_lpc.h"
 #include "hal_consumo.h"
 
 extern void switch_to_PLL(void);
@@ -33,8 +34,24 @@ void hal_consumo_iniciar(void) {
  */
 void hal_consumo_esperar(void) {
     PCON = 0x01;   /* IDL = 1 → Idle */
-    __asm { nop }
-    __asm { nop }
+    __nop();
+    __nop();
+}
+
+/**
+ * @brief Reposo: en el LPC2105 no se puede parar el reloj sin parar los
+ * timers, así que equivale a Idle.
+ */
+void hal_consumo_reposo(void) {
+    hal_consumo_esperar();
+}
+
+/**
+ * @brief El oscilador principal da reloj a la CPU y a los timers: no se
+ * apaga por separado.
+ */
+void hal_consumo_hfclk(bool encender) {
+    (void)encender;
 }
 
 /**
@@ -57,8 +74,8 @@ void hal_consumo_dormir(void) {
 
     /* Entrar en Power-down */
     PCON = 0x02;   /* PD = 1 */
-    __asm { nop }
-    __asm { nop }
+    __nop();
+    __nop();
 
 #ifdef switch_to_PLL
     /* Reenganchar PLL tras el wake-up si se usa */
@@ -68,3 +85,17 @@ void hal_consumo_dormir(void) {
     /* Limpiar flags de EINT que pudieran haber despertado el dispositivo */
     EXTINT = (1u<<0) | (1u<<1) | (1u<<2);
 }
+
+/**
+ * @brief El power-down del LPC2105 vuelve a la instrucción siguiente: no hay
+ * arranque tras despertar y la RAM se conserva sin más.
+ */
+bool hal_consumo_despertado(void) {
+    return false;
+}
+
+void* hal_consumo_ram_retenida(uint32_t *bytes) {
+    static uint32_t s_retenida[64];
+    if (bytes) *bytes = sizeof(s_retenida);
+    return s_retenida;
+}
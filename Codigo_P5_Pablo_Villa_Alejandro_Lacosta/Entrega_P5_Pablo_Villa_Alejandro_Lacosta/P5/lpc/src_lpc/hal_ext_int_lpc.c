@@ -9,8 +9,10 @@
  * *****************************************************************************/
 
 #include <LPC210x.H>
+#include "compilador_lpc.h"
 #include <stdint.h>
 #include "hal_ext_int.h"
+#include "hal_tiempo.h"
 
 #ifndef EXTMODE
 #  define EXTMODE   (*((volatile unsigned long *)0xE01FC148))
@@ -28,43 +30,50 @@
 #define VIC_CH_EINT1 15u
 #define VIC_CH_EINT2 16u
 
-/* Callback de usuario */
-static hal_ext_int_callback_t s_cb = 0;
+/* Callback de usuario (uno de los dos segun el modo de inicio) */
+static hal_ext_int_callback_t    s_cb = 0;
+static hal_ext_int_ts_callback_t s_cb_ts = 0;
 
 /* Helpers internos */
 static inline void eint_clear_flag(unsigned bit) { EXTINT = (1u << bit); }
 static inline void vic_enable(unsigned chan)     { VICIntEnable |=  (1u << chan); }
 static inline void vic_disable(unsigned chan)    { VICIntEnClr  =   (1u << chan); }
 
+/* Sin captura hardware: la marca se toma al entrar en la ISR */
+static inline void notificar(hal_ext_int_id_t id) {
+    if (s_cb_ts)   s_cb_ts(id, hal_tiempo_actual_tick64());
+    else if (s_cb) s_cb(id);
+}
+
 /* ============================ ISRs ============================ */
 
 /**
  * @brief ISR de EINT0 (P0.16)
  */
-void EINT0_ISR(void) __irq {
+__irq void EINT0_ISR(void) {
     eint_clear_flag(0);
     vic_disable(VIC_CH_EINT0);
-    if (s_cb) s_cb(HAL_EXT_INT_0);
+    notificar(HAL_EXT_INT_0);
     VICVectAddr = 0;
 }
 
 /**
  * @brief ISR de EINT1 (P0.14)
  */
-void EINT1_ISR(void) __irq {
+__irq void EINT1_ISR(void) {
     eint_clear_flag(1);
     vic_disable(VIC_CH_EINT1);
-    if (s_cb) s_cb(HAL_EXT_INT_1);
+    notificar(HAL_EXT_INT_1);
     VICVectAddr = 0;
 }
 
 /**
  * @brief ISR de EINT2 (P0.15)
  */
-void EINT2_ISR(void) __irq {
+__irq void EINT2_ISR(void) {
     eint_clear_flag(2);
     vic_disable(VIC_CH_EINT2);
-    if (s_cb) s_cb(HAL_EXT_INT_2);
+    notificar(HAL_EXT_INT_2);
     VICVectAddr = 0;
 }
 
@@ -78,6 +87,7 @@ void EINT2_ISR(void) __irq {
  */
 void hal_ext_int_iniciar(hal_ext_int_callback_t cb){
     s_cb = cb;
+    s_cb_ts = 0;
 
     /* Configurar función EINT en pines correspondientes */
     PINSEL1 &= ~(3u << 0);  PINSEL1 |=  (1u << 0);  /* P0.16 -> EINT0 */
@@ -100,6 +110,17 @@ void hal_ext_int_iniciar(hal_ext_int_callback_t cb){
     VICVectAddr8 = (unsigned long)EINT2_ISR;  VICVectCntl8 = 0x20 | VIC_CH_EINT2;
 }
 
+/**
+ * @brief Inicializa la HAL con callback que recibe la marca de tiempo.
+ *
+ * El LPC2105 no puede capturar el flanco por hardware en un temporizador
+ * para los pines EINT, así que la marca se toma al entrar en la ISR.
+ */
+void hal_ext_int_iniciar_ts(hal_ext_int_ts_callback_t cb){
+    hal_ext_int_iniciar(0);
+    s_cb_ts = cb;
+}
+
 /**
  * @brief Habilita la interrupción externa indicada.
  */
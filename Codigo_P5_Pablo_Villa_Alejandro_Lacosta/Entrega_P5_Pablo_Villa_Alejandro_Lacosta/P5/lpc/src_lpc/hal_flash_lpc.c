@@ -0,0 +1,49 @@
+/* *****************************************************************************
+ * P.H.2025: Flash de datos en LPC2105 (simulador)
+ * Implementacion para cumplir el hal_flash.h
+ *
+ * - El simulador no emula la programacion por IAP: las paginas viven en
+ *   RAM y se pierden al reiniciar, pero se comportan como la flash real
+ *   (borrado a 1, escritura que solo baja bits) para que svc_kv funcione y
+ *   se pueda probar igual que en la placa.
+ * - Paginas pequenas (512 bytes) para que la compactacion se ejercite
+ *   enseguida.
+ * *****************************************************************************/
+
+#include "hal_flash.h"
+
+#define PALABRAS_PAGINA  128u
+
+static uint32_t s_paginas[HAL_FLASH_PAGINAS][PALABRAS_PAGINA];
+
+void hal_flash_iniciar(void) {
+    static bool s_iniciada = false;
+    if (s_iniciada) return;
+    s_iniciada = true;
+
+    // Flash "de fabrica": todo borrado
+    for (uint8_t p = 0; p < HAL_FLASH_PAGINAS; p++)
+        for (uint32_t i = 0; i < PALABRAS_PAGINA; i++)
+            s_paginas[p][i] = HAL_FLASH_BORRADO;
+}
+
+uint32_t hal_flash_palabras_pagina(void) {
+    return PALABRAS_PAGINA;
+}
+
+const uint32_t* hal_flash_pagina(uint8_t pagina) {
+    return (pagina < HAL_FLASH_PAGINAS) ? s_paginas[pagina] : 0;
+}
+
+void hal_flash_escribir(uint8_t pagina, uint32_t offset, const uint32_t *datos, uint32_t n) {
+    if (pagina >= HAL_FLASH_PAGINAS || offset + n > PALABRAS_PAGINA) return;
+    for (uint32_t i = 0; i < n; i++)
+        s_paginas[pagina][offset + i] &= datos[i];      // solo 1 -> 0
+}
+
+bool hal_flash_borrar_paso(uint8_t pagina) {
+    if (pagina >= HAL_FLASH_PAGINAS) return true;
+    for (uint32_t i = 0; i < PALABRAS_PAGINA; i++)
+        s_paginas[pagina][i] = HAL_FLASH_BORRADO;
+    return true;
+}
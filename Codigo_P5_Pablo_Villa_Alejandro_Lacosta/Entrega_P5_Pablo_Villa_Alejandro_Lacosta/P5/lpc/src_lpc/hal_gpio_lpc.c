@@ -7,6 +7,7 @@
 #include <LPC210x.H>
 #include "board_lpc.h" 
 #include "hal_gpio.h"
+#include "hal_SC.h"
 
 /**
  * @brief Inicializa el módulo GPIO.
@@ -77,3 +78,35 @@ void hal_gpio_escribir(HAL_GPIO_PIN_T gpio, uint32_t valor)
     if ((valor & 0x01) == 0) IOCLR = masc;  /* Poner bajo */
     else                     IOSET = masc;  /* Poner alto */
 }
+
+/**
+ * @brief Lee el puerto completo en un solo acceso.
+ * @param puerto Índice de puerto (el LPC2105 solo tiene P0)
+ * @return Valor de IOPIN
+ */
+uint32_t hal_gpio_leer_puerto(uint32_t puerto)
+{
+    (void)puerto;
+    return IOPIN;
+}
+
+/**
+ * @brief Sube y baja varios pines del puerto en una sola escritura.
+ *        Si solo hay que subir o solo bajar basta con IOSET/IOCLR; si hay de
+ *        los dos se escribe IOPIN (lectura-modificacion-escritura protegida
+ *        frente a interrupciones que toquen otros pines).
+ * @param puerto Índice de puerto (el LPC2105 solo tiene P0)
+ * @param alto Pines a nivel alto
+ * @param bajo Pines a nivel bajo
+ */
+void hal_gpio_escribir_puerto(uint32_t puerto, uint32_t alto, uint32_t bajo)
+{
+    (void)puerto;
+    if (bajo == 0)      IOSET = alto;
+    else if (alto == 0) IOCLR = bajo;
+    else {
+        hal_sc_entrar();
+        IOPIN = (IOPIN & ~(alto | bajo)) | alto;
+        hal_sc_salir();
+    }
+}
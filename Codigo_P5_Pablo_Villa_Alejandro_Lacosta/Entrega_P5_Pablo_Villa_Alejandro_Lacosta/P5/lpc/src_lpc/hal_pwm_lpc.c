@@ -0,0 +1,169 @@
+/* *****************************************************************************
+ * P.H.2025: PWM por software en LPC2105 (Timer1, match MR1)
+ * Implementacion para cumplir el hal_pwm.h
+ *
+ * - Periodo de PERIODO_US. Al empezar cada periodo se encienden los canales
+ *   con nivel intermedio y se programa MR1 en el siguiente flanco de bajada;
+ *   en cada interrupcion se apagan los que ya han cumplido su tiempo.
+ * - Los fundidos avanzan un escalon por periodo dentro de la propia ISR.
+ * - Los niveles 0 y maximo se escriben una vez en el GPIO: si ningun canal
+ *   queda con nivel intermedio ni fundido en curso, se desarma MR1 y no hay
+ *   mas interrupciones.
+ * - Timer1 sigue corriendo libre a 1 MHz para hal_tiempo (MR0 intacto).
+ * *****************************************************************************/
+
+#include <LPC210x.H>
+#include "hal_pwm.h"
+#include "hal_SC.h"
+
+#define PERIODO_US   5000u     // 200 Hz, sin parpadeo visible
+#define MARGEN_US    20u       // minimo hasta el siguiente match
+
+/* hal_tiempo_lpc.c */
+void hal_tiempo_lpc_match1(void (*cb)(void), uint32_t instante);
+
+typedef struct {
+    uint32_t mascara;          // bit del pin en IOPIN
+    uint8_t  nivel;            // nivel actual
+    uint8_t  desde, hasta;     // fundido en curso
+    uint32_t periodos, k;      // duracion y avance del fundido (periodos)
+} canal_t;
+
+static canal_t  s_canal[HAL_PWM_CANALES];
+static uint8_t  s_num = 0;
+static uint32_t s_activo_alto;
+static uint8_t  s_activos = 0;          // canales en manos del PWM
+static uint32_t s_inicio;               // T1TC al empezar el periodo
+static uint8_t  s_en_marcha = 0;
+
+static void pwm_isr(void);
+
+static void escribir_pin(const canal_t *c, uint32_t encendido) {
+    if ((encendido != 0) == (s_activo_alto != 0)) IOSET = c->mascara;
+    else                                          IOCLR = c->mascara;
+}
+
+static uint32_t tiempo_encendido(uint8_t nivel) {
+    return ((uint32_t)nivel * PERIODO_US) / HAL_PWM_NIVEL_MAX;
+}
+
+static int intermedio(const canal_t *c) {
+    return c->nivel != 0 && c->nivel != HAL_PWM_NIVEL_MAX;
+}
+
+static int fundiendo(const canal_t *c) {
+    return c->k < c->periodos;
+}
+
+static void programar(uint32_t instante) {
+    if ((int32_t)(instante - T1TC) < (int32_t)MARGEN_US) instante = T1TC + MARGEN_US;
+    hal_tiempo_lpc_match1(pwm_isr, instante);
+}
+
+/* Principio de periodo: avanza fundidos y fija el nivel de partida de cada pin.
+ * Devuelve si hace falta seguir generando interrupciones. */
+static int empezar_periodo(void) {
+    int seguir = 0;
+    for (uint8_t i = 0; i < s_num; i++) {
+        canal_t *c = &s_canal[i];
+        if (!(s_activos & (1u << i))) continue;
+
+        if (fundiendo(c)) {
+            c->k++;
+            int32_t delta = (int32_t)c->hasta - (int32_t)c->desde;
+            c->nivel = (uint8_t)((int32_t)c->desde + delta * (int32_t)c->k / (int32_t)c->periodos);
+            seguir = 1;
+        }
+        escribir_pin(c, c->nivel != 0);
+        if (intermedio(c)) seguir = 1;
+    }
+    return seguir;
+}
+
+/* Interrupcion de MR1: apaga los canales vencidos y programa el siguiente flanco. */
+static void pwm_isr(void) {
+    uint32_t transcurrido = T1TC - s_inicio;
+
+    if (transcurrido >= PERIODO_US) {
+        s_inicio += PERIODO_US;
+        if (T1TC - s_inicio >= PERIODO_US) s_inicio = T1TC;   // muy tarde: resincroniza
+        if (!empezar_periodo()) {
+            s_en_marcha = 0;
+            hal_tiempo_lpc_match1(0, 0);
+            return;
+        }
+        transcurrido = T1TC - s_inicio;
+    }
+
+    uint32_t siguiente = PERIODO_US;
+    for (uint8_t i = 0; i < s_num; i++) {
+        canal_t *c = &s_canal[i];
+        if (!(s_activos & (1u << i)) || !intermedio(c)) continue;
+
+        uint32_t t_on = tiempo_encendido(c->nivel);
+        if (transcurrido >= t_on)  escribir_pin(c, 0);
+        else if (t_on < siguiente) siguiente = t_on;
+    }
+    programar(s_inicio + siguiente);
+}
+
+/* Con la seccion critica tomada: arranca el PWM si estaba parado. */
+static void arrancar(void) {
+    if (s_en_marcha) {
+        return;
+    }
+    if (empezar_periodo()) {
+        s_en_marcha = 1;
+        s_inicio = T1TC;
+        pwm_isr();
+    }
+}
+
+void hal_pwm_iniciar(const HAL_GPIO_PIN_T pines[], uint8_t num, uint32_t activo_alto) {
+    hal_tiempo_lpc_match1(0, 0);
+    s_en_marcha = 0;
+    s_activos = 0;
+    s_num = (num > HAL_PWM_CANALES) ? HAL_PWM_CANALES : num;
+    s_activo_alto = activo_alto;
+
+    for (uint8_t i = 0; i < s_num; i++) {
+        s_canal[i].mascara  = 1UL << pines[i];
+        s_canal[i].nivel    = 0;
+        s_canal[i].periodos = 0;
+        s_canal[i].k        = 0;
+    }
+}
+
+void hal_pwm_nivel(uint8_t canal, uint8_t nivel) {
+    hal_pwm_rampa(canal, nivel, nivel, 0);
+}
+
+void hal_pwm_rampa(uint8_t canal, uint8_t desde, uint8_t hasta, uint32_t ms) {
+    if (canal >= s_num) return;
+    canal_t *c = &s_canal[canal];
+
+    hal_sc_entrar();
+    s_activos |= (uint8_t)(1u << canal);
+    c->desde    = desde;
+    c->hasta    = hasta;
+    c->periodos = (ms * 1000u) / PERIODO_US;
+    c->k        = 0;
+    c->nivel    = (c->periodos == 0) ? hasta : desde;
+    if (s_en_marcha) escribir_pin(c, c->nivel != 0);   // el resto lo hace la ISR
+    else             arrancar();
+    hal_sc_salir();
+}
+
+void hal_pwm_soltar(uint8_t canal) {
+    if (canal >= s_num) return;
+
+    hal_sc_entrar();
+    s_activos &= (uint8_t)~(1u << canal);
+    s_canal[canal].periodos = 0;
+    s_canal[canal].k = 0;
+    if (s_activos == 0 && s_en_marcha) {
+        s_en_marcha = 0;
+        hal_tiempo_lpc_match1(0, 0);
+    }
+    hal_sc_salir();
+}
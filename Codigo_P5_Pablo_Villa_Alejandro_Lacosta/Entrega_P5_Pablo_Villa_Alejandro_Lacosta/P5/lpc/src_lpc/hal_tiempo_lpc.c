@@ -6,6 +6,7 @@
  * ****************************************************************************/
 
 #include <LPC210x.H>
+#include "compilador_lpc.h"
 #include "hal_tiempo.h"
 
 #define PCLK_MHZ   15u
@@ -15,14 +16,33 @@
 
 static volatile uint32_t s_overflows_t1 = 0;  // cuenta wraps por MR0
 static hal_tiempo_info_t s_info;
+static void (*s_cb_mr1)(void) = 0;            // PWM software (hal_pwm_lpc.c)
 
-/* IRQ de Timer1: se dispara al llegar a MR0 y resetea el contador */
-void T1_ISR(void) __irq {
-    T1IR = 1u;          // clear MR0
-    s_overflows_t1++;
+/* IRQ de Timer1: MR0 al desbordar (resetea el contador); MR1 lo usa el PWM */
+__irq void T1_ISR(void) {
+    if (T1IR & 2u) {
+        T1IR = 2u;      // clear MR1
+        if (s_cb_mr1) s_cb_mr1();
+    }
+    if (T1IR & 1u) {
+        T1IR = 1u;      // clear MR0
+        s_overflows_t1++;
+    }
     VICVectAddr = 0;    // ack VIC
 }
 
+/* Uso interno de la HAL LPC: interrupcion unica cuando T1TC llegue a
+ * 'instante' (us). cb = 0 la desarma. No toca MR0 ni el contador. */
+void hal_tiempo_lpc_match1(void (*cb)(void), uint32_t instante) {
+    s_cb_mr1 = cb;
+    if (cb == 0) {
+        T1MCR &= ~(1u<<3);                              // MR1I off
+        return;
+    }
+    T1MR1 = instante;
+    T1MCR |= (1u<<3);                                   // MR1I
+}
+
 void hal_tiempo_iniciar_tick(hal_tiempo_info_t *out_info) {
     // Timer1 a 1 MHz: 1 tick = 1 s
     T1TCR = 2;                                         // reset
@@ -63,8 +83,15 @@ uint64_t hal_tiempo_actual_tick64(void) {
 /* ========================== Reloj peridico (Timer0) ========================== */
 
 static void (*s_cb)(void) = 0;   // callback peridico
-
-void T0_ISR(void) __irq {
+static uint32_t s_periodo = 0;   // periodo en ticks de 32768 Hz
+static volatile bool s_pospuesto = false;
+static bool s_habilitado = false;
+
+__irq void T0_ISR(void) {
+    if (s_pospuesto) {           // disparo pospuesto: vuelve al periodo
+        T0MR0 = s_periodo - 1u;
+        s_pospuesto = false;
+    }
     if (s_cb) s_cb();
     T0IR = 1u;         // clear MR0
     VICVectAddr = 0;   // ack VIC
@@ -80,6 +107,8 @@ void hal_tiempo_periodico_config_tick(uint32_t periodo_en_tick) {
 
     // Match en ticks RTC
     T0MR0 = periodo_en_tick - 1u;
+    s_periodo = periodo_en_tick;
+    s_pospuesto = false;
     T0MCR = (1u<<0) /*MR0I*/ | (1u<<1) /*MR0R*/;   // int + reset
 
     // VIC para TIMER0 (fuente 4)
@@ -93,6 +122,11 @@ void hal_tiempo_periodico_set_callback(void (*cb)(void)) {
 }
 
 void hal_tiempo_periodico_enable(bool enable) {
+    s_habilitado = enable;
+    if (s_pospuesto) {
+        T0MR0 = s_periodo - 1u;
+        s_pospuesto = false;
+    }
     if (enable) {
         VICIntEnable |= (1u << 4);  // habilita IRQ T0
         T0TCR = 2;                  // reset
@@ -104,6 +138,26 @@ void hal_tiempo_periodico_enable(bool enable) {
     }
 }
 
+/* Pospone el siguiente disparo a 'ticks' desde ahora; la ISR de ese
+ * disparo vuelve a cargar el periodo */
+void hal_tiempo_periodico_posponer(uint32_t ticks) {
+    if (!s_habilitado) hal_tiempo_periodico_enable(true);
+    if (ticks <= s_periodo) return;
+    T0MR0 = ticks - 1u;
+    T0TCR = 2;                  // reset
+    T0TCR = 1;                  // start
+    s_pospuesto = true;
+}
+
+/* Anula un disparo pospuesto: el siguiente llega un periodo despus */
+void hal_tiempo_periodico_reanudar(void) {
+    if (!s_pospuesto) return;
+    T0MR0 = s_periodo - 1u;
+    T0TCR = 2;
+    T0TCR = 1;
+    s_pospuesto = false;
+}
+
 /* Wrapper con la misma semntica que en nRF */
 void hal_tiempo_reloj_periodico_tick(uint32_t periodo_en_tick, void (*cb)(void)) {
     if (periodo_en_tick == 0 || cb == 0) {
@@ -9,9 +9,12 @@
  *  - FIFO habilitado y reiniciado
  *
  * Funciones básicas de inicialización y envío de caracteres.
+ * Recepción (RBR) y transmisión (THRE) por interrupción, vectorizadas
+ * en el slot 2 del VIC.
  * *****************************************************************************/
 
 #include <LPC210x.H>
+#include "compilador_lpc.h"
 #include "hal_uart.h"
 #include <stdint.h>
 
@@ -23,6 +26,17 @@
 #define UART_BAUD 115200u            /* Baudrate por defecto */
 #endif
 
+#define VIC_CH_UART1 7u              /* Fuente VIC de UART1 */
+
+#define UART1_FIFO_TX 16u             /* Profundidad del FIFO de transmisión */
+
+#define PCONP_UART1   (1u << 4)       /* Bit PCUART1 de PCONP */
+
+/* Callbacks de recepción y transmisión */
+static hal_uart_rx_callback_t s_rx_cb = 0;
+static hal_uart_tx_callback_t s_tx_cb = 0;
+static volatile bool s_tx_ocupada = false;
+
 /**
  * @brief Configura los pines P0.8 y P0.9 para UART1 (TXD1/RXD1)
  */
@@ -61,6 +75,20 @@ void hal_uart_init(void) {
     U1LCR = 0x03;                 /* 8N1, DLAB=0 */
 }
 
+/**
+ * @brief Enciende o apaga UART1 en PCONP (los registros se conservan).
+ *
+ * Antes de apagar se espera a TEMT para no cortar el último carácter.
+ */
+void hal_uart_alimentar(bool encender) {
+    if (encender) {
+        PCONP |= PCONP_UART1;
+    } else {
+        while ((U1LSR & (1u << 6)) == 0) { }
+        PCONP &= ~PCONP_UART1;
+    }
+}
+
 /**
  * @brief Envía un carácter por UART1.
  *
@@ -82,3 +110,104 @@ int hal_uart_sendchar(char ch) {
     U1THR = (uint8_t)ch;
     return 0;
 }
+
+/**
+ * @brief Rellena el FIFO de transmisión (16 bytes) desde el callback.
+ *
+ * Como hal_uart_sendchar, convierte '\n' en '\r\n': los bytes se piden de
+ * uno en uno mientras quepan dos en el FIFO.
+ */
+static void uart1_tx_rellenar(void) {
+    uint32_t libres = UART1_FIFO_TX;
+    uint32_t n = 0;
+    uint8_t b;
+    while (libres >= 2u && s_tx_cb && s_tx_cb(&b, 1) == 1u) {
+        if (b == '\n') {
+            U1THR = '\r';
+            libres--;
+        }
+        U1THR = b;
+        libres--;
+        n++;
+    }
+    s_tx_ocupada = (n > 0);
+}
+
+/**
+ * @brief ISR de UART1: atiende recepción (RDA/CTI) y THR vacío (THRE).
+ */
+__irq void UART1_ISR(void) {
+    uint32_t iir;
+    while (((iir = U1IIR) & 0x01u) == 0) {    /* bit0 = 0 -> interrupción pendiente */
+        switch ((iir >> 1) & 0x07u) {
+            case 0x02:                        /* RDA: datos disponibles */
+            case 0x06:                        /* CTI: timeout de carácter */
+                while (U1LSR & 0x01u) {       /* LSR bit0 = RDR */
+                    char c = (char)U1RBR;
+                    if (s_rx_cb) s_rx_cb(c);
+                }
+                break;
+            case 0x01:                        /* THRE: leer IIR ya la reconoce */
+                uart1_tx_rellenar();
+                break;
+            default:                          /* RLS: limpiar leyendo LSR */
+                (void)U1LSR;
+                break;
+        }
+    }
+    VICVectAddr = 0;
+}
+
+/**
+ * @brief Vectoriza la ISR de UART1 en el VIC (compartida por RX y TX).
+ */
+static void uart1_vic_configurar(void) {
+    VICVectAddr2 = (unsigned long)UART1_ISR;
+    VICVectCntl2 = 0x20 | VIC_CH_UART1;
+    VICIntEnable |= (1u << VIC_CH_UART1);
+}
+
+/**
+ * @brief Habilita la recepción por interrupción de UART1.
+ * @param cb Callback que recibe cada carácter (contexto de ISR)
+ */
+void hal_uart_rx_iniciar(hal_uart_rx_callback_t cb) {
+    s_rx_cb = cb;
+
+    U1FCR = 0x01;                             /* FIFO, trigger RX a 1 byte */
+    U1IER |= 0x01u;                           /* Interrupción RBR */
+    uart1_vic_configurar();
+}
+
+/**
+ * @brief Habilita la transmisión por interrupción de UART1 (THRE).
+ * @param cb Callback que entrega los bytes a enviar (contexto de ISR)
+ */
+void hal_uart_tx_iniciar(hal_uart_tx_callback_t cb) {
+    s_tx_cb = cb;
+    s_tx_ocupada = false;
+
+    U1IER |= 0x02u;                           /* Interrupción THRE */
+    uart1_vic_configurar();
+}
+
+/**
+ * @brief Arranca la transmisión si el transmisor está parado.
+ *
+ * La interrupción se enmascara en el VIC durante la comprobación para no
+ * competir con la ISR por el estado de ocupación.
+ */
+void hal_uart_tx_arrancar(void) {
+    VICIntEnClr = (1u << VIC_CH_UART1);
+    if (!s_tx_ocupada && (U1LSR & (1u << 5))) {
+        uart1_tx_rellenar();
+    }
+    VICIntEnable = (1u << VIC_CH_UART1);
+}
+
+/**
+ * @brief Indica si queda una transmisión en curso (FIFO o registro de desplazamiento).
+ */
+bool hal_uart_tx_ocupada(void) {
+    return s_tx_ocupada || ((U1LSR & (1u << 6)) == 0);   /* LSR bit6 = TEMT */
+}
@@ -10,6 +10,7 @@
 
 #include "hal_wdt.h"
 #include <LPC210x.H>
+#include "compilador_lpc.h"
 
 /* Bits del registro WDMOD */
 #define WDEN_BIT     (1u<<0)  /* Habilita WDT */
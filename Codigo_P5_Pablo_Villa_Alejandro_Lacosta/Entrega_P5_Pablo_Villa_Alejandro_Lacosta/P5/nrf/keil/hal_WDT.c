@@ -1,6 +0,0 @@
-
-
-/*iniciar*/
-
-/*dar_comer*/
-
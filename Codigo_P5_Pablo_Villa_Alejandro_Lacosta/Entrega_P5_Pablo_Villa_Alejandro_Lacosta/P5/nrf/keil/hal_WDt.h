@@ -1,34 +0,0 @@
-/******************************************************************************
- * Fichero: hal_wdt.h
- * Proyecto: Prcticas P.H. 2025
- *
- * Descripcin:
- *   Interfaz hardware del Watchdog Timer. Define las funciones de bajo nivel
- *   para configurar el WDT y para alimentarlo peridicamente desde el software.
- *
- * Autores:
- * Alejandro Lacosta 
- * Pablo Villa
- * Universidad de Zaragoza
- *
- *****************************************************************************/
-
-#ifndef HAL_WDT_H
-#define HAL_WDT_H
-
-#include <stdint.h>
-
-/**
- * @brief Configura e inicia el Watchdog Timer.
- * @param timeout_ms Tiempo en milisegundos antes de provocar un reinicio
- *                   si no es alimentado.
- */
-void hal_wdt_iniciar(uint32_t timeout_ms);
-
-/**
- * @brief Alimenta al Watchdog (reinicia su contador de cuenta atrs).
- * Debe llamarse peridicamente para evitar que expire.
- */
-void hal_wdt_alimentar(void);
-
-#endif
@@ -1,34 +0,0 @@
-#ifndef SVC_GE_H
-#define SVC_GE_H
-
-#include <stdint.h>
-#include <stdbool.h>
-#include "rt_evento.h"
-#include "hal_tiempo.h"
-
-// Nmero mximo de suscripciones activas (no por evento, sino total)
-#define rt_GE_MAX_SUSCRITOS 4
-
-// Tipo de funcin callback asociada a un evento
-typedef void (*SVC_CALLBACK_T)(EVENTO_T, uint32_t);
-
-// Estructura de suscripcin
-typedef struct {
-    bool activa;           // Indica si esta entrada est en uso
-    EVENTO_T evento;       // Qu evento escucha
-    uint8_t prioridad;     // Prioridad (0 = ms alta)
-    SVC_CALLBACK_T f_callback; // Funcin asociada al evento
-} Suscripcion_t;
-
-// ?? Declaracin global para que rt_GE.c pueda acceder a la tabla
-extern Suscripcion_t s_tabla[rt_GE_MAX_SUSCRITOS];
-
-// ===================== Funciones pblicas =====================
-
-// Suscribe una funcin callback a un evento con prioridad
-void svc_GE_suscribir(EVENTO_T ID_evento, uint8_t prioridad, SVC_CALLBACK_T f_callback);
-
-// Elimina una suscripcin existente y compacta la lista
-void svc_GE_cancelar(EVENTO_T ID_evento, SVC_CALLBACK_T f_callback);
-
-#endif  // SVC_GE_H
\ No newline at end of file
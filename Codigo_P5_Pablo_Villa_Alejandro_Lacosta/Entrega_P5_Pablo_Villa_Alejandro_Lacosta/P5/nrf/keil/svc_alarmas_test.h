@@ -1,12 +0,0 @@
-#ifndef SVC_ALARMAS_TEST_H
-#define SVC_ALARMAS_TEST_H
-
-#include <stdint.h>
-#include <stdbool.h>
-
-/**
- * @brief Inicia los tests del servicio de alarmas
- */
-void svc_alarmas_test_iniciar(void);
-
-#endif
@@ -48,4 +48,12 @@
 #define BUTTONS_LIST { BUTTON_1 }
 #endif //botonos
 
+//FLASH DE DATOS (svc_kv): dos paginas de 4 KB, justo debajo del bootloader (0xE0000)
+#define FLASH_DATOS_INICIO 0x000DE000
+
+//RAM RETENIDA en SYSTEM OFF (svc_instantanea): ultimos 256 bytes de la RAM,
+//fuera de IRAM1 en el proyecto Keil
+#define RAM_RETENIDA_INICIO 0x2003FF00
+#define RAM_RETENIDA_BYTES  256
+
 #endif
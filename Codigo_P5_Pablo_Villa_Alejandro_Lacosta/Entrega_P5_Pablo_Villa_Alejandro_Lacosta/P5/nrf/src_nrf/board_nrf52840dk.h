@@ -42,4 +42,12 @@
 
 #define MONITOR_LIST {MONITOR1, MONITOR2, MONITOR3, MONITOR4}
 
+//FLASH DE DATOS (svc_kv): dos paginas de 4 KB, ultimas dos paginas de la flash
+#define FLASH_DATOS_INICIO 0x000FE000
+
+//RAM RETENIDA en SYSTEM OFF (svc_instantanea): ultimos 256 bytes de la RAM,
+//fuera de IRAM1 en el proyecto Keil
+#define RAM_RETENIDA_INICIO 0x2003FF00
+#define RAM_RETENIDA_BYTES  256
+
 #endif
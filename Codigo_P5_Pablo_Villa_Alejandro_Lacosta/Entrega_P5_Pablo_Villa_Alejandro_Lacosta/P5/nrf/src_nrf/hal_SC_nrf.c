@@ -8,7 +8,7 @@
  * ****************************************************************************/
 
 
-#include "hal_sc.h"
+#include "hal_SC.h"
 #include "nrf.h"  
 
 static uint32_t saved_primask = 0;
@@ -15,6 +15,7 @@
  
 #include <nrf.h>
 #include "hal_consumo.h"
+#include "board.h"
 
 /* Inicializa el m?dulo de consumo */
 void hal_consumo_iniciar(void) {}
@@ -24,8 +25,40 @@ void hal_consumo_esperar(void) {
     __WFI();
 }
 
+/* Cristal de alta frecuencia bajo demanda (dominio DRV_DOMINIO_HFCLK) */
+void hal_consumo_hfclk(bool encender) {
+    if (encender) NRF_CLOCK->TASKS_HFCLKSTART = 1;
+    else          NRF_CLOCK->TASKS_HFCLKSTOP = 1;
+}
+
+/* System ON de bajo consumo: se suelta el HFCLK (el RTC sigue con el
+ * LFCLK) y se duerme con __WFI. Si el cristal estaba pedido, al despertar
+ * se vuelve a pedir y se espera a que arranque (~0.3 ms) para la UART. */
+void hal_consumo_reposo(void) {
+    bool cristal = (NRF_CLOCK->HFCLKSTAT & CLOCK_HFCLKSTAT_STATE_Msk) != 0;
+    NRF_POWER->TASKS_LOWPWR = 1;
+    if (cristal) NRF_CLOCK->TASKS_HFCLKSTOP = 1;
+    __WFI();
+    if (!cristal) return;
+    NRF_CLOCK->EVENTS_HFCLKSTARTED = 0;
+    NRF_CLOCK->TASKS_HFCLKSTART = 1;
+    while (NRF_CLOCK->EVENTS_HFCLKSTARTED == 0) { }
+}
+
+/* Marca para retencin la seccin de RAM que contiene 'dir'.
+ * RAM0..RAM7: dos secciones de 4 KB; RAM8: seis secciones de 32 KB. */
+static void retener_ram(uint32_t dir) {
+    uint32_t off = dir - 0x20000000u;
+    if (off < 0x10000u)
+        NRF_POWER->RAM[off / 0x2000u].POWERSET = 1u << (16u + (off / 0x1000u) % 2u);
+    else
+        NRF_POWER->RAM[8].POWERSET = 1u << (16u + (off - 0x10000u) / 0x8000u);
+}
+
 /* Pone el micro en modo sue?o profundo (SYSTEMOFF), funcion no retorna */
 void hal_consumo_dormir(void) {	
+	// La instantanea de svc_instantanea sobrevive al SYSTEM OFF
+	retener_ram(RAM_RETENIDA_INICIO);
 	// Evento que ha de suceder para que despierte
 	NRF_POWER->SYSTEMOFF = POWER_SYSTEMOFF_SYSTEMOFF_Enter;
 	//solo sale por reset o SENSE GPIO si esta programado
@@ -33,3 +66,22 @@ void hal_consumo_dormir(void) {
 		__WFE(); // para los eventos del debug!!
 	}
 }
+
+/* Despertar de SYSTEM OFF = reset con RESETREAS.OFF. Los bits se acumulan
+ * hasta que se escriben: se limpian para que el siguiente arranque no
+ * herede la causa. */
+bool hal_consumo_despertado(void) {
+    static int8_t s_despertado = -1;
+    if (s_despertado < 0) {
+        uint32_t causa = NRF_POWER->RESETREAS;
+        NRF_POWER->RESETREAS = causa;
+        s_despertado = (causa & POWER_RESETREAS_OFF_Msk) ? 1 : 0;
+    }
+    return s_despertado == 1;
+}
+
+/* RAM reservada por el proyecto (IRAM1 acaba antes de RAM_RETENIDA_INICIO) */
+void* hal_consumo_ram_retenida(uint32_t *bytes) {
+    if (bytes) *bytes = RAM_RETENIDA_BYTES;
+    return (void*)RAM_RETENIDA_INICIO;
+}
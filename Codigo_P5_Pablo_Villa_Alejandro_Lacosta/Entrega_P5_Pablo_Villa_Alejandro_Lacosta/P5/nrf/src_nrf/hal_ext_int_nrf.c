@@ -12,18 +12,60 @@
  *
  * - El callback registrado por el usuario se ejecuta cuando ocurre una 
  * interrupci�n en cualquiera de los pines definidos.
+ *
+ * - Con hal_ext_int_iniciar_ts() cada EVENTS_IN[i] dispara por PPI la tarea
+ * CAPTURE[i] de un TIMER a 1 MHz y, por el FORK del mismo canal, su
+ * START. El TIMER esta parado y a cero mientras se espera el flanco (no
+ * mantiene HFINT/PCLK1M encendidos en los reposos): el flanco lo arranca
+ * y la ISR captura "ahora" en CC[4], traduce la diferencia a la base de
+ * hal_tiempo y lo vuelve a parar. Deshabilitar una linea quita tambien su
+ * canal PPI, para que los rebotes no lo rearranquen.
  * * *****************************************************************************
  */
 
 #include "hal_ext_int.h"
+#include "hal_tiempo.h"
 #include "nrf.h"
 #include <stdbool.h>
 
 #define EXT_INT_NUMBER  4
 
+// Captura de flancos: TIMER3 (6 registros CC) y canales PPI 0..3
+#define TS_TIMER        NRF_TIMER3
+#define TS_CC_AHORA     4              // CC usado para leer el instante actual
+#define TS_PPI_CANAL0   0
+#define TS_PRESCALER    4              // 16 MHz / 2^4 = 1 MHz -> 1 tick = 1 us
+
 static const uint32_t pines_irq[EXT_INT_NUMBER] = {11, 12, 24, 25};
 
 static hal_ext_int_callback_t cb_usuario = 0;
+static hal_ext_int_ts_callback_t cb_usuario_ts = 0;
+static bool captura_ts = false;
+
+/**
+ * @brief Traduce la captura hardware del canal i a la base de hal_tiempo.
+ *
+ * Se captura "ahora" en el mismo TIMER para medir cuanto hace que se
+ * produjo el flanco, y se resta al reloj del sistema. Si el flanco llego
+ * justo cuando la ISR anterior paraba el TIMER, su captura es de antes de
+ * ponerlo a cero: se usa "ahora".
+ */
+static uint64_t instante_flanco(uint8_t i)
+{
+    TS_TIMER->TASKS_CAPTURE[TS_CC_AHORA] = 1;
+    uint64_t ahora_us = hal_tiempo_actual_tick64();
+    uint32_t cc_ahora = TS_TIMER->CC[TS_CC_AHORA];
+    uint32_t cc_flanco = TS_TIMER->CC[i];
+    if (cc_flanco > cc_ahora) return ahora_us;
+    uint32_t retraso = cc_ahora - cc_flanco;
+    return (retraso < ahora_us) ? ahora_us - retraso : 0;
+}
+
+static void parar_timer(void)
+{
+    TS_TIMER->TASKS_STOP  = 1;
+    TS_TIMER->TASKS_CLEAR = 1;
+}
 
 /**
  * @brief Rutina de servicio de interrupciones (ISR) del perif�rico GPIOTE.
@@ -38,12 +80,17 @@ void GPIOTE_IRQHandler(void)
             
             hal_ext_int_deshabilitar((hal_ext_int_id_t)i);
             
-            if (cb_usuario) {
+            if (cb_usuario_ts) {
+                cb_usuario_ts((hal_ext_int_id_t)i, instante_flanco(i));
+            } else if (cb_usuario) {
                 cb_usuario((hal_ext_int_id_t)i);
             }
         }
     }
     NRF_GPIOTE->EVENTS_PORT = 0;
+
+    // Hasta el siguiente flanco no hace falta el TIMER
+    if (captura_ts) parar_timer();
 }
 
 /**
@@ -52,6 +99,8 @@ void GPIOTE_IRQHandler(void)
 void hal_ext_int_iniciar(hal_ext_int_callback_t cb)
 {
     cb_usuario = cb;
+    cb_usuario_ts = 0;
+    captura_ts = false;
 
     // 1. Configurar los pines como entrada con Pull-Up
     for (uint8_t i = 0; i < EXT_INT_NUMBER; i++) {
@@ -82,6 +131,34 @@ void hal_ext_int_iniciar(hal_ext_int_callback_t cb)
     NVIC_EnableIRQ(GPIOTE_IRQn);
 }
 
+/**
+ * @brief Inicializa GPIOTE con captura hardware del instante del flanco.
+ *
+ * Ademas de la configuracion normal, prepara TS_TIMER a 1 MHz (parado) y
+ * une por PPI EVENTS_IN[i] -> TASKS_CAPTURE[i] y TASKS_START.
+ */
+void hal_ext_int_iniciar_ts(hal_ext_int_ts_callback_t cb)
+{
+    hal_ext_int_iniciar(0);
+
+    parar_timer();
+    TS_TIMER->MODE      = TIMER_MODE_MODE_Timer << TIMER_MODE_MODE_Pos;
+    TS_TIMER->BITMODE   = TIMER_BITMODE_BITMODE_32Bit << TIMER_BITMODE_BITMODE_Pos;
+    TS_TIMER->PRESCALER = TS_PRESCALER;
+    TS_TIMER->SHORTS    = 0;
+    TS_TIMER->INTENCLR  = 0xFFFFFFFFu;   // solo captura, sin interrupciones
+
+    for (uint8_t i = 0; i < EXT_INT_NUMBER; i++) {
+        NRF_PPI->CH[TS_PPI_CANAL0 + i].EEP = (uint32_t)&NRF_GPIOTE->EVENTS_IN[i];
+        NRF_PPI->CH[TS_PPI_CANAL0 + i].TEP = (uint32_t)&TS_TIMER->TASKS_CAPTURE[i];
+        NRF_PPI->FORK[TS_PPI_CANAL0 + i].TEP = (uint32_t)&TS_TIMER->TASKS_START;
+        NRF_PPI->CHENSET = 1u << (TS_PPI_CANAL0 + i);
+    }
+
+    cb_usuario_ts = cb;
+    captura_ts = true;
+}
+
 /**
  * @brief Habilita la interrupci�n externa correspondiente a un pin/canal.
  *
@@ -91,6 +168,7 @@ void hal_ext_int_habilitar(hal_ext_int_id_t id){
     if (id < EXT_INT_NUMBER) {
         NRF_GPIOTE->INTENSET = (1 << (GPIOTE_INTENSET_IN0_Pos + id));
         NRF_GPIOTE->EVENTS_IN[id] = 0;
+        if (captura_ts) NRF_PPI->CHENSET = 1u << (TS_PPI_CANAL0 + id);
         NVIC_EnableIRQ(GPIOTE_IRQn);
     }
 }
@@ -103,6 +181,7 @@ void hal_ext_int_habilitar(hal_ext_int_id_t id){
 void hal_ext_int_deshabilitar(hal_ext_int_id_t id){
     if (id < EXT_INT_NUMBER) {
         NRF_GPIOTE->INTENCLR = (1 << (GPIOTE_INTENCLR_IN0_Pos + id));
+        if (captura_ts) NRF_PPI->CHENCLR = 1u << (TS_PPI_CANAL0 + id);
     }
 }
 
@@ -0,0 +1,79 @@
+/** *****************************************************************************
+ * P.H.2025: hal_flash_nrf.c
+ * HAL de flash de datos para nRF52840 (NVMC)
+ *
+ * Autores: Alejandro Lacosta, Pablo Villa
+ *
+ * Notas:
+ *  - Zona de datos: HAL_FLASH_PAGINAS paginas de 4 KB desde
+ *    FLASH_DATOS_INICIO (board). El proyecto no debe enlazar codigo ahi.
+ *  - Escritura: CONFIG = WEN y cada palabra se escribe como memoria; el
+ *    NVMC para la CPU ~41 us por palabra.
+ *  - Borrado: ERASEPAGEPARTIAL con tramos de TRAMO_MS. El borrado esta
+ *    completo cuando los tramos suman el tiempo de borrado de pagina
+ *    (tERASEPAGE, 85 ms como maximo).
+ * ***************************************************************************** */
+
+#include "hal_flash.h"
+#include "board.h"
+#include <nrf.h>
+
+#define PALABRAS_PAGINA   1024u                 // 4 KB
+#define TRAMO_MS          10u
+#define BORRADO_MS        85u
+#define TRAMOS_BORRADO    ((BORRADO_MS + TRAMO_MS - 1u) / TRAMO_MS)
+
+static uint8_t s_pagina_borrando = 0xFF;
+static uint8_t s_tramos = 0;
+
+static uint32_t* direccion(uint8_t pagina) {
+    return (uint32_t*)(FLASH_DATOS_INICIO + (uint32_t)pagina * PALABRAS_PAGINA * 4u);
+}
+
+static void esperar_listo(void) {
+    while (NRF_NVMC->READY == NVMC_READY_READY_Busy) { }
+}
+
+void hal_flash_iniciar(void) {
+    NRF_NVMC->ERASEPAGEPARTIALCFG = TRAMO_MS;
+    s_pagina_borrando = 0xFF;
+    s_tramos = 0;
+}
+
+uint32_t hal_flash_palabras_pagina(void) {
+    return PALABRAS_PAGINA;
+}
+
+const uint32_t* hal_flash_pagina(uint8_t pagina) {
+    return (pagina < HAL_FLASH_PAGINAS) ? direccion(pagina) : 0;
+}
+
+void hal_flash_escribir(uint8_t pagina, uint32_t offset, const uint32_t *datos, uint32_t n) {
+    if (pagina >= HAL_FLASH_PAGINAS || offset + n > PALABRAS_PAGINA) return;
+
+    volatile uint32_t *destino = direccion(pagina) + offset;
+    NRF_NVMC->CONFIG = NVMC_CONFIG_WEN_Wen << NVMC_CONFIG_WEN_Pos;
+    for (uint32_t i = 0; i < n; i++) {
+        destino[i] = datos[i];
+        esperar_listo();
+    }
+    NRF_NVMC->CONFIG = NVMC_CONFIG_WEN_Ren << NVMC_CONFIG_WEN_Pos;
+}
+
+bool hal_flash_borrar_paso(uint8_t pagina) {
+    if (pagina >= HAL_FLASH_PAGINAS) return true;
+
+    if (pagina != s_pagina_borrando) {
+        s_pagina_borrando = pagina;
+        s_tramos = 0;
+    }
+
+    NRF_NVMC->CONFIG = NVMC_CONFIG_WEN_Een << NVMC_CONFIG_WEN_Pos;
+    NRF_NVMC->ERASEPAGEPARTIAL = (uint32_t)direccion(pagina);
+    esperar_listo();
+    NRF_NVMC->CONFIG = NVMC_CONFIG_WEN_Ren << NVMC_CONFIG_WEN_Pos;
+
+    if (++s_tramos < TRAMOS_BORRADO) return false;
+    s_pagina_borrando = 0xFF;
+    return true;
+}
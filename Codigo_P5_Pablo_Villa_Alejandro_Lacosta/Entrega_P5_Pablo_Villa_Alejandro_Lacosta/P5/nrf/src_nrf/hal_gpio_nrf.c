@@ -45,6 +45,7 @@
 
 #include "hal_gpio.h"
 #include "board_nrf52840dk.h"
+#include "hal_SC.h"
 #include <nrf.h>
 
 
@@ -112,3 +113,30 @@ void hal_gpio_escribir(HAL_GPIO_PIN_T gpio, uint32_t valor) {
         NRF_P0->OUTSET = (1UL << gpio);
     }
 }
+
+/**
+ * @brief Lee el nivel de entrada de todo un puerto (registro IN) en un acceso.
+ *        El puerto 1 solo existe en el nRF52840.
+ */
+uint32_t hal_gpio_leer_puerto(uint32_t puerto) {
+    return (puerto == 1) ? NRF_P1->IN : NRF_P0->IN;
+}
+
+/**
+ * @brief Sube y baja varios pines de un puerto en una sola escritura.
+ *        Con una sola mascara basta OUTSET u OUTCLR; con las dos se escribe
+ *        OUT entero (lectura-modificacion-escritura en seccion critica).
+ */
+void hal_gpio_escribir_puerto(uint32_t puerto, uint32_t alto, uint32_t bajo) {
+    NRF_GPIO_Type *p = (puerto == 1) ? NRF_P1 : NRF_P0;
+
+    if (bajo == 0) {
+        p->OUTSET = alto;
+    } else if (alto == 0) {
+        p->OUTCLR = bajo;
+    } else {
+        hal_sc_entrar();
+        p->OUT = (p->OUT & ~(alto | bajo)) | alto;
+        hal_sc_salir();
+    }
+}
@@ -0,0 +1,128 @@
+/** *****************************************************************************
+ * P.H.2025: hal_pwm_nrf.c
+ * HAL PWM para nRF52840 (periferico PWM0 + EasyDMA)
+ *
+ * Autores: Alejandro Lacosta, Pablo Villa
+ *
+ * Notas:
+ *  - PWM0 a 1 MHz (PRESCALER = DIV_16) con COUNTERTOP = 1000: periodo 1 ms.
+ *  - DECODER.LOAD = Individual: cada entrada de la secuencia son 4 valores,
+ *    uno por canal. Bit 15 de cada valor = polaridad: a 1 el pin empieza
+ *    alto y baja al llegar a la comparacion (tiempo en alto = valor); a 0
+ *    es al reves. Asi se cubren LEDs activos a nivel alto y bajo.
+ *  - Un fundido es una secuencia de hasta RAMPA_PASOS escalones y cada
+ *    escalon se repite REFRESH periodos. Al acabar la secuencia el PWM se
+ *    queda con el ultimo valor: no hace falta ninguna interrupcion.
+ *  - EasyDMA lee la secuencia de RAM mientras suena: se alternan dos
+ *    buffers para no escribir el que esta reproduciendose.
+ *  - Un fundido nuevo fija los demas canales en su nivel final.
+ * ***************************************************************************** */
+
+#include "hal_pwm.h"
+#include <nrf.h>
+
+#define PWM             NRF_PWM0
+#define PWM_TOP         1000u          // 1 ms a 1 MHz
+#define RAMPA_PASOS     32u
+#define PSEL_DESCONECTADO 0xFFFFFFFFu
+
+static HAL_GPIO_PIN_T s_pines[HAL_PWM_CANALES];
+static uint8_t  s_num = 0;
+static uint16_t s_polaridad;               // 0x8000 si activo a nivel alto
+static uint8_t  s_nivel[HAL_PWM_CANALES];  // nivel final de cada canal
+static uint8_t  s_activos = 0;             // canales conectados al PWM
+
+static uint16_t s_seq[2][RAMPA_PASOS][HAL_PWM_CANALES];
+static uint8_t  s_buf = 0;
+
+static uint16_t valor(uint8_t nivel) {
+    return (uint16_t)(((uint32_t)nivel * PWM_TOP) / HAL_PWM_NIVEL_MAX) | s_polaridad;
+}
+
+static void conectar(uint8_t canal) {
+    if (s_activos & (1u << canal)) return;
+    PWM->PSEL.OUT[canal] = s_pines[canal];   // pin con el bit de puerto (bit 5)
+    s_activos |= (uint8_t)(1u << canal);
+    PWM->ENABLE = PWM_ENABLE_ENABLE_Enabled;
+}
+
+/* Reproduce 'pasos' escalones del buffer libre, cada uno 'refresco'+1 periodos. */
+static void reproducir(uint16_t (*seq)[HAL_PWM_CANALES], uint32_t pasos, uint32_t refresco) {
+    PWM->SEQ[0].PTR     = (uint32_t)seq;
+    PWM->SEQ[0].CNT     = pasos * HAL_PWM_CANALES;
+    PWM->SEQ[0].REFRESH = refresco;
+    PWM->SEQ[0].ENDDELAY = 0;
+    PWM->EVENTS_SEQEND[0] = 0;
+    PWM->TASKS_SEQSTART[0] = 1;
+    s_buf ^= 1u;
+}
+
+/* Rellena un escalon con el nivel final de todos los canales. */
+static void escalon_fijo(uint16_t *paso) {
+    for (uint8_t c = 0; c < HAL_PWM_CANALES; c++)
+        paso[c] = (c < s_num) ? valor(s_nivel[c]) : s_polaridad;
+}
+
+void hal_pwm_iniciar(const HAL_GPIO_PIN_T pines[], uint8_t num, uint32_t activo_alto) {
+    s_num = (num > HAL_PWM_CANALES) ? HAL_PWM_CANALES : num;
+    s_polaridad = activo_alto ? 0x8000u : 0x0000u;
+    s_activos = 0;
+
+    for (uint8_t c = 0; c < HAL_PWM_CANALES; c++) {
+        s_pines[c] = (c < s_num) ? pines[c] : 0;
+        s_nivel[c] = 0;
+        PWM->PSEL.OUT[c] = PSEL_DESCONECTADO;
+    }
+
+    PWM->ENABLE     = PWM_ENABLE_ENABLE_Disabled;
+    PWM->MODE       = PWM_MODE_UPDOWN_Up;
+    PWM->PRESCALER  = PWM_PRESCALER_PRESCALER_DIV_16;
+    PWM->COUNTERTOP = PWM_TOP;
+    PWM->LOOP       = 0;
+    PWM->DECODER    = (PWM_DECODER_LOAD_Individual << PWM_DECODER_LOAD_Pos) |
+                      (PWM_DECODER_MODE_RefreshCount << PWM_DECODER_MODE_Pos);
+    PWM->SHORTS     = 0;
+    PWM->INTEN      = 0;
+}
+
+void hal_pwm_nivel(uint8_t canal, uint8_t nivel) {
+    if (canal >= s_num) return;
+    s_nivel[canal] = nivel;
+    conectar(canal);
+
+    uint16_t (*seq)[HAL_PWM_CANALES] = s_seq[s_buf];
+    escalon_fijo(seq[0]);
+    reproducir(seq, 1, 0);
+}
+
+void hal_pwm_rampa(uint8_t canal, uint8_t desde, uint8_t hasta, uint32_t ms) {
+    if (canal >= s_num) return;
+    if (ms == 0) { hal_pwm_nivel(canal, hasta); return; }
+
+    s_nivel[canal] = hasta;
+    conectar(canal);
+
+    uint32_t pasos = (ms < RAMPA_PASOS) ? ms : RAMPA_PASOS;
+    uint16_t (*seq)[HAL_PWM_CANALES] = s_seq[s_buf];
+    int32_t delta = (int32_t)hasta - (int32_t)desde;
+
+    for (uint32_t k = 0; k < pasos; k++) {
+        escalon_fijo(seq[k]);
+        // El ultimo escalon es exactamente 'hasta'
+        seq[k][canal] = valor((uint8_t)((int32_t)desde + delta * (int32_t)(k + 1) / (int32_t)pasos));
+    }
+    reproducir(seq, pasos, ms / pasos - 1u);
+}
+
+void hal_pwm_soltar(uint8_t canal) {
+    if (canal >= s_num || !(s_activos & (1u << canal))) return;
+
+    PWM->PSEL.OUT[canal] = PSEL_DESCONECTADO;
+    s_activos &= (uint8_t)~(1u << canal);
+    s_nivel[canal] = 0;
+
+    if (s_activos == 0) {
+        PWM->TASKS_STOP = 1;
+        PWM->ENABLE = PWM_ENABLE_ENABLE_Disabled;   // sin consumo del periferico
+    }
+}
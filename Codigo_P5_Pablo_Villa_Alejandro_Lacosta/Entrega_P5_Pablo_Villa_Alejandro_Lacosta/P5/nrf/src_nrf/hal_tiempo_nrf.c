@@ -5,110 +5,114 @@
  * Autores: Alejandro Lacosta, Pablo Villa
  *
  * Implementa:
- *  - Reloj montono de 24-bit (SysTick)
+ *  - Reloj montono de 64 bits (RTC2 + cuenta de desbordes)
  *  - Reloj peridico con callback (RTC1)
  *
  * Notas:
- *  - SysTick: alta precisin (usado para medir tiempo en s o ms)
- *  - RTC1: bajo consumo, usado para temporizacin peridica (32768 Hz)
- *  - Prescaler = 0 ? frecuencia base del RTC = 32768 Hz
+ *  - Los dos RTC cuentan el LFCLK (cristal de 32768 Hz, prescaler = 0) y
+ *    siguen contando con la CPU dormida. El SysTick se usaba antes como reloj
+ *    montono, pero se para en WFI: con el tick pospuesto el tiempo se
+ *    quedara congelado.
+ *  - RTC2: contador libre de 24 bits; cada desborde (512 s) suma 2^24 ticks.
+ *    hal_tiempo_actual_tick64 devuelve us (resolucin de 30.5 us).
+ *  - RTC1: temporizacin peridica (CC[0] con CLEAR en la ISR). Un disparo
+ *    se puede posponer para dormir sin tick (hal_tiempo_periodico_posponer).
  *
  ******************************************************************************/
 
 	#include "hal_tiempo.h"
 	#include "nrf.h"
 
-	#define TICKS_PER_US   16u
-	#define COUNTER_BITS   32u
-	#define COUNTER_MAX    0xFFFFFFFFu
-	#define MAX_SYSTICK_RELOAD 0x00FFFFFFu
+	#define RTC_HZ         32768u
+	#define COUNTER_BITS   24u
+	#define COUNTER_MAX    0x00FFFFFFu
 
-//	static hal_tiempo_info_t s_info;               // informacin de alta precisin (SysTick)
 	static hal_tiempo_info_t s_info_per;     // informacin de baja frecuencia (RTC1)
 	static void (*s_periodic_callback)(void);      // callback peridico
-	static volatile uint64_t s_tick64 = 0;      // contador de milisegundos (64 bits)
-	static volatile uint32_t s_ticks_us = 0;    // ticks por microsegundo
-	
-	// SysTick 
+	static volatile uint32_t s_desbordes = 0;   // desbordes del RTC2
+	static uint32_t s_periodo = 0;              // periodo del RTC1 en ticks
+	static volatile bool s_pospuesto = false;   // CC[0] tiene un disparo pospuesto
+	static bool s_habilitado = false;           // RTC1 en marcha
+
+	/* Arranca el LFCLK con el cristal si an no est en marcha */
+	static void arrancar_lfclk(void) {
+    if (NRF_CLOCK->LFCLKSTAT & CLOCK_LFCLKSTAT_STATE_Msk) return;
+    NRF_CLOCK->LFCLKSRC = CLOCK_LFCLKSRC_SRC_Xtal;   // usar cristal externo
+    NRF_CLOCK->EVENTS_LFCLKSTARTED = 0;
+    NRF_CLOCK->TASKS_LFCLKSTART = 1;
+    while (NRF_CLOCK->EVENTS_LFCLKSTARTED == 0);
+	}
 
 	// ============================================================================
-	// SysTick Handler se ejecuta automticamente cada 1 ms
+	// RTC2: cuenta los desbordes del contador de 24 bits
 	// ============================================================================
-	void SysTick_Handler(void) {
-    s_tick64++;  // incrementa cada milisegundo
+	void RTC2_IRQHandler(void) {
+    if (NRF_RTC2->EVENTS_OVRFLW) {
+        NRF_RTC2->EVENTS_OVRFLW = 0;
+        s_desbordes++;
+    }
 	}
 	
 	/* ============================================================================
  * hal_tiempo_iniciar_tick
  * ============================================================================
- * @brief Inicializa el temporizador SysTick como reloj montono de alta precisin.
+ * @brief Inicializa el RTC2 como reloj montono.
  * 
- * Configura el SysTick para generar interrupciones cada 1 ms, usando el reloj
- * principal de la CPU (SystemCoreClock). Este temporizador se usa para medir
- * intervalos de tiempo precisos y obtener marcas temporales absolutas.  
- *
  * @param [in/out] Puntero a una estructura `hal_tiempo_info_t` donde se
- *                      almacenar la informacin del reloj (ticks por s, etc).
+ *                      almacenar la informacin del reloj (ticks por us, etc).
  * 
  * @return Ninguno.
  * 
  * @details
- *  - Inicia el oscilador de alta frecuencia (HFCLK).
- *  - Configura el valor de recarga para generar interrupciones cada 1 ms.
- *  - Guarda la frecuencia de ticks por microsegundo en `info->ticks_per_us`.
+ *  - No pide el HFCLK: lo gestiona el dominio DRV_DOMINIO_HFCLK.
+ *  - Arranca el LFCLK y deja el RTC2 contando libre con la IRQ de desborde.
+ *  - Como en LPC, hal_tiempo_actual_tick64() devuelve us: ticks_per_us = 1.
  * ============================================================================
  */
 
 	void hal_tiempo_iniciar_tick(hal_tiempo_info_t *info) {
 		
-		NRF_CLOCK->EVENTS_HFCLKSTARTED = 0;
-    NRF_CLOCK->TASKS_HFCLKSTART = 1;
-    while (NRF_CLOCK->EVENTS_HFCLKSTARTED == 0) {
-        // Esperar al encendido (~12 ms)
-    }
-		
-    uint32_t core_clock = SystemCoreClock;            // frecuencia CPU (Hz)
-    uint32_t reload_val = (core_clock / 1000u) - 1u;  // 1 ms (64e6 / 1000) - 1 = 63999
-
-    if (reload_val > 0x00FFFFFFu)                     // lmite de 24 bits
-        reload_val = 0x00FFFFFFu;
-
-    info->ticks_per_us  = core_clock / 1000000u;      // ticks/s 
-    s_tick64 = 0;
-
-    // --- Configurar registros del SysTick ---
-    SysTick->LOAD = reload_val;   // Valor de recarga cada 1 ms
-    SysTick->VAL  = 0;            // Reset del contador actual
-    SysTick->CTRL = (1u << 2) |   // CLKSOURCE = CPU clock
-                    (1u << 1) |   // TICKINT = interrupciones activadas (opcional)
-                    (1u << 0);    // ENABLE = contador activo
+		arrancar_lfclk();
+
+    NRF_RTC2->TASKS_STOP  = 1;
+    NRF_RTC2->TASKS_CLEAR = 1;
+    NRF_RTC2->PRESCALER   = 0;                        // 32.768 kHz
+    NRF_RTC2->EVENTS_OVRFLW = 0;
+    NRF_RTC2->EVTENSET = RTC_EVTEN_OVRFLW_Msk;
+    NRF_RTC2->INTENSET = RTC_INTENSET_OVRFLW_Msk;
+    s_desbordes = 0;
+    NVIC_EnableIRQ(RTC2_IRQn);
+    NRF_RTC2->TASKS_START = 1;
+
+    info->ticks_per_us = 1u;
+    info->counter_bits = COUNTER_BITS;
+    info->counter_max  = COUNTER_MAX;
 	}
 
 /* ============================================================================
  * hal_tiempo_actual_tick64
  * ============================================================================
- * @brief Devuelve el tiempo actual transcurrido desde el arranque (en s).
- * 
- * @return Valor de tiempo actual (en microsegundos) desde el inicio del sistema.
+ * @brief Devuelve el tiempo actual transcurrido desde el arranque (en us).
  * 
  * @details
- *  - Combina el contador de milisegundos (`s_tick64`) con la fraccin restante
- *    del SysTick (`SysTick->VAL`).
- *  - Ofrece resolucin sub-milisegundo calculando la fraccin de tick actual.
- *  - Ideal para mediciones de tiempo precisas (del orden de s).
+ *  - Une la cuenta de desbordes con el COUNTER del RTC2; si la ISR de
+ *    desborde est pendiente (llamada con interrupciones deshabilitadas) y
+ *    el contador ya ha dado la vuelta, se suma el desborde a mano.
+ *  - ticks * 1e6 / 32768 = ticks * 15625 / 512, sin desbordar en 64 bits.
  * ============================================================================
  */
 	uint64_t hal_tiempo_actual_tick64(void) {
-    uint32_t val  = SysTick->VAL;
-    uint32_t load = SysTick->LOAD;
+    uint32_t desbordes, contador;
+    do {
+        desbordes = s_desbordes;
+        contador  = NRF_RTC2->COUNTER;
+    } while (desbordes != s_desbordes);
 
-    // Tiempo base (en s): cada tick equivale a 1 ms = 1000 s
-    uint64_t base_us = s_tick64 * 1000ULL;
+    if (NRF_RTC2->EVENTS_OVRFLW && contador < (COUNTER_MAX / 2u))
+        desbordes++;
 
-    // Fraccin sub-ms convertida a s
-    uint32_t partial_us = ((load - val) * 1000000ULL) / SystemCoreClock;
-
-    return base_us + partial_us;
+    uint64_t ticks = ((uint64_t)desbordes << COUNTER_BITS) | contador;
+    return (ticks * 15625u) >> 9;
 	}
 
 	/* --- Reloj peridico con callback usando RTC1 --- */
@@ -133,11 +137,8 @@
  */
 	
 	void hal_tiempo_iniciar_tick_periodico(hal_tiempo_info_t *out_info_per) {
-    // Arrancar reloj de baja frecuencia (LFCLK)
-    NRF_CLOCK->LFCLKSRC = CLOCK_LFCLKSRC_SRC_Xtal;   // usar cristal externo
-    NRF_CLOCK->EVENTS_LFCLKSTARTED = 0;
-    NRF_CLOCK->TASKS_LFCLKSTART = 1;
-    while (NRF_CLOCK->EVENTS_LFCLKSTARTED == 0);
+    // Arrancar reloj de baja frecuencia (LFCLK); el RTC2 ya lo usa
+    arrancar_lfclk();
 
     // Configurar RTC1 como base de tiempo lenta
     NRF_RTC1->TASKS_STOP  = 1;
@@ -169,6 +170,10 @@
     if (NRF_RTC1->EVENTS_COMPARE[0]) {
         NRF_RTC1->EVENTS_COMPARE[0] = 0;
         NRF_RTC1->TASKS_CLEAR = 1;       
+        if (s_pospuesto) {               // disparo pospuesto: vuelve al periodo
+            NRF_RTC1->CC[0] = s_periodo;
+            s_pospuesto = false;
+        }
         if (s_periodic_callback) s_periodic_callback();
     }
 }
@@ -183,6 +188,8 @@
     NRF_RTC1->TASKS_CLEAR = 1;
 
     NRF_RTC1->PRESCALER = 0;              // prescaler = 0 -->  32.768 kHz
+    s_periodo = periodo_en_tick;
+    s_pospuesto = false;
     NRF_RTC1->CC[0] = periodo_en_tick;    // valor de comparacin
     NRF_RTC1->EVENTS_COMPARE[0] = 0;
     NRF_RTC1->EVTENSET = RTC_EVTEN_COMPARE0_Msk;
@@ -202,10 +209,17 @@
 	/**
 	 * @brief Habilita o deshabilita el reloj peridico
 	 *
-	 * @param enable true: arranca el temporizador / false: lo detiene
+	 * @param enable true: arranca el temporizador desde cero / false: lo detiene
 	 */
 	void hal_tiempo_periodico_enable(bool enable) {
+    s_habilitado = enable;
+    if (s_pospuesto) {
+        NRF_RTC1->CC[0] = s_periodo;
+        s_pospuesto = false;
+    }
     if (enable) {
+        NRF_RTC1->TASKS_CLEAR = 1;       // primer disparo un periodo despus
+        NRF_RTC1->EVENTS_COMPARE[0] = 0;
         NVIC_EnableIRQ(RTC1_IRQn);
         NRF_RTC1->TASKS_START = 1;
     } else {
@@ -214,3 +228,27 @@
     }
 	}
 
+	/**
+	 * @brief Pospone el siguiente disparo a 'ticks' desde ahora
+	 *
+	 * El contador se pone a cero y CC[0] recibe el retraso; la ISR de ese
+	 * disparo vuelve a cargar el periodo.
+	 */
+	void hal_tiempo_periodico_posponer(uint32_t ticks) {
+    if (!s_habilitado) hal_tiempo_periodico_enable(true);
+    if (ticks <= s_periodo) return;
+    if (ticks > COUNTER_MAX) ticks = COUNTER_MAX;
+    NRF_RTC1->TASKS_CLEAR = 1;
+    NRF_RTC1->CC[0] = ticks;
+    s_pospuesto = true;
+	}
+
+	/**
+	 * @brief Anula un disparo pospuesto: el siguiente llega un periodo despus
+	 */
+	void hal_tiempo_periodico_reanudar(void) {
+    if (!s_pospuesto) return;
+    NRF_RTC1->TASKS_CLEAR = 1;
+    NRF_RTC1->CC[0] = s_periodo;
+    s_pospuesto = false;
+	}
@@ -21,6 +21,14 @@
 #define PIN_TXD (6)
 #define PIN_RXD (8)
 
+static hal_uart_rx_callback_t s_rx_cb = 0;
+static volatile uint8_t s_rx_byte;     // Buffer EasyDMA de 1 byte
+
+static hal_uart_tx_callback_t s_tx_cb = 0;
+static uint8_t s_tx_buf[16];           // Bloque EasyDMA en transmision
+static volatile bool s_tx_ocupada = false;
+static bool s_tx_lanzado = false;      // STARTTX sin STOPTX posterior
+
 void hal_uart_init() {
     // Configura el pin TXD como salida
     NRF_GPIO->PIN_CNF[PIN_TXD] = 
@@ -45,6 +53,29 @@ void hal_uart_init() {
     NRF_UARTE0->PSEL.TXD = PIN_TXD;
     NRF_UARTE0->PSEL.RXD = PIN_RXD;
     NRF_UARTE0->ENABLE = UARTE_ENABLE_ENABLE_Enabled;
+
+    // Con la UARTE apagada el pin vuelve al GPIO: reposo en alto
+    NRF_GPIO->OUTSET = (1u << PIN_TXD);
+}
+
+/**
+ * Enciende o apaga la UARTE0. Al apagar se para el transmisor (si se llego
+ * a lanzar) y se espera a TXSTOPPED: sin eso la UARTE sigue pidiendo reloj
+ * aun deshabilitada.
+ */
+void hal_uart_alimentar(bool encender) {
+	if (encender) {
+		NRF_UARTE0->ENABLE = UARTE_ENABLE_ENABLE_Enabled;
+		return;
+	}
+	if (s_tx_lanzado) {
+		NRF_UARTE0->EVENTS_TXSTOPPED = 0;
+		NRF_UARTE0->TASKS_STOPTX = 1;
+		while (NRF_UARTE0->EVENTS_TXSTOPPED == 0) { }
+		NRF_UARTE0->EVENTS_TXSTOPPED = 0;
+		s_tx_lanzado = false;
+	}
+	NRF_UARTE0->ENABLE = UARTE_ENABLE_ENABLE_Disabled;
 }
 
 int hal_uart_sendchar(char ch) {
@@ -54,8 +85,77 @@ int hal_uart_sendchar(char ch) {
 
 	NRF_UARTE0->EVENTS_ENDTX = 0;
 	NRF_UARTE0->TASKS_STARTTX = 1;
+	s_tx_lanzado = true;
 
 	while (NRF_UARTE0->EVENTS_ENDTX == 0);
 	
 	return 0;
 }
+
+/**
+ * Carga el siguiente bloque a transmitir en el buffer EasyDMA y lanza STARTTX.
+ */
+static void uarte_tx_siguiente(void) {
+	uint32_t n = s_tx_cb ? s_tx_cb(s_tx_buf, sizeof(s_tx_buf)) : 0;
+	if (n > 0) {
+		NRF_UARTE0->TXD.PTR = (uint32_t)s_tx_buf;
+		NRF_UARTE0->TXD.MAXCNT = n;
+		NRF_UARTE0->EVENTS_ENDTX = 0;
+		NRF_UARTE0->TASKS_STARTTX = 1;
+		s_tx_lanzado = true;
+	}
+	s_tx_ocupada = (n > 0);
+}
+
+/**
+ * ISR de UARTE0.
+ *  - ENDRX: byte recibido. El atajo ENDRX->STARTRX rearma la recepcion
+ *    sobre el mismo buffer sin intervencion software.
+ *  - ENDTX: bloque enviado, se pide el siguiente al callback.
+ */
+void UARTE0_UART0_IRQHandler(void) {
+	if (NRF_UARTE0->EVENTS_ENDRX) {
+		NRF_UARTE0->EVENTS_ENDRX = 0;
+		if (s_rx_cb) s_rx_cb((char)s_rx_byte);
+	}
+	if (NRF_UARTE0->EVENTS_ENDTX && (NRF_UARTE0->INTEN & UARTE_INTEN_ENDTX_Msk)) {
+		NRF_UARTE0->EVENTS_ENDTX = 0;
+		uarte_tx_siguiente();
+	}
+}
+
+void hal_uart_rx_iniciar(hal_uart_rx_callback_t cb) {
+	s_rx_cb = cb;
+
+	NRF_UARTE0->RXD.PTR = (uint32_t)&s_rx_byte;
+	NRF_UARTE0->RXD.MAXCNT = 1;
+	NRF_UARTE0->SHORTS = UARTE_SHORTS_ENDRX_STARTRX_Msk;
+	NRF_UARTE0->EVENTS_ENDRX = 0;
+	NRF_UARTE0->INTENSET = UARTE_INTENSET_ENDRX_Msk;
+
+	NVIC_ClearPendingIRQ(UARTE0_UART0_IRQn);
+	NVIC_EnableIRQ(UARTE0_UART0_IRQn);
+
+	NRF_UARTE0->TASKS_STARTRX = 1;
+}
+
+void hal_uart_tx_iniciar(hal_uart_tx_callback_t cb) {
+	s_tx_cb = cb;
+	s_tx_ocupada = false;
+
+	NRF_UARTE0->EVENTS_ENDTX = 0;
+	NRF_UARTE0->INTENSET = UARTE_INTENSET_ENDTX_Msk;
+
+	NVIC_EnableIRQ(UARTE0_UART0_IRQn);
+}
+
+void hal_uart_tx_arrancar(void) {
+	// Se enmascara la IRQ para no competir con la ISR por s_tx_ocupada
+	NVIC_DisableIRQ(UARTE0_UART0_IRQn);
+	if (!s_tx_ocupada) uarte_tx_siguiente();
+	NVIC_EnableIRQ(UARTE0_UART0_IRQn);
+}
+
+bool hal_uart_tx_ocupada(void) {
+	return s_tx_ocupada;
+}
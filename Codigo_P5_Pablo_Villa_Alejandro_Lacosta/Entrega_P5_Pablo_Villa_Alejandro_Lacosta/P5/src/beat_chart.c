@@ -0,0 +1,126 @@
+/* *****************************************************************************
+ * P.H.2025: beat_chart.c
+ * Motor de partituras de Beat Hero
+ *
+ * Decodifica la partitura binaria (ver beat_chart.h) bajo demanda hacia una
+ * ventana circular de BEAT_CHART_ADELANTO compases.
+ *
+ * Autores: Alejandro Lacosta, Pablo Villa
+ *
+ * Notas:
+ *  - La decodificacion es perezosa: solo se saca de la fuente lo que se
+ *    consulta. Con el generador aleatorio esto conserva el momento en que
+ *    se sortea cada compas (depende del nivel de la partida).
+ *  - Una partitura corrupta o truncada se trata como fin de cancion.
+ * *****************************************************************************/
+
+#include "beat_chart.h"
+#include <stddef.h>
+
+#define MASCARA_VENTANA (BEAT_CHART_ADELANTO - 1u)
+
+static uint16_t leer_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+/* Saca el siguiente compas de la partitura binaria. */
+static bool decodificar(beat_chart_t *c, beat_chart_compas_t *out) {
+    while (c->repeticiones == 0) {
+        if (c->pos >= c->tam) return false;
+        uint8_t op = c->datos[c->pos++];
+
+        if (op == BEAT_CHART_OP_FIN) {
+            c->pos = c->tam;
+            return false;
+        } else if (op == BEAT_CHART_OP_TEMPO) {
+            if (c->pos + 2u > c->tam) return false;
+            uint16_t bpm = leer_u16(&c->datos[c->pos]);
+            c->pos += 2u;
+            if (bpm != 0) c->bpm = bpm;
+        } else if ((op & 0x80u) == 0) {
+            c->mascara_rep  = op & 0x0Fu;
+            c->repeticiones = (uint8_t)(((op >> 4) & 0x07u) + 1u);
+        } else {
+            c->pos = c->tam;          // codigo desconocido
+            return false;
+        }
+    }
+    c->repeticiones--;
+    out->mascara = c->mascara_rep;
+    out->bpm = c->bpm;
+    return true;
+}
+
+/* Saca el siguiente compas de la fuente activa (vacio pasado el final). */
+static beat_chart_compas_t siguiente(beat_chart_t *c) {
+    beat_chart_compas_t comp = { 0, c->bpm };
+
+    if (c->decodificados >= c->compases) return comp;
+
+    if (c->generador != NULL) {
+        comp.mascara = c->generador();
+    } else if (!decodificar(c, &comp)) {
+        c->compases = c->decodificados;   // termina antes de lo anunciado
+        return comp;
+    }
+    c->decodificados++;
+    return comp;
+}
+
+static void reiniciar(beat_chart_t *c) {
+    c->pos = 0;
+    c->decodificados = 0;
+    c->repeticiones = 0;
+    c->mascara_rep = 0;
+    c->cabeza = 0;
+    c->num = 0;
+}
+
+bool beat_chart_abrir(beat_chart_t *c, const uint8_t *datos, uint32_t tam) {
+    reiniciar(c);
+    c->datos = NULL;
+    c->tam = 0;
+    c->generador = NULL;
+    c->compases = 0;
+
+    if (datos == NULL || tam < BEAT_CHART_CABECERA) return false;
+    if (datos[0] != 'B' || datos[1] != 'C' || datos[2] != BEAT_CHART_VERSION) return false;
+    if (datos[3] == 0 || datos[3] > 4) return false;
+
+    c->datos    = datos;
+    c->tam      = tam;
+    c->pos      = BEAT_CHART_CABECERA;
+    c->compases = leer_u16(&datos[4]);
+    c->bpm      = leer_u16(&datos[6]);
+    return c->bpm != 0;
+}
+
+void beat_chart_abrir_generador(beat_chart_t *c, uint16_t compases, uint16_t bpm,
+                                beat_chart_generador_t gen) {
+    reiniciar(c);
+    c->datos = NULL;
+    c->tam = 0;
+    c->generador = gen;
+    c->compases = compases;
+    c->bpm = bpm;
+}
+
+beat_chart_compas_t beat_chart_ver(beat_chart_t *c, uint8_t k) {
+    if (k >= BEAT_CHART_ADELANTO) k = BEAT_CHART_ADELANTO - 1u;
+
+    while (c->num <= k) {
+        c->ventana[(c->cabeza + c->num) & MASCARA_VENTANA] = siguiente(c);
+        c->num++;
+    }
+    return c->ventana[(c->cabeza + k) & MASCARA_VENTANA];
+}
+
+void beat_chart_avanzar(beat_chart_t *c) {
+    if (c->num == 0) (void)beat_chart_ver(c, 0);
+    c->cabeza = (c->cabeza + 1u) & MASCARA_VENTANA;
+    c->num--;
+}
+
+uint16_t beat_chart_compases(const beat_chart_t *c) {
+    return c->compases;
+}
@@ -0,0 +1,125 @@
+/******************************************************************************
+ * Fichero: beat_chart.h
+ * Proyecto: P.H.2025
+ *
+ * Partituras ("charts") de Beat Hero y motor que las recorre.
+ *
+ * Una partitura es un bloque binario constante (en flash):
+ *
+ *   Cabecera (8 bytes)
+ *     [0..1] 'B' 'C'          marca
+ *     [2]    version (1)
+ *     [3]    carriles (1..4)
+ *     [4..5] compases (uint16 LE)
+ *     [6..7] bpm inicial (uint16 LE)
+ *   Cuerpo (secuencia de codigos de 1 byte)
+ *     0rrr mmmm   compas con mascara de carriles m, repetido r+1 veces
+ *     1000 0000   cambio de tempo: siguen 2 bytes con el bpm (uint16 LE)
+ *     1111 1111   fin
+ *
+ * El motor decodifica sobre la marcha y mantiene una ventana pequena de
+ * compases ya decodificados (BEAT_CHART_ADELANTO), de modo que la RAM no
+ * crece con la longitud de la cancion. La generacion aleatoria de siempre
+ * sigue disponible como otra fuente de compases.
+ *
+ * Autores:
+ *   Alejandro Lacosta
+ *   Pablo Villa
+ *
+ * Universidad de Zaragoza
+ *
+ *****************************************************************************/
+
+#ifndef BEAT_CHART_H
+#define BEAT_CHART_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Compases decodificados por adelantado (potencia de 2).
+ */
+#define BEAT_CHART_ADELANTO 4
+
+#define BEAT_CHART_CABECERA  8
+#define BEAT_CHART_VERSION   1
+
+// Codigos del cuerpo
+#define BEAT_CHART_OP_TEMPO  0x80u
+#define BEAT_CHART_OP_FIN    0xFFu
+#define BEAT_CHART_COMPAS(mascara, repeticiones) \
+    ((uint8_t)((((repeticiones) - 1u) & 0x07u) << 4 | ((mascara) & 0x0Fu)))
+#define BEAT_CHART_TEMPO(bpm) \
+    BEAT_CHART_OP_TEMPO, (uint8_t)((bpm) & 0xFFu), (uint8_t)((bpm) >> 8)
+
+/**
+ * @brief Un compas: carriles que hay que pulsar y tempo con el que suena.
+ */
+typedef struct {
+    uint8_t  mascara;
+    uint16_t bpm;
+} beat_chart_compas_t;
+
+/**
+ * @brief Generador de mascaras para la fuente aleatoria.
+ */
+typedef uint8_t (*beat_chart_generador_t)(void);
+
+/**
+ * @brief Estado del motor (lo reserva quien lo usa, normalmente estatico).
+ */
+typedef struct {
+    // Fuente: partitura en flash o generador
+    const uint8_t         *datos;
+    uint32_t               tam;
+    uint32_t               pos;
+    beat_chart_generador_t generador;
+
+    uint16_t compases;        // longitud total de la cancion
+    uint16_t decodificados;   // compases ya sacados de la fuente
+    uint16_t bpm;             // tempo vigente en la fuente
+    uint8_t  repeticiones;    // compases pendientes del codigo actual
+    uint8_t  mascara_rep;
+
+    // Ventana circular de compases decodificados
+    beat_chart_compas_t ventana[BEAT_CHART_ADELANTO];
+    uint8_t  cabeza;
+    uint8_t  num;
+} beat_chart_t;
+
+/**
+ * @brief Abre una partitura binaria.
+ * @return false si la cabecera no es valida
+ */
+bool beat_chart_abrir(beat_chart_t *c, const uint8_t *datos, uint32_t tam);
+
+/**
+ * @brief Usa un generador como fuente (compases aleatorios de siempre).
+ * @param compases Longitud de la partida
+ * @param bpm      Tempo constante
+ * @param gen      Funcion que devuelve la mascara de cada compas
+ */
+void beat_chart_abrir_generador(beat_chart_t *c, uint16_t compases, uint16_t bpm,
+                                beat_chart_generador_t gen);
+
+/**
+ * @brief Consulta el compas k posiciones por delante del actual
+ *        (k < BEAT_CHART_ADELANTO). Pasado el final devuelve un compas vacio.
+ */
+beat_chart_compas_t beat_chart_ver(beat_chart_t *c, uint8_t k);
+
+/**
+ * @brief Consume el compas actual.
+ */
+void beat_chart_avanzar(beat_chart_t *c);
+
+/**
+ * @brief Numero total de compases de la cancion.
+ */
+uint16_t beat_chart_compases(const beat_chart_t *c);
+
+// Partituras incluidas (beat_chart_canciones.c)
+extern const uint8_t  beat_chart_demo[];
+extern const uint32_t beat_chart_demo_tam;
+
+#endif // BEAT_CHART_H
@@ -0,0 +1,49 @@
+/* *****************************************************************************
+ * P.H.2025: beat_chart_canciones.c
+ * Partituras de Beat Hero incluidas en el firmware (en flash)
+ *
+ * Autores: Alejandro Lacosta, Pablo Villa
+ *
+ * Formato en beat_chart.h. Carril 1 = 0x01, carril 2 = 0x02, ambos = 0x03.
+ * *****************************************************************************/
+
+#include "beat_chart.h"
+
+#define DEMO_COMPASES 40
+
+const uint8_t beat_chart_demo[] = {
+    'B', 'C', BEAT_CHART_VERSION, 2,
+    DEMO_COMPASES & 0xFF, DEMO_COMPASES >> 8,
+    50, 0,                                   // 50 bpm
+
+    // Calentamiento: alternar carriles
+    BEAT_CHART_COMPAS(0x01, 1), BEAT_CHART_COMPAS(0x02, 1),
+    BEAT_CHART_COMPAS(0x01, 1), BEAT_CHART_COMPAS(0x02, 1),
+    BEAT_CHART_COMPAS(0x01, 2), BEAT_CHART_COMPAS(0x02, 2),
+
+    // Primer cambio de tempo y silencios
+    BEAT_CHART_TEMPO(60),
+    BEAT_CHART_COMPAS(0x01, 1), BEAT_CHART_COMPAS(0x00, 1),
+    BEAT_CHART_COMPAS(0x02, 1), BEAT_CHART_COMPAS(0x00, 1),
+    BEAT_CHART_COMPAS(0x03, 1), BEAT_CHART_COMPAS(0x01, 1),
+    BEAT_CHART_COMPAS(0x02, 1), BEAT_CHART_COMPAS(0x03, 1),
+
+    // Estribillo mas rapido
+    BEAT_CHART_TEMPO(75),
+    BEAT_CHART_COMPAS(0x01, 1), BEAT_CHART_COMPAS(0x02, 1),
+    BEAT_CHART_COMPAS(0x03, 2), BEAT_CHART_COMPAS(0x00, 1),
+    BEAT_CHART_COMPAS(0x02, 1), BEAT_CHART_COMPAS(0x01, 1),
+    BEAT_CHART_COMPAS(0x03, 1), BEAT_CHART_COMPAS(0x02, 3),
+    BEAT_CHART_COMPAS(0x01, 3),
+
+    // Final a tempo inicial
+    BEAT_CHART_TEMPO(50),
+    BEAT_CHART_COMPAS(0x03, 1), BEAT_CHART_COMPAS(0x00, 1),
+    BEAT_CHART_COMPAS(0x03, 1), BEAT_CHART_COMPAS(0x01, 1),
+    BEAT_CHART_COMPAS(0x02, 1), BEAT_CHART_COMPAS(0x03, 1),
+    BEAT_CHART_COMPAS(0x00, 4),
+
+    BEAT_CHART_OP_FIN
+};
+
+const uint32_t beat_chart_demo_tam = sizeof(beat_chart_demo);
@@ -24,6 +24,8 @@
 #include "svc_alarmas.h"
 #include "hal_random.h"
 #include "rt_GE.h"
+#include "svc_grabacion.h"
+#include "svc_energia.h"
 #include <stddef.h>
 
 // ============================================================================
@@ -33,7 +35,8 @@
 #define NUM_COMPASES        15
 #define BPM_INICIAL         90
 #define COMPAS_MS           (60000 / BPM_INICIAL)
-#define VENTANA_ACIERTO_MS  (COMPAS_MS * 0.4)
+#define VENTANA_ACIERTO_MS  ((COMPAS_MS * 2) / 5)    // 40 % del compas (entero, sin FPU)
+#define VENTANA_PERFECTO_MS (VENTANA_ACIERTO_MS / 2)
 #define TIEMPO_ENTRE_COMPASES 100
 #define PUNTUACION_FALLO    -5
 #define TIEMPO_INACTIVIDAD  10000
@@ -44,12 +47,6 @@
 #define ID_TIMEOUT_FIN      0x03
 #define ID_TIMEOUT_INICIO   0x04
 
-// LEDs
-#define LED_1   1
-#define LED_2   2  
-#define LED_3   3
-#define LED_4   4
-
 // Patrones
 #define PATRON_LED_1        0x01
 #define PATRON_LED_2        0x02
@@ -102,8 +99,9 @@ void beat_hero_iniciar(void) {
     
     // Inicializar drivers
     drv_leds_iniciar();
-    drv_botones_iniciar(NULL, ev_PULSAR_BOTON, ev_PULSAR_BOTON);
-    hal_random_iniciar(drv_tiempo_actual_ms());
+    drv_botones_iniciar(NULL, ev_PULSAR_BOTON, ev_SOLTAR_BOTON);
+    svc_grabacion_iniciar();
+    hal_random_iniciar(svc_grabacion_semilla(drv_tiempo_actual_ms()));
 
     // Suscribir a eventos
     svc_GE_suscribir(ev_PULSAR_BOTON, 2, juego_fsm);
@@ -130,10 +128,7 @@ static void reiniciar_juego(void) {
 
 static void iniciar_secuencia_inicio(void) {
     // Secuencia de inicio simple: parpadeo de todos los LEDs
-    drv_led_establecer(LED_1, LED_ON);
-    drv_led_establecer(LED_2, LED_ON);
-    drv_led_establecer(LED_3, LED_ON);
-    drv_led_establecer(LED_4, LED_ON);
+    drv_leds_escribir_mascara(0x0F);
     
     svc_alarma_activar(svc_alarma_codificar(false, 500, 0), 
                       ev_BEAT_TIMEOUT, ID_TIMEOUT_INICIO);
@@ -279,11 +274,13 @@ static void evaluar_pulsacion(uint8_t boton_pulsado) {
     }
 
     bool acierto = es_pulsacion_correcta(boton_pulsado);
-    uint32_t tiempo_reaccion = drv_tiempo_actual_ms() - tiempo_inicio_compas;
+    // Instante del flanco del boton (sin retardo de antirrebotes ni de cola)
+    uint32_t t_flanco_ms = (uint32_t)(drv_botones_ts_pulsacion(boton_pulsado) / 1000u);
+    uint32_t tiempo_reaccion = (t_flanco_ms > tiempo_inicio_compas) ? t_flanco_ms - tiempo_inicio_compas : 0;
 
     if (acierto) {
         if (tiempo_reaccion <= VENTANA_ACIERTO_MS) {
-            puntuacion += (tiempo_reaccion <= (VENTANA_ACIERTO_MS * 0.5)) ? 2 : 1;
+            puntuacion += (tiempo_reaccion <= VENTANA_PERFECTO_MS) ? 2 : 1;
         }
     } else {
         puntuacion -= 1;
@@ -304,25 +301,17 @@ static void mostrar_patron_actual(void) {
 }
 
 static void apagar_todos_leds(void) {
-    drv_led_establecer(LED_1, LED_OFF);
-    drv_led_establecer(LED_2, LED_OFF);
-    drv_led_establecer(LED_3, LED_OFF);
-    drv_led_establecer(LED_4, LED_OFF);
+    drv_leds_escribir_mascara(0x00);
 }
 
 static void configurar_leds_patron(uint8_t patron_top, uint8_t patron_bottom) {
-    drv_led_establecer(LED_1, (patron_top & 0x01) ? LED_ON : LED_OFF);
-    drv_led_establecer(LED_2, (patron_top & 0x02) ? LED_ON : LED_OFF);
-    drv_led_establecer(LED_3, (patron_bottom & 0x01) ? LED_ON : LED_OFF);
-    drv_led_establecer(LED_4, (patron_bottom & 0x02) ? LED_ON : LED_OFF);
+    // LED_1/LED_2 = fila superior, LED_3/LED_4 = fila inferior
+    drv_leds_escribir_mascara((uint8_t)((patron_top & 0x03) | ((patron_bottom & 0x03) << 2)));
 }
 
 static void iniciar_secuencia_fin(void) {
     // Secuencia de fin simple: LEDs se apagan en secuencia
-    drv_led_establecer(LED_1, LED_ON);
-    drv_led_establecer(LED_2, LED_ON);
-    drv_led_establecer(LED_3, LED_ON);
-    drv_led_establecer(LED_4, LED_ON);
+    drv_leds_escribir_mascara(0x0F);
     
     svc_alarma_activar(svc_alarma_codificar(false, 100, 0),
                       ev_BEAT_TIMEOUT, ID_TIMEOUT_FIN);
@@ -334,7 +323,7 @@ static void iniciar_secuencia_fin(void) {
 
 static void dormir_sistema(void) {
     apagar_todos_leds();
-		drv_consumo_dormir();
+    svc_energia_solicitar_apagado();
     
     esperando_reinicio = true;
 }
@@ -15,11 +15,16 @@
 #include "drv_leds.h"
 #include "drv_botones.h"
 #include "drv_tiempo.h"
-#include "drv_consumo.h" 
+#include "svc_energia.h"
+#include "svc_instantanea.h"
 #include "svc_GE.h"
 #include "svc_alarmas.h"
 #include "hal_random.h"
 #include "rt_GE.h"
+#include "svc_grabacion.h"
+#include "beat_chart.h"
+#include "rt_fsm.h"
+#include "svc_kv.h"
 #include <stddef.h>
 
 #ifndef DEBUG
@@ -28,7 +33,8 @@
 
 #if DEBUG
 #include "drv_uart.h"
-#include <stdio.h>
+#include "svc_logs.h"
+#include "svc_shell.h"
 #endif
 
 // ============================================================================
@@ -37,27 +43,52 @@
 
 #define NUM_COMPASES        15
 #define BPM_INICIAL         50
-#define COMPAS_MS           (60000 / BPM_INICIAL)
-#define VENTANA_ACIERTO_MS  (COMPAS_MS * 0.4)
-#define VENTANA_PERFECTO_MS (VENTANA_ACIERTO_MS * 0.2)
+#define BPM_MIN             30      // rangos de los parámetros de la shell
+#define BPM_MAX             200
+#define COMPASES_MIN        4
+#define COMPASES_MAX        60
+
+// Fracciones de tiempo como num/den enteros (sin coma flotante: el LPC2105
+// no tiene FPU). Se aplican una vez al empezar la partida.
+#define VENTANA_ACIERTO_NUM   2     // ventana de acierto  = 2/5 del compás
+#define VENTANA_ACIERTO_DEN   5
+#define VENTANA_PERFECTO_NUM  1     // ventana de perfecto = 1/5 de la de acierto
+#define VENTANA_PERFECTO_DEN  5
+#define COMPAS_EXTENDIDO_NUM  3     // últimos compases    = 3/2 del compás
+#define COMPAS_EXTENDIDO_DEN  2
 #define TIEMPO_ENTRE_COMPASES 150
 #define PUNTUACION_EXITO    20
 #define PUNTUACION_FALLO    -8
 #define TIEMPO_TRANSICION   80
-#define TIEMPO_EXTENDIDO_MULTIPLICADOR 1.5
+#define RETARDO_PRIMER_COMPAS 400
+
+// Eventos de la máquina de estados del juego (rt_fsm)
+enum {
+    EV_BOTON,           // BOTON_1/2
+    EV_SALIR,           // BOTON_3/4
+    EV_COMPAS,          // fin del compás (alarma)
+    EV_TRANSICION,      // fin del apagado entre compases (alarma)
+    EV_FIN_INICIO,      // fin de la animación de inicio
+    EV_FIN_ANIMACION,   // fin de la animación de fin
+    EV_REINICIO,        // pulsación larga de BOTON_3/4
+    EV_ACORDE,          // acorde con BOTON_1 y BOTON_2
+    EV_FIN_JUEGO,       // lanzado al cerrar el último compás
+    NUM_EVENTOS
+};
+
+// IDs de timeouts: el aux de cada alarma/animación lleva el evento que provoca
+#define ID_EVENTO(e)        (0xF0u | (uint32_t)(e))
+#define ID_TIMEOUT_COMPAS   ID_EVENTO(EV_COMPAS)
+#define ID_TIMEOUT_INACTIVO ID_EVENTO(EV_FIN_INICIO)
+#define ID_TIMEOUT_FIN      ID_EVENTO(EV_FIN_ANIMACION)
+#define ID_TRANSICION       ID_EVENTO(EV_TRANSICION)
 
-// IDs de timeouts
-#define ID_TIMEOUT_COMPAS   0xFE
-#define ID_TIMEOUT_INACTIVO 0xFD
-#define ID_TIMEOUT_FIN      0xFC
-#define ID_TRANSICION       0xFB
-#define ID_LONGPRESS        0xFA
+// Pulsacion larga de BOTON_3/4 que fuerza el reinicio
+#define TIEMPO_LONGPRESS    3000
 
-// Mapping LEDs
-#define LED_1   ((LED_id_t)1)
-#define LED_2   ((LED_id_t)2)
-#define LED_3   ((LED_id_t)3)
-#define LED_4   ((LED_id_t)4)
+// Calidad del acierto: fundido en los LEDs del compás actual (fila inferior)
+#define LED_FILA_INFERIOR   3
+#define TIEMPO_FUNDIDO      250
 
 // Patrones
 #define PATRON_LED_1        0x01
@@ -65,6 +96,10 @@
 #define PATRON_AMBOS        0x03
 #define PATRON_NINGUNO      0x00
 
+// Claves del almacén persistente (svc_kv)
+#define KV_HISTORICO        0
+#define KV_PARAMETROS       1
+
 // Botones
 #define BOTON_1             0
 #define BOTON_2             1
@@ -74,14 +109,12 @@
 
 
 #if DEBUG
-static char buffer[128];
-#define LOG_MSG(msg) do { sprintf(buffer, "[GAME] %s\r\n", msg); drv_uart_send(buffer); } while(0)
-#define LOG_VAR(label, val) do { sprintf(buffer, "[GAME] %s: %d\r\n", label, val); drv_uart_send(buffer); } while(0)
-#define LOG_STATE(st) do { sprintf(buffer, "[FSM] Cambio a Estado: %d\r\n", st); drv_uart_send(buffer); } while(0)
+// Logs no bloqueantes: si la UART va saturada se descartan y se contabilizan
+#define LOG_MSG(msg) svc_logs_printf(LOG_LEVEL_DEBUG, "[GAME] %s\r\n", msg)
+#define LOG_VAR(label, val) svc_logs_printf(LOG_LEVEL_DEBUG, "[GAME] %s: %d\r\n", label, val)
 #else
 #define LOG_MSG(msg)
 #define LOG_VAR(label, val)
-#define LOG_STATE(st)
 #endif
 
 // ============================================================================
@@ -89,14 +122,14 @@ static char buffer[128];
 // ============================================================================
 #if DEBUG
 typedef struct {
-    uint8_t compases_acertados;
-    uint8_t compases_fallados;
-    uint8_t compases_perfectos;
-    uint8_t compases_sin_respuesta;
-    uint8_t pulsaciones_correctas;
-    uint8_t pulsaciones_incorrectas;  
-    uint8_t total_compases_activos; 
-    uint8_t aciertos_activos;       
+    uint16_t compases_acertados;
+    uint16_t compases_fallados;
+    uint16_t compases_perfectos;
+    uint16_t compases_sin_respuesta;
+    uint16_t pulsaciones_correctas;
+    uint16_t pulsaciones_incorrectas;  
+    uint16_t total_compases_activos; 
+    uint16_t aciertos_activos;       
     bool compas_actual_acertado;
     bool compas_actual_perfecto;
 } estadisticas_t;
@@ -109,40 +142,122 @@ static estadisticas_t stats;
 // ============================================================================
 
 static uint8_t compas[3];
-static uint8_t compases_restantes;
-static uint8_t compas_actual;
-static estado_juego_t estado_actual;
+static uint16_t compas_bpm[3];      // tempo de cada compas de la ventana
+static uint16_t compases_restantes;
+static uint16_t compas_actual;
+static rt_fsm_t fsm;
 static int32_t puntuacion;
 static uint32_t tiempo_inicio_compas;
 static uint8_t nivel;
 static bool entrada_valida;
 static uint8_t patron_esperado_actual;
-static bool esperando_reinicio;
-static uint8_t etapa_secuencia_fin;
 static bool en_transicion;
-static uint8_t paso_inicio;
 
-static bool longpress_en_curso = false;
-static int boton_longpress_activo = -1;
+// Parámetros ajustables en caliente desde la shell ("set bpm 80").
+// Se aplican al reiniciar la partida (tiempos precalculados).
+// cancion = 0: compases aleatorios (bpm y compases); 1: partitura demo.
+static uint32_t param_bpm = BPM_INICIAL;
+static uint32_t param_compases = NUM_COMPASES;
+static uint32_t param_cancion = 0;
+static uint16_t compases_partida;
+
+// Persistente (flash): sobrevive al SYSTEM OFF y a los reinicios del WDT.
+// Los contadores de compases solo se acumulan con DEBUG (vienen de stats).
+typedef struct {
+    uint32_t partidas;
+    int32_t  record;
+    uint32_t compases_acertados;
+    uint32_t compases_perfectos;
+    uint32_t compases_sin_respuesta;
+} historico_t;
+
+static historico_t historico;
+
+// Instantánea en RAM retenida (svc_instantanea): al despertar de SYSTEM OFF
+// se recupera en lugar de leer la flash y la partida empieza sin la
+// animación de inicio, con la puntuación y el nivel de la que se apagó a
+// medias (0 y 1 si no había ninguna en juego).
+typedef struct {
+    historico_t historico;
+    uint32_t    parametros[3];      // bpm, compases, cancion
+    int32_t     puntuacion;         // partida en juego al apagar
+    uint8_t     nivel;
+} instantanea_t;
 
-static const uint8_t FIN_MASK[] = {
-    0x05, 0x00, 0x05, 0x00, 0x0A, 0x00, 0x0A, 0x00, 0x0F, 0x00, 0x0F
+static bool reanudado = false;
+static int32_t puntuacion_reanudada;
+static uint8_t nivel_reanudado;
+static bool primer_compas_medido = false;
+
+// Fuente de compases: partitura en flash o generador aleatorio
+static beat_chart_t chart;
+
+// Tiempos de la partida en ms, precalculados en reiniciar_juego()
+typedef struct {
+    uint16_t bpm;
+    uint32_t compas;
+    uint32_t compas_extendido;
+    uint32_t ventana_acierto;
+    uint32_t ventana_perfecto;
+} tiempos_partida_t;
+
+static tiempos_partida_t tiempos;
+
+// Reloj de compases: cada fase se programa contra instantes absolutos (ms)
+// derivados del inicio de la canción y del tempo, no contra "ahora", así el
+// retraso de despacho de un compás no se arrastra a los siguientes.
+//   ancla_compas            inicio del compás (fase SHOW)
+//   + TIEMPO_ENTRE_COMPASES transición
+//   + TIEMPO_TRANSICION     ancla_espera: ventana de entrada (el beat)
+//   + duración del compás   ancla del compás siguiente
+static uint32_t ancla_compas;
+static uint32_t ancla_espera;
+
+#if DEBUG
+// Retraso de cada fase respecto a su ancla
+typedef struct {
+    uint32_t max;
+    uint32_t suma;      // lo que se habría acumulado encadenando alarmas
+    uint32_t ultimo;    // deriva real al final de la sesión
+    uint16_t muestras;
+} deriva_t;
+
+static deriva_t deriva;
+#endif
+
+// Animaciones (drv_leds): un solo evento de fin por animación
+static const drv_leds_fotograma_t FOTOGRAMAS_INICIO[] = {
+    { 0x00, 300 }, { 0x05, 250 }, { 0x0A, 250 }, { 0x05, 250 }, { 0x0A, 250 }
+};
+static const drv_leds_animacion_t ANIM_INICIO = {
+    FOTOGRAMAS_INICIO, DRV_LEDS_NUM_FOTOGRAMAS(FOTOGRAMAS_INICIO), 1
+};
+
+static const drv_leds_fotograma_t FOTOGRAMAS_FIN[] = {
+    { 0x00, 200 },
+    { 0x05, 300 }, { 0x00, 300 }, { 0x05, 300 }, { 0x00, 300 },
+    { 0x0A, 300 }, { 0x00, 300 }, { 0x0A, 300 }, { 0x00, 300 },
+    { 0x0F, 300 }, { 0x00, 300 }, { 0x0F, 800 }
+};
+static const drv_leds_animacion_t ANIM_FIN = {
+    FOTOGRAMAS_FIN, DRV_LEDS_NUM_FOTOGRAMAS(FOTOGRAMAS_FIN), 1
 };
 
 // ============================================================================
 // PROTOTIPOS
 // ============================================================================
 
-static void juego_fsm(EVENTO_T ev, uint32_t aux);
-static void procesar_estado_init(bool es_timeout_inactivo, bool es_boton);
-static void procesar_estado_show_sequence(bool es_timeout_compas, bool es_transicion,
-                                          bool es_boton_salida, bool es_boton);
-static void procesar_estado_wait_for_input(bool es_boton_salida, bool es_boton,
-                                           bool es_timeout_compas, uint32_t aux);
-static void procesar_estado_fin_partida(bool es_timeout_inactivo, bool es_timeout_fin,
-                                        bool es_boton_salida, bool es_boton, uint32_t aux);
+static const rt_fsm_def_t FSM_JUEGO;     // tabla en la sección FSM
+static void empezar_partida(uint32_t aux); // también al reanudar
+
+static void juego_cb(EVENTO_T ev, uint32_t aux);
+static uint8_t clasificar_evento(EVENTO_T ev, uint32_t aux);
+static void terminar_secuencia_fin(void);
+static void cancelar_fases(void);
 
 static void generar_nuevo_compas(void);
+static uint8_t generar_patron_aleatorio(void);
+static void abrir_cancion(void);
 static void avanzar_compas(void);
 static bool verificar_fin_juego(void);
 static void aumentar_dificultad_si_corresponde(void);
@@ -153,29 +268,35 @@ static int calcular_puntos_por_timing(uint32_t tiempo_reaccion);
 static void procesar_acierto(int puntos, uint32_t tiempo_reaccion);
 static void procesar_fallo(void);
 static void evaluar_compas_sin_entrada(void);
+static uint32_t calcular_reaccion(uint8_t boton);
 
 static void mostrar_transicion(void);
 static void mostrar_patron_final(void);
 static void apagar_todos_leds(void);
 static void configurar_leds_patron(uint8_t patron_top, uint8_t patron_bottom);
-static void configurar_leds_por_mask(uint8_t mask);
+static void mostrar_calidad_acierto(int puntos);
 
 static void iniciar_secuencia_fin(void);
-static void avanzar_secuencia_fin(void);
-static void configurar_leds_etapa_fin(uint8_t etapa);
 static void iniciar_secuencia_inicio(void);
 
 static void reiniciar_juego(void);
 static void inicializar_drivers(void);
+static void cargar_persistentes(void);
+static bool restaurar_instantanea(void);
+static void guardar_instantanea(void);
+static void guardar_partida(void);
 static void inicializar_compases(void);
+static void precalcular_tiempos(uint32_t bpm);
+static void programar_fase(uint32_t vencimiento, uint32_t id);
+static void medir_deriva(uint32_t vencimiento);
 
 #if DEBUG
 static void inicializar_estadisticas(void);
 static void resetear_estadisticas_compas_actual(void);
 static void actualizar_estadisticas_compas(void);
 static void mostrar_estadisticas_finales(void);
-static float calcular_porcentaje(uint8_t valor, uint8_t total);
-static const char* evaluar_rendimiento(float porcentaje_aciertos);
+static uint32_t calcular_por_mil(uint16_t valor, uint16_t total);
+static const char* evaluar_rendimiento(uint32_t por_mil_aciertos);
 #endif
 
 // ============================================================================
@@ -187,36 +308,68 @@ void beat_hero_extend_iniciar(void) {
     
     rt_GE_iniciar(10);
     inicializar_drivers();
+    reanudado = restaurar_instantanea();
+    if (!reanudado) cargar_persistentes();
+    svc_energia_registrar_aviso(guardar_instantanea);
+
+    #if DEBUG
+    svc_shell_iniciar(ev_UART_LINEA);
+    svc_shell_registrar_parametro("bpm", &param_bpm, BPM_MIN, BPM_MAX);
+    svc_shell_registrar_parametro("compases", &param_compases, COMPASES_MIN, COMPASES_MAX);
+    svc_shell_registrar_parametro("cancion", &param_cancion, 0, 1);
+    svc_shell_registrar_fsm(&FSM_JUEGO);
+    svc_shell_registrar_fsm(drv_botones_fsm());
+    #endif
+
     reiniciar_juego();
     
-    svc_GE_suscribir(ev_PULSAR_BOTON, 2, juego_fsm);
-    svc_GE_suscribir(ev_BOTON_RETARDO, 2, juego_fsm);
-
-    iniciar_secuencia_inicio();
+    svc_GE_suscribir(ev_PULSAR_BOTON, 2, juego_cb);
+    svc_GE_suscribir(ev_BOTON_GESTO, 2, juego_cb);
+
+    if (reanudado) {
+        // Sin animación de inicio: directamente al primer compás
+        LOG_VAR("Reanudado tras SYSTEM OFF", svc_instantanea_reanudaciones());
+        puntuacion = puntuacion_reanudada;
+        nivel = nivel_reanudado;
+        rt_fsm_iniciar(&fsm, &FSM_JUEGO, e_SHOW_SEQUENCE);
+        empezar_partida(0);
+    } else {
+        rt_fsm_iniciar(&fsm, &FSM_JUEGO, e_INIT);
+    }
     rt_GE_lanzador();
 }
 
 static void inicializar_drivers(void) {
     drv_leds_iniciar();
-    drv_botones_iniciar(NULL, ev_PULSAR_BOTON, ev_PULSAR_BOTON);
-    hal_random_iniciar(drv_tiempo_actual_ms());
+    drv_botones_config_t cfg = DRV_BOTONES_CONFIG_DEFECTO;
+
+    drv_botones_iniciar(NULL, ev_PULSAR_BOTON, ev_SOLTAR_BOTON);
+    cfg.larga_ms = TIEMPO_LONGPRESS;
+    drv_botones_configurar(&cfg);
+
+    // Origen de tiempos de la grabacion/reproduccion (si esta activa)
+    svc_grabacion_iniciar();
+    hal_random_iniciar(svc_grabacion_semilla(drv_tiempo_actual_ms()));
 }
 
 static void reiniciar_juego(void) {
     LOG_MSG("Reiniciando variables de juego...");
 
-    estado_actual = e_INIT;
+    // Parámetros de la shell: solo se escriben si han cambiado
+    uint32_t parametros[3] = { param_bpm, param_compases, param_cancion };
+    svc_kv_escribir(KV_PARAMETROS, parametros, sizeof(parametros));
+
     puntuacion = 0;
     nivel = 1;
-    compases_restantes = NUM_COMPASES;
+    abrir_cancion();
+    compases_restantes = compases_partida;
     compas_actual = 0;
-    esperando_reinicio = false;
-    etapa_secuencia_fin = 0;
     en_transicion = false;
-    paso_inicio = 0;
 
     #if DEBUG
     inicializar_estadisticas();
+    deriva.max = deriva.suma = deriva.ultimo = 0;
+    deriva.muestras = 0;
     #else
     entrada_valida = false;
     #endif
@@ -225,225 +378,423 @@ static void reiniciar_juego(void) {
     apagar_todos_leds();
 }
 
+// La partitura trae su longitud; se suman los dos compases de entrada
+// (la ventana muestra cada compás dos pasos antes de juzgarlo).
+static void abrir_cancion(void) {
+    if (param_cancion != 0 && beat_chart_abrir(&chart, beat_chart_demo, beat_chart_demo_tam)) {
+        compases_partida = (uint16_t)(beat_chart_compases(&chart) + 2u);
+        precalcular_tiempos(beat_chart_ver(&chart, 0).bpm);
+    } else {
+        beat_chart_abrir_generador(&chart, 0xFFFFu, (uint16_t)param_bpm,
+                                   generar_patron_aleatorio);
+        compases_partida = (uint16_t)param_compases;
+        precalcular_tiempos(param_bpm);
+    }
+}
+
+static void programar_fase(uint32_t vencimiento, uint32_t id) {
+    svc_alarma_activar_en(vencimiento, ev_PULSAR_BOTON, id);
+}
+
+static void medir_deriva(uint32_t vencimiento) {
+    #if DEBUG
+    uint32_t ahora = drv_tiempo_actual_ms();
+    uint32_t retraso = ((int32_t)(ahora - vencimiento) > 0) ? ahora - vencimiento : 0;
+    if (retraso > deriva.max) deriva.max = retraso;
+    deriva.suma += retraso;
+    deriva.ultimo = retraso;
+    deriva.muestras++;
+    #else
+    (void)vencimiento;
+    #endif
+}
+
+static void precalcular_tiempos(uint32_t bpm) {
+    tiempos.bpm              = (uint16_t)bpm;
+    tiempos.compas           = 60000u / bpm;
+    tiempos.compas_extendido = (tiempos.compas * COMPAS_EXTENDIDO_NUM) / COMPAS_EXTENDIDO_DEN;
+    tiempos.ventana_acierto  = (tiempos.compas * VENTANA_ACIERTO_NUM) / VENTANA_ACIERTO_DEN;
+    tiempos.ventana_perfecto = (tiempos.ventana_acierto * VENTANA_PERFECTO_NUM) / VENTANA_PERFECTO_DEN;
+}
+
 static void inicializar_compases(void) {
-    for(int i = 0; i < 3; i++) compas[i] = 0;
-    for(int i = 0; i < 3; i++) generar_nuevo_compas();
+    for(int i = 0; i < 3; i++) {
+        compas[i] = 0;
+        compas_bpm[i] = tiempos.bpm;
+    }
+    generar_nuevo_compas();
+}
+
+// Récord, histórico y parámetros guardados en flash. Un valor ausente o de
+// otra versión (longitud distinta) se ignora.
+static void cargar_persistentes(void) {
+    uint32_t parametros[3];
+
+    svc_kv_iniciar();
+    if (svc_kv_leer(KV_HISTORICO, &historico, sizeof(historico)) != sizeof(historico)) {
+        historico = (historico_t){ 0, PUNTUACION_FALLO - 1, 0, 0, 0 };
+    }
+    if (svc_kv_leer(KV_PARAMETROS, parametros, sizeof(parametros)) == sizeof(parametros)
+        && parametros[0] >= BPM_MIN && parametros[0] <= BPM_MAX
+        && parametros[1] >= COMPASES_MIN && parametros[1] <= COMPASES_MAX
+        && parametros[2] <= 1) {
+        param_bpm      = parametros[0];
+        param_compases = parametros[1];
+        param_cancion  = parametros[2];
+    }
+    LOG_VAR("Record", historico.record);
+}
+
+// Al despertar de SYSTEM OFF: los mismos valores que la flash, pero sin
+// leerla. La flash se monta igual para las escrituras posteriores.
+static bool restaurar_instantanea(void) {
+    instantanea_t inst;
+
+    if (!svc_instantanea_iniciar() ||
+        svc_instantanea_recuperar(&inst, sizeof(inst)) != sizeof(inst)) return false;
+
+    svc_kv_iniciar();
+    historico      = inst.historico;
+    param_bpm      = inst.parametros[0];
+    param_compases = inst.parametros[1];
+    param_cancion  = inst.parametros[2];
+    puntuacion_reanudada = inst.puntuacion;
+    nivel_reanudado = (inst.nivel >= 1 && inst.nivel <= 4) ? inst.nivel : 1;
+    LOG_VAR("Puntuacion reanudada", puntuacion_reanudada);
+    return true;
+}
+
+// Aviso de svc_energia justo antes de apagar. Una partida terminada ya
+// está en el histórico: solo se guarda la puntuación de una a medias.
+static void guardar_instantanea(void) {
+    uint8_t estado = rt_fsm_estado(&fsm);
+    bool en_juego = (estado == e_SHOW_SEQUENCE || estado == e_WAIT_FOR_INPUT);
+    instantanea_t inst = {
+        historico, { param_bpm, param_compases, param_cancion },
+        en_juego ? puntuacion : 0, en_juego ? nivel : 1
+    };
+    svc_instantanea_guardar(&inst, sizeof(inst));
+}
+
+// Se escribe antes de dormir: la instantánea solo sobrevive al SYSTEM OFF,
+// no a un corte de alimentación ni al WDT
+static void guardar_partida(void) {
+    historico.partidas++;
+    if (puntuacion > historico.record) {
+        historico.record = puntuacion;
+        LOG_VAR("NUEVO RECORD", puntuacion);
+    }
+    #if DEBUG
+    historico.compases_acertados     += stats.compases_acertados;
+    historico.compases_perfectos     += stats.compases_perfectos;
+    historico.compases_sin_respuesta += stats.compases_sin_respuesta;
+    #endif
+
+    svc_kv_escribir(KV_HISTORICO, &historico, sizeof(historico));
+    svc_kv_sincronizar();
 }
 
 static void iniciar_secuencia_inicio(void) {
-    paso_inicio = 0;
-    svc_alarma_activar(svc_alarma_codificar(false, 300, 0), 
-                       ev_PULSAR_BOTON, ID_TIMEOUT_INACTIVO);
+    drv_leds_animar(&ANIM_INICIO, ev_PULSAR_BOTON, ID_TIMEOUT_INACTIVO);
 }
 
 // ============================================================================
 // MÁQUINA DE ESTADOS (FSM)
 // ============================================================================
+// Tabla de rt_fsm. Las decisiones que dependen de la partida (¿era el último
+// compás?) las toma la acción y las comunica lanzando un evento (EV_FIN_JUEGO).
+
+static void entrar_inicio(uint32_t aux);
+static void entrar_fin_partida(uint32_t aux);
+static void entrar_esperando(uint32_t aux);
+
+static bool fuera_de_transicion(uint32_t aux);
+static bool dentro_de_transicion(uint32_t aux);
+static bool cuenta_pulsacion(uint32_t aux);
+static bool acorde_esperado(uint32_t aux);
+
+static void empezar_partida(uint32_t aux);
+static void iniciar_transicion(uint32_t aux);
+static void mostrar_compas(uint32_t aux);
+static void cerrar_compas(uint32_t aux);
+static void pulsar(uint32_t aux);
+static void juzgar_acorde(uint32_t aux);
+static void abandonar(uint32_t aux);
+static void saltar_animacion(uint32_t aux);
+static void reinicio_forzado(uint32_t aux);
+static void despertar(uint32_t aux);
+static void dormir(uint32_t aux);
+
+#define NUM_ESTADOS (e_ESPERANDO_REINICIO + 1)
+
+static const rt_fsm_estado_t ESTADOS[NUM_ESTADOS] = {
+    [e_INIT]               = { "INIT",       entrar_inicio,      NULL },
+    [e_SHOW_SEQUENCE]      = { "SHOW",       NULL,               NULL },
+    [e_WAIT_FOR_INPUT]     = { "WAIT",       NULL,               NULL },
+    [e_FIN_PARTIDA]        = { "FIN",        entrar_fin_partida, NULL },
+    [e_ESPERANDO_REINICIO] = { "ESPERANDO",  entrar_esperando,   NULL },
+};
 
-static void juego_fsm(EVENTO_T ev, uint32_t aux) {
-    const bool es_evento_boton = (ev == ev_PULSAR_BOTON);
-    const bool es_longpress_timer = (ev == ev_BOTON_RETARDO && aux == ID_LONGPRESS);
+static const char * const EVENTOS[NUM_EVENTOS] = {
+    "BOTON", "SALIR", "COMPAS", "TRANSICION", "FIN_INICIO",
+    "FIN_ANIMACION", "REINICIO", "ACORDE", "FIN_JUEGO"
+};
 
-    const bool es_timeout_compas = (es_evento_boton && aux == ID_TIMEOUT_COMPAS);
-    const bool es_timeout_inactivo = (es_evento_boton && aux == ID_TIMEOUT_INACTIVO);
-    const bool es_timeout_fin = (es_evento_boton && aux == ID_TIMEOUT_FIN);
-    const bool es_transicion = (es_evento_boton && aux == ID_TRANSICION);
-    const bool es_boton = (es_evento_boton && aux < 4);
-    const bool es_boton_salida = (es_boton && (aux == BOTON_3 || aux == BOTON_4));
+static const rt_fsm_transicion_t TABLA[NUM_ESTADOS][NUM_EVENTOS] = {
+    [e_INIT] = {
+        [EV_FIN_INICIO]    = RT_FSM_T(NULL, empezar_partida, e_SHOW_SEQUENCE),
+        [EV_REINICIO]      = RT_FSM_T(NULL, reinicio_forzado, e_INIT),
+    },
+    [e_SHOW_SEQUENCE] = {
+        [EV_COMPAS]        = RT_FSM_T(fuera_de_transicion, iniciar_transicion, RT_FSM_INTERNA),
+        [EV_TRANSICION]    = RT_FSM_T(dentro_de_transicion, mostrar_compas, e_WAIT_FOR_INPUT),
+        [EV_SALIR]         = RT_FSM_T(NULL, abandonar, e_FIN_PARTIDA),
+        [EV_FIN_JUEGO]     = RT_FSM_IR(e_FIN_PARTIDA),
+        [EV_REINICIO]      = RT_FSM_T(NULL, reinicio_forzado, e_INIT),
+    },
+    [e_WAIT_FOR_INPUT] = {
+        [EV_BOTON]         = RT_FSM_T(cuenta_pulsacion, pulsar, RT_FSM_INTERNA),
+        [EV_ACORDE]        = RT_FSM_T(acorde_esperado, juzgar_acorde, RT_FSM_INTERNA),
+        [EV_COMPAS]        = RT_FSM_T(NULL, cerrar_compas, e_SHOW_SEQUENCE),
+        [EV_SALIR]         = RT_FSM_T(NULL, abandonar, e_FIN_PARTIDA),
+        [EV_REINICIO]      = RT_FSM_T(NULL, reinicio_forzado, e_INIT),
+    },
+    [e_FIN_PARTIDA] = {
+        [EV_FIN_ANIMACION] = RT_FSM_IR(e_ESPERANDO_REINICIO),
+        [EV_BOTON]         = RT_FSM_T(NULL, saltar_animacion, e_ESPERANDO_REINICIO),
+        [EV_SALIR]         = RT_FSM_T(NULL, saltar_animacion, e_ESPERANDO_REINICIO),
+        [EV_REINICIO]      = RT_FSM_T(NULL, reinicio_forzado, e_INIT),
+    },
+    [e_ESPERANDO_REINICIO] = {
+        [EV_SALIR]         = RT_FSM_T(NULL, despertar, e_INIT),
+        [EV_BOTON]         = RT_FSM_HACER(dormir),        // falso despertar
+    },
+};
 
-    #if DEBUG
-    // Descomentar si se quiere loguear CADA evento
-    // sprintf(buffer, "[FSM] Estado: %d, Evento: 0x%lX\r\n", estado_actual, aux); drv_uart_send(buffer);
-    #endif
+#if DEBUG
+static void traza_fsm(const rt_fsm_t *m, uint8_t origen, uint8_t evento) {
+    svc_logs_printf(LOG_LEVEL_DEBUG, "[FSM] %s -> %s (%s)\r\n", ESTADOS[origen].nombre,
+                    ESTADOS[rt_fsm_estado(m)].nombre, EVENTOS[evento]);
+}
+#define TRAZA_FSM traza_fsm
+#else
+#define TRAZA_FSM NULL
+#endif
+
+static const rt_fsm_def_t FSM_JUEGO = {
+    "beat_hero", ESTADOS, NUM_ESTADOS, EVENTOS, NUM_EVENTOS, &TABLA[0][0], TRAZA_FSM
+};
 
-    if (es_longpress_timer) {
-        longpress_en_curso = false;
-        int btn = boton_longpress_activo;
-        boton_longpress_activo = -1;
+static void juego_cb(EVENTO_T ev, uint32_t aux) {
+    rt_fsm_evento(&fsm, clasificar_evento(ev, aux), aux);
+}
 
-        if (btn >= 0 && drv_boton_esta_pulsado((uint8_t)btn)) {
-            LOG_MSG("Reinicio forzado por Long-Press!");
-            reiniciar_juego();
-            iniciar_secuencia_inicio();
-        }
-        return;
-    }
+static const uint8_t EVENTO_BOTON[4] = {
+    [BOTON_1] = EV_BOTON, [BOTON_2] = EV_BOTON, [BOTON_3] = EV_SALIR, [BOTON_4] = EV_SALIR
+};
 
-    if (es_boton && (aux == BOTON_3 || aux == BOTON_4) && !longpress_en_curso && !esperando_reinicio) {
-        longpress_en_curso = true;
-        boton_longpress_activo = (int)aux;
-        svc_alarma_activar(svc_alarma_codificar(false, 3000, 0), ev_BOTON_RETARDO, ID_LONGPRESS);
-    }
-    // -------------------------------------------------
-
-    switch (estado_actual) {
-        case e_INIT:
-            procesar_estado_init(es_timeout_inactivo, es_boton);
-            break;
-
-        case e_SHOW_SEQUENCE:
-            procesar_estado_show_sequence(es_timeout_compas, es_transicion,
-                                          es_boton_salida, es_boton);
-            break;
-
-        case e_WAIT_FOR_INPUT:
-            procesar_estado_wait_for_input(es_boton_salida, es_boton,
-                                           es_timeout_compas, aux);
-            break;
-
-        case e_FIN_PARTIDA:
-            procesar_estado_fin_partida(es_timeout_inactivo, es_timeout_fin,
-                                        es_boton_salida, es_boton, aux);
-            break;
+// Traduce (ev, aux) del gestor de eventos a un evento de la tabla
+static uint8_t clasificar_evento(EVENTO_T ev, uint32_t aux) {
+    // Pulsación larga y acordes los reconoce drv_botones en su muestreo
+    if (ev == ev_BOTON_GESTO) {
+        drv_boton_gesto_t tipo = DRV_BOTON_GESTO_TIPO(aux);
+        uint8_t dato = DRV_BOTON_GESTO_DATO(aux);
+
+        if (tipo == DRV_BOTON_GESTO_LARGA && (dato == BOTON_3 || dato == BOTON_4))
+            return EV_REINICIO;
+        if (tipo == DRV_BOTON_GESTO_ACORDE && (dato & PATRON_AMBOS) == PATRON_AMBOS)
+            return EV_ACORDE;
+        return RT_FSM_NINGUNO;
     }
+
+    if (aux < 4) return EVENTO_BOTON[aux];
+    if ((aux & 0xF0u) == 0xF0u && (aux & 0x0Fu) < NUM_EVENTOS) return (uint8_t)(aux & 0x0Fu);
+    return RT_FSM_NINGUNO;
 }
 
-static void procesar_estado_init(bool es_timeout_inactivo, bool es_boton) {
-    if (es_timeout_inactivo) {
-        if (paso_inicio < 4) {
-            apagar_todos_leds();
-            if (paso_inicio % 2 == 0) {
-                drv_led_establecer(LED_1, LED_ON);
-                drv_led_establecer(LED_3, LED_ON);
-            } else {
-                drv_led_establecer(LED_2, LED_ON);
-                drv_led_establecer(LED_4, LED_ON);
-            }
-            paso_inicio++;
-            svc_alarma_activar(svc_alarma_codificar(false, 250, 0),
-                              ev_PULSAR_BOTON, ID_TIMEOUT_INACTIVO);
-        } else {
-            apagar_todos_leds();
-            LOG_MSG(">>> JUEGO COMENZADO <<<");
-            estado_actual = e_SHOW_SEQUENCE;
-            LOG_STATE(e_SHOW_SEQUENCE);
-            compas_actual = 0;
-            svc_alarma_activar(svc_alarma_codificar(false, 400, 0),
-                              ev_PULSAR_BOTON, ID_TIMEOUT_COMPAS);
-        }
-    }
+// --- Entradas de estado ---
+
+static void entrar_inicio(uint32_t aux) {
+    (void)aux;
+    iniciar_secuencia_inicio();
 }
 
-static void procesar_estado_show_sequence(bool es_timeout_compas, bool es_transicion,
-                                          bool es_boton_salida, bool es_boton) {
-    if (es_timeout_compas && !en_transicion) {
-        en_transicion = true;
-        mostrar_transicion();
-        svc_alarma_activar(svc_alarma_codificar(false, TIEMPO_TRANSICION, 0),
-                          ev_PULSAR_BOTON, ID_TRANSICION);
-    }
-    else if (es_transicion && en_transicion) {
-        mostrar_patron_final();
-        en_transicion = false;
+// Se llega por fin de partida, por SALIR o por reinicio: ninguna fase del
+// reloj de compases debe quedar pendiente.
+static void entrar_fin_partida(uint32_t aux) {
+    (void)aux;
+    cancelar_fases();
+    iniciar_secuencia_fin();
+}
 
-        if (compas_actual >= 1) {
-            patron_esperado_actual = compas[0];
-            #if DEBUG
-            resetear_estadisticas_compas_actual();
-            #else
-            entrada_valida = false;
-            #endif
-        } else {
-            patron_esperado_actual = 0;
-        }
+static void entrar_esperando(uint32_t aux) {
+    (void)aux;
+    terminar_secuencia_fin();
+}
 
-        tiempo_inicio_compas = drv_tiempo_actual_ms();
-        estado_actual = e_WAIT_FOR_INPUT;
-        LOG_STATE(e_WAIT_FOR_INPUT);
+// --- Guardas ---
 
-        uint32_t tiempo_compas = COMPAS_MS;
-        if (compases_restantes <= 3) {
-            tiempo_compas = COMPAS_MS * TIEMPO_EXTENDIDO_MULTIPLICADOR;
-        }
+static bool fuera_de_transicion(uint32_t aux) { (void)aux; return !en_transicion; }
+static bool dentro_de_transicion(uint32_t aux) { (void)aux; return en_transicion; }
 
-        svc_alarma_activar(svc_alarma_codificar(false, tiempo_compas, 0),
-                          ev_PULSAR_BOTON, ID_TIMEOUT_COMPAS);
-    }
-    else if (es_boton_salida) {
-        LOG_MSG("Usuario pulso SALIR (Btn 3/4)");
-        puntuacion = PUNTUACION_FALLO - 1;
-        iniciar_secuencia_fin();
-    }
+// Con PATRON_AMBOS las pulsaciones sueltas de 1/2 no cuentan: se espera al
+// gesto de acorde
+static bool cuenta_pulsacion(uint32_t aux) {
+    (void)aux;
+    return compas_actual >= 1 && patron_esperado_actual != PATRON_AMBOS;
+}
+
+static bool acorde_esperado(uint32_t aux) {
+    (void)aux;
+    return compas_actual >= 1 && patron_esperado_actual == PATRON_AMBOS;
+}
+
+// --- Acciones ---
+
+// Fin de la animación de inicio
+static void empezar_partida(uint32_t aux) {
+    (void)aux;
+    apagar_todos_leds();
+    LOG_MSG(">>> JUEGO COMENZADO <<<");
+    compas_actual = 0;
+    // Origen del reloj de compases: la primera transición llega
+    // RETARDO_PRIMER_COMPAS después de arrancar
+    ancla_compas = drv_tiempo_actual_ms() + RETARDO_PRIMER_COMPAS - TIEMPO_ENTRE_COMPASES;
+    programar_fase(ancla_compas + TIEMPO_ENTRE_COMPASES, ID_TIMEOUT_COMPAS);
+}
+
+static void iniciar_transicion(uint32_t aux) {
+    (void)aux;
+    medir_deriva(ancla_compas + TIEMPO_ENTRE_COMPASES);
+    en_transicion = true;
+    mostrar_transicion();
+    ancla_espera = ancla_compas + TIEMPO_ENTRE_COMPASES + TIEMPO_TRANSICION;
+    programar_fase(ancla_espera, ID_TRANSICION);
 }
 
-static void procesar_estado_wait_for_input(bool es_boton_salida, bool es_boton,
-                                           bool es_timeout_compas, uint32_t aux) {
-    if (es_boton_salida) {
-        LOG_MSG("Usuario pulso SALIR durante juego");
-        puntuacion = PUNTUACION_FALLO - 1;
-        iniciar_secuencia_fin();
+static void mostrar_compas(uint32_t aux) {
+    (void)aux;
+    medir_deriva(ancla_espera);
+    mostrar_patron_final();
+    en_transicion = false;
+
+    if (compas_actual >= 1) {
+        patron_esperado_actual = compas[0];
+        #if DEBUG
+        resetear_estadisticas_compas_actual();
+        #else
+        entrada_valida = false;
+        #endif
+    } else {
+        patron_esperado_actual = 0;
     }
-    else if (es_boton && compas_actual >= 1) {
-        evaluar_pulsacion((uint8_t)aux, drv_tiempo_actual_ms() - tiempo_inicio_compas);
+
+    // Cambio de tempo de la partitura: se aplica al compás que se juega
+    if (compas_bpm[0] != tiempos.bpm) {
+        precalcular_tiempos(compas_bpm[0]);
+        LOG_VAR("Tempo (bpm)", tiempos.bpm);
     }
-    else if (es_timeout_compas) {
-        if (compas_actual >= 1) {
-            evaluar_compas_sin_entrada();
-            #if DEBUG
-            actualizar_estadisticas_compas();
-            #endif
-        }
 
-        avanzar_compas();
-        aumentar_dificultad_si_corresponde();
+    // La reacción se mide desde el beat ideal, no desde el despacho
+    tiempo_inicio_compas = ancla_espera;
 
-        if (verificar_fin_juego()) {
-            estado_actual = e_FIN_PARTIDA;
-            LOG_STATE(e_FIN_PARTIDA);
-            iniciar_secuencia_fin();
-        } else {
-            estado_actual = e_SHOW_SEQUENCE;
-            LOG_STATE(e_SHOW_SEQUENCE);
-            svc_alarma_activar(svc_alarma_codificar(false, TIEMPO_ENTRE_COMPASES, 0),
-                              ev_PULSAR_BOTON, ID_TIMEOUT_COMPAS);
-        }
+    // Latencia del arranque (frío o reanudado) hasta el primer compás jugable
+    if (!primer_compas_medido) {
+        primer_compas_medido = true;
+        LOG_VAR(reanudado ? "Primer compas tras reanudar (ms)" : "Primer compas (ms)",
+                (int)drv_tiempo_actual_ms());
     }
-}
 
-static void procesar_estado_fin_partida(bool es_timeout_inactivo, bool es_timeout_fin,
-                                        bool es_boton_salida, bool es_boton, uint32_t aux) {
-    
-    // --- FASE ANIMACION ---
-    if (!esperando_reinicio) {
-        if (es_timeout_inactivo) {
-            avanzar_secuencia_fin();
-        }
-        else if (es_timeout_fin) {
-            LOG_MSG("Secuencia fin completada -> Durmiendo");
-            apagar_todos_leds();
-            esperando_reinicio = true;
+    uint32_t tiempo_compas = (compases_restantes <= 3) ? tiempos.compas_extendido
+                                                       : tiempos.compas;
 
-            #if DEBUG
-            mostrar_estadisticas_finales();
-            #endif
-            LOG_MSG("Sistema en SLEEP (Pulsa 3 o 4 para despertar)");
-            drv_consumo_dormir();
-        }
-        else if (es_boton) {
-            avanzar_secuencia_fin();
-        }
+    ancla_compas = ancla_espera + tiempo_compas;
+    programar_fase(ancla_compas, ID_TIMEOUT_COMPAS);
+}
+
+static void cerrar_compas(uint32_t aux) {
+    (void)aux;
+    medir_deriva(ancla_compas);
+    if (compas_actual >= 1) {
+        evaluar_compas_sin_entrada();
+        #if DEBUG
+        actualizar_estadisticas_compas();
+        #endif
     }
-    // --- FASE SLEEP ---
-    else {
-        if (es_boton && (aux == BOTON_3 || aux == BOTON_4)) {
-            LOG_MSG("Despertando por solicitud usuario!");
-            reiniciar_juego();
-            iniciar_secuencia_inicio();
-        } else {
-            // Falso despertar
-            drv_consumo_dormir();
-        }
+
+    avanzar_compas();
+    aumentar_dificultad_si_corresponde();
+
+    if (verificar_fin_juego()) {
+        rt_fsm_lanzar(&fsm, EV_FIN_JUEGO, 0);
+    } else {
+        programar_fase(ancla_compas + TIEMPO_ENTRE_COMPASES, ID_TIMEOUT_COMPAS);
     }
 }
 
+static void pulsar(uint32_t aux) {
+    evaluar_pulsacion((uint8_t)aux, calcular_reaccion((uint8_t)aux));
+}
+
+// Cuenta el flanco del acorde más cercano al inicio del compás
+static void juzgar_acorde(uint32_t aux) {
+    (void)aux;
+    uint32_t r1 = calcular_reaccion(BOTON_1);
+    uint32_t r2 = calcular_reaccion(BOTON_2);
+    evaluar_pulsacion(BOTON_1, (r1 < r2) ? r1 : r2);
+}
+
+static void abandonar(uint32_t aux) {
+    (void)aux;
+    LOG_MSG("Usuario pulso SALIR (Btn 3/4)");
+    puntuacion = PUNTUACION_FALLO - 1;
+}
+
+// Un botón salta la animación de fin
+static void saltar_animacion(uint32_t aux) {
+    (void)aux;
+    drv_leds_animacion_parar();
+}
+
+static void reinicio_forzado(uint32_t aux) {
+    (void)aux;
+    LOG_MSG("Reinicio forzado por Long-Press!");
+    cancelar_fases();
+    reiniciar_juego();
+}
+
+static void despertar(uint32_t aux) {
+    (void)aux;
+    LOG_MSG("Despertando por solicitud usuario!");
+    reiniciar_juego();
+}
+
+static void dormir(uint32_t aux) {
+    (void)aux;
+    svc_energia_solicitar_apagado();
+}
+
+static void cancelar_fases(void) {
+    svc_alarma_desactivar(ev_PULSAR_BOTON, ID_TIMEOUT_COMPAS);
+    svc_alarma_desactivar(ev_PULSAR_BOTON, ID_TRANSICION);
+    en_transicion = false;
+}
+
 // ============================================================================
 // LÓGICA DE JUEGO
 // ============================================================================
 
 static void generar_nuevo_compas(void) {
-    uint8_t nuevo_patron = (nivel == 1) ? 
-        ((hal_random(2) == 1) ? PATRON_LED_1 : PATRON_LED_2) : hal_random(4);
-    compas[2] = nuevo_patron;
+    beat_chart_compas_t nuevo = beat_chart_ver(&chart, 0);
+    beat_chart_avanzar(&chart);
+    compas[2] = nuevo.mascara;
+    compas_bpm[2] = nuevo.bpm;
+}
+
+// Fuente aleatoria (cancion = 0): depende del nivel alcanzado
+static uint8_t generar_patron_aleatorio(void) {
+    return (nivel == 1) ?
+        ((hal_random(2) == 1) ? PATRON_LED_1 : PATRON_LED_2) : (uint8_t)hal_random(4);
 }
 
 static void avanzar_compas(void) {
@@ -451,6 +802,8 @@ static void avanzar_compas(void) {
     compas_actual++;
     compas[0] = compas[1];
     compas[1] = compas[2];
+    compas_bpm[0] = compas_bpm[1];
+    compas_bpm[1] = compas_bpm[2];
     generar_nuevo_compas();
 }
 
@@ -467,7 +820,7 @@ static bool verificar_fin_juego(void) {
 }
 
 static void aumentar_dificultad_si_corresponde(void) {
-    if ((NUM_COMPASES - compases_restantes) % 4 == 0 && nivel < 4) {
+    if ((compases_partida - compases_restantes) % 4 == 0 && nivel < 4) {
         nivel++;
         LOG_VAR("Nivel aumentado", nivel);
     }
@@ -499,27 +852,36 @@ static void evaluar_pulsacion(uint8_t boton_pulsado, uint32_t tiempo_reaccion) {
     LOG_VAR("Puntuacion actual", puntuacion);
 }
 
+// Se juzga con el instante del flanco, no con el de despacho: así el
+// antirrebotes y la cola no penalizan la puntuación. Un flanco anterior al
+// inicio del compás se adelantó: cuenta lo que se adelantó, no 0.
+static uint32_t calcular_reaccion(uint8_t boton) {
+    uint32_t t_flanco_ms = (uint32_t)(drv_botones_ts_pulsacion(boton) / 1000u);
+    return (t_flanco_ms >= tiempo_inicio_compas) ? t_flanco_ms - tiempo_inicio_compas
+                                                 : tiempo_inicio_compas - t_flanco_ms;
+}
+
 static bool es_pulsacion_correcta(uint8_t boton_pulsado) {
     uint8_t boton_mask = (uint8_t)(1u << boton_pulsado);
     return (patron_esperado_actual & boton_mask) != 0;
 }
 
 static int calcular_puntos_por_timing(uint32_t tiempo_reaccion) {
-    if (tiempo_reaccion <= VENTANA_PERFECTO_MS) return 2;
-    else if (tiempo_reaccion <= VENTANA_ACIERTO_MS) return 1;
+    if (tiempo_reaccion <= tiempos.ventana_perfecto) return 2;
+    else if (tiempo_reaccion <= tiempos.ventana_acierto) return 1;
     else return 0;
 }
 
 static void procesar_acierto(int puntos, uint32_t tiempo_reaccion) {
     #if DEBUG
-    sprintf(buffer, "[JUEGO] ACIERTO! Puntos: +%d (T: %d ms)\r\n", puntos, tiempo_reaccion);
-    drv_uart_send(buffer);
+    svc_logs_printf(LOG_LEVEL_DEBUG, "[JUEGO] ACIERTO! Puntos: +%d (T: %d ms)\r\n", puntos, tiempo_reaccion);
     
     stats.compas_actual_acertado = true;
     stats.compas_actual_perfecto = (puntos == 2);
     stats.pulsaciones_correctas++;
     #endif
     puntuacion += puntos;
+    mostrar_calidad_acierto(puntos);
 }
 
 static void procesar_fallo(void) {
@@ -562,56 +924,45 @@ static void mostrar_patron_final(void) {
 }
 
 static void apagar_todos_leds(void) {
-    drv_led_establecer(LED_1, LED_OFF);
-    drv_led_establecer(LED_2, LED_OFF);
-    drv_led_establecer(LED_3, LED_OFF);
-    drv_led_establecer(LED_4, LED_OFF);
+    drv_leds_escribir_mascara(0x00);
 }
 
 static void configurar_leds_patron(uint8_t patron_top, uint8_t patron_bottom) {
-    drv_led_establecer(LED_1, (patron_top & 0x01) ? LED_ON : LED_OFF);
-    drv_led_establecer(LED_2, (patron_top & 0x02) ? LED_ON : LED_OFF);
-    drv_led_establecer(LED_3, (patron_bottom & 0x01) ? LED_ON : LED_OFF);
-    drv_led_establecer(LED_4, (patron_bottom & 0x02) ? LED_ON : LED_OFF);
+    // LED_1/LED_2 = fila superior, LED_3/LED_4 = fila inferior
+    drv_leds_escribir_mascara((uint8_t)((patron_top & 0x03) | ((patron_bottom & 0x03) << 2)));
 }
 
-static void configurar_leds_por_mask(uint8_t mask) {
-    drv_led_establecer(LED_1, (mask & 0x01) ? LED_ON : LED_OFF);
-    drv_led_establecer(LED_2, (mask & 0x02) ? LED_ON : LED_OFF);
-    drv_led_establecer(LED_3, (mask & 0x04) ? LED_ON : LED_OFF);
-    drv_led_establecer(LED_4, (mask & 0x08) ? LED_ON : LED_OFF);
+// Destello en el carril acertado que vuelve a lo que muestra el LED (fila
+// inferior = compas[1]): contraste total si es perfecto, tenue si es bueno.
+// Lo hace el PWM, sin eventos; la transición siguiente devuelve los LEDs al GPIO.
+static void mostrar_calidad_acierto(int puntos) {
+    if (puntos <= 0) return;
+    uint8_t destello = (puntos == 2) ? DRV_LED_BRILLO_MAX : DRV_LED_BRILLO_MAX / 5;
+
+    for (uint8_t carril = 0; carril < 2; carril++) {
+        if (!(patron_esperado_actual & (1u << carril))) continue;
+
+        bool encendido = (compas[1] & (1u << carril)) != 0;
+        uint8_t reposo = encendido ? DRV_LED_BRILLO_MAX : 0;
+        uint8_t desde  = encendido ? (uint8_t)(DRV_LED_BRILLO_MAX - destello) : destello;
+        drv_led_fundido((LED_id_t)(LED_FILA_INFERIOR + carril), desde, reposo, TIEMPO_FUNDIDO);
+    }
 }
 
 static void iniciar_secuencia_fin(void) {
-    etapa_secuencia_fin = 0;
-    esperando_reinicio = false;
-    apagar_todos_leds();
-    
-    // CORRECCIÓN PRINCIPAL: Reducido de 2000 a 200ms para feedback inmediato
-    svc_alarma_activar(svc_alarma_codificar(false, 200, 0),
-                      ev_PULSAR_BOTON, ID_TIMEOUT_INACTIVO);
+    drv_leds_animar(&ANIM_FIN, ev_PULSAR_BOTON, ID_TIMEOUT_FIN);
 }
 
-static void avanzar_secuencia_fin(void) {
+static void terminar_secuencia_fin(void) {
+    LOG_MSG("Secuencia fin completada -> Durmiendo");
     apagar_todos_leds();
-    configurar_leds_etapa_fin(etapa_secuencia_fin);
-    etapa_secuencia_fin++;
-
-    if (etapa_secuencia_fin == 11) {
-        svc_alarma_activar(svc_alarma_codificar(false, 800, 0),
-                          ev_PULSAR_BOTON, ID_TIMEOUT_FIN);
-    } else {
-        uint32_t delay = (etapa_secuencia_fin <= 11) ? 300 : 0;
-        if (delay > 0) {
-            svc_alarma_activar(svc_alarma_codificar(false, delay, 0),
-                              ev_PULSAR_BOTON, ID_TIMEOUT_INACTIVO);
-        }
-    }
-}
+    guardar_partida();
 
-static void configurar_leds_etapa_fin(uint8_t etapa) {
-    uint8_t mask = (etapa < sizeof(FIN_MASK)) ? FIN_MASK[etapa] : 0x00;
-    configurar_leds_por_mask(mask);
+    #if DEBUG
+    mostrar_estadisticas_finales();
+    #endif
+    LOG_MSG("Sistema en SLEEP (Pulsa 3 o 4 para despertar)");
+    svc_energia_solicitar_apagado();
 }
 
 // ============================================================================
@@ -640,7 +991,7 @@ static void resetear_estadisticas_compas_actual(void) {
 
 static void actualizar_estadisticas_compas(void) {
     if (!entrada_valida) return;
-    if (compas_actual < 1 || compas_actual > (NUM_COMPASES - 2)) return;
+    if (compas_actual < 1 || compas_actual > (compases_partida - 2)) return;
 
     if (stats.compas_actual_acertado) {
         stats.compases_acertados++;
@@ -660,30 +1011,37 @@ static void actualizar_estadisticas_compas(void) {
 }
 
 static void mostrar_estadisticas_finales(void) {
-    float porcentaje_precision = calcular_porcentaje(stats.aciertos_activos, stats.total_compases_activos);
-    float porcentaje_perfectos = calcular_porcentaje(stats.compases_perfectos, stats.total_compases_activos);
+    uint32_t precision = calcular_por_mil(stats.aciertos_activos, stats.total_compases_activos);
 
     LOG_MSG("=== ESTADISTICAS (SKILL REAL) ===");
 
-    sprintf(buffer, "[STATS] Activos: %d | Hits Activos: %d\r\n", stats.total_compases_activos, stats.aciertos_activos); drv_uart_send(buffer);
-    sprintf(buffer, "[STATS] Precision: %.1f%%\r\n", porcentaje_precision); drv_uart_send(buffer);
-    sprintf(buffer, "[STATS] Perfectos: %d\r\n", stats.compases_perfectos); drv_uart_send(buffer);
-    sprintf(buffer, "[STATS] Puntuacion: %d\r\n", puntuacion); drv_uart_send(buffer);
-
-    const char* rendimiento = evaluar_rendimiento(porcentaje_precision);
+    svc_logs_printf(LOG_LEVEL_INFO, "[STATS] Activos: %d | Hits Activos: %d\r\n", stats.total_compases_activos, stats.aciertos_activos);
+    svc_logs_printf(LOG_LEVEL_INFO, "[STATS] Precision: %u.%u%%\r\n",
+                    (unsigned)(precision / 10u), (unsigned)(precision % 10u));
+    svc_logs_printf(LOG_LEVEL_INFO, "[STATS] Perfectos: %d\r\n", stats.compases_perfectos);
+    svc_logs_printf(LOG_LEVEL_INFO, "[STATS] Puntuacion: %d\r\n", puntuacion);
+    svc_logs_printf(LOG_LEVEL_INFO, "[STATS] Record: %ld | Partidas: %lu\r\n",
+                    (long)historico.record, (unsigned long)historico.partidas);
+    svc_logs_printf(LOG_LEVEL_INFO, "[STATS] Deriva: final %lu ms, max %lu ms, encadenada %lu ms (%u fases)\r\n",
+                    (unsigned long)deriva.ultimo, (unsigned long)deriva.max,
+                    (unsigned long)deriva.suma, deriva.muestras);
+
+    const char* rendimiento = evaluar_rendimiento(precision);
     LOG_MSG(rendimiento);
 }
 
-static float calcular_porcentaje(uint8_t valor, uint8_t total) {
-    if (total == 0) return 0.0f;
-    return (valor / (float)total) * 100.0f;
+// Porcentaje en tanto por mil truncado (una décima de resolución): sin
+// redondear, un 89.95% no llega al umbral de 900 del rango S
+static uint32_t calcular_por_mil(uint16_t valor, uint16_t total) {
+    if (total == 0) return 0;
+    return ((uint32_t)valor * 1000u) / total;
 }
 
-static const char* evaluar_rendimiento(float porcentaje_aciertos) {
-    if (porcentaje_aciertos >= 90 && stats.compases_perfectos >= 3) return "Rango: S (EXCELENTE)";
-    else if (porcentaje_aciertos >= 75) return "Rango: A (MUY BUENO)";
-    else if (porcentaje_aciertos >= 60) return "Rango: B (BUENO)";
-    else if (porcentaje_aciertos >= 40) return "Rango: C (REGULAR)";
+static const char* evaluar_rendimiento(uint32_t por_mil_aciertos) {
+    if (por_mil_aciertos >= 900 && stats.compases_perfectos >= 3) return "Rango: S (EXCELENTE)";
+    else if (por_mil_aciertos >= 750) return "Rango: A (MUY BUENO)";
+    else if (por_mil_aciertos >= 600) return "Rango: B (BUENO)";
+    else if (por_mil_aciertos >= 400) return "Rango: C (REGULAR)";
     else return "Rango: D (MEJORABLE)";
 }
 #endif
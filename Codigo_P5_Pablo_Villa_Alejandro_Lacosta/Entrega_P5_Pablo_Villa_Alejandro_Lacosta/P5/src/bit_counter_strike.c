@@ -19,7 +19,10 @@
 #include "drv_leds.h"
 #include "drv_botones.h"
 #include "svc_GE.h"
+#include "rt_GE.h"
 #include "svc_alarmas.h"
+#include "svc_grabacion.h"
+#include "rt_fsm.h"
 #include <stddef.h>
 
 #define TAMANO_SECUENCIA    8
@@ -27,137 +30,190 @@
 #define TIEMPO_PAUSA_MS     500u
 #define TIEMPO_BLINK_MS     200u
 #define ID_TIMEOUT          0xFF
+#define ID_ANIMACION        0xFE
 
 static const uint8_t SECUENCIA[TAMANO_SECUENCIA] = {1, 3, 2, 4, 1, 4, 2, 3};
 
+/* Parpadeo inicial: 3 veces todos los LEDs */
+static const drv_leds_fotograma_t FOTOGRAMAS_INICIO[] = {
+    { 0x0F, TIEMPO_BLINK_MS }, { 0x00, TIEMPO_BLINK_MS }
+};
+static const drv_leds_animacion_t ANIM_INICIO = {
+    FOTOGRAMAS_INICIO, DRV_LEDS_NUM_FOTOGRAMAS(FOTOGRAMAS_INICIO), 3
+};
+
 /* Estados de la m?quina de juego */
 typedef enum {
     e_INIT,
     e_SHOW_SEQUENCE,
     e_WAIT_FOR_INPUT,
-    e_FIN_PARTIDA
+    e_FIN_PARTIDA,
+    NUM_ESTADOS
 } estado_juego_t;
 
-static estado_juego_t estado_actual;
+/* Eventos: los tres primeros vienen del gestor; ACIERTO/FALLO/COMPLETA los
+ * lanza juzgar() con el resultado de la pulsaci?n */
+enum {
+    EV_TIMEOUT,
+    EV_ANIMACION,
+    EV_BOTON,
+    EV_ACIERTO,
+    EV_FALLO,
+    EV_COMPLETA,
+    NUM_EVENTOS
+};
+
+static rt_fsm_t fsm;
 static uint8_t  indice_secuencia;
 static uint32_t tiempo_limite;
-static uint8_t  contador_parpadeos;
 
-static void juego_fsm(EVENTO_T ev, uint32_t aux);
+static void juego_cb(EVENTO_T ev, uint32_t aux);
 static void programar_alarma(uint32_t ms);
-static void cancelar_alarma(void);
+static void apagar_leds(void);
+
+static void animar_inicio(uint32_t aux);
+static void empezar(uint32_t aux);
+static void mostrar_objetivo(uint32_t aux);
+static void juzgar(uint32_t aux);
+static void avanzar(uint32_t aux);
+static void apagar_objetivo(uint32_t aux);
+static void entrar_fin(uint32_t aux);
+static void reiniciar(uint32_t aux);
+
+static const rt_fsm_estado_t ESTADOS[NUM_ESTADOS] = {
+    [e_INIT]           = { "INIT", NULL,       NULL },
+    [e_SHOW_SEQUENCE]  = { "SHOW", NULL,       NULL },
+    [e_WAIT_FOR_INPUT] = { "WAIT", NULL,       NULL },
+    [e_FIN_PARTIDA]    = { "FIN",  entrar_fin, NULL },
+};
+
+static const char * const EVENTOS[NUM_EVENTOS] = {
+    "TIMEOUT", "ANIMACION", "BOTON", "ACIERTO", "FALLO", "COMPLETA"
+};
+
+static const rt_fsm_transicion_t TABLA[NUM_ESTADOS][NUM_EVENTOS] = {
+    [e_INIT] = {
+        [EV_TIMEOUT]   = RT_FSM_HACER(animar_inicio),
+        [EV_ANIMACION] = RT_FSM_T(NULL, empezar, e_SHOW_SEQUENCE),
+    },
+    [e_SHOW_SEQUENCE] = {
+        [EV_TIMEOUT]   = RT_FSM_T(NULL, mostrar_objetivo, e_WAIT_FOR_INPUT),
+    },
+    [e_WAIT_FOR_INPUT] = {
+        [EV_BOTON]     = RT_FSM_HACER(juzgar),
+        [EV_ACIERTO]   = RT_FSM_T(NULL, avanzar, e_SHOW_SEQUENCE),
+        [EV_COMPLETA]  = RT_FSM_T(NULL, apagar_objetivo, e_FIN_PARTIDA),
+        [EV_FALLO]     = RT_FSM_IR(e_FIN_PARTIDA),
+        [EV_TIMEOUT]   = RT_FSM_T(NULL, apagar_objetivo, e_FIN_PARTIDA),
+    },
+    [e_FIN_PARTIDA] = {
+        [EV_TIMEOUT]   = RT_FSM_T(NULL, reiniciar, e_INIT),
+    },
+};
+
+static const rt_fsm_def_t FSM_JUEGO = {
+    "counter_strike", ESTADOS, NUM_ESTADOS, EVENTOS, NUM_EVENTOS, &TABLA[0][0], NULL
+};
 
 /**
  * Inicializa todo el sistema de juego.
- * Prepara los LEDs, los botones, resetea estados y programa la primera alarma.
+ * Arranca el gestor de eventos, prepara los LEDs y los botones, resetea
+ * estados, programa la primera alarma y no vuelve (queda en el lanzador).
  */
 void bit_counter_strike_iniciar(void) {
+    rt_GE_iniciar(10);
     drv_leds_iniciar();
-    drv_botones_iniciar(NULL, ev_PULSAR_BOTON, ev_PULSAR_BOTON);
+    drv_botones_iniciar(NULL, ev_PULSAR_BOTON, ev_SOLTAR_BOTON);
+    svc_grabacion_iniciar();
 
-    estado_actual = e_INIT;
-    contador_parpadeos = 0;
     indice_secuencia = 0;
     tiempo_limite = TIEMPO_BASE_MS;
 
-    svc_GE_suscribir(ev_PULSAR_BOTON, 2, juego_fsm);
+    svc_GE_suscribir(ev_PULSAR_BOTON, 2, juego_cb);
 
+    rt_fsm_iniciar(&fsm, &FSM_JUEGO, e_INIT);
     programar_alarma(10);
+    rt_GE_lanzador();
+}
+
+/**
+ * Traduce (ev, aux) del gestor a un evento de la m?quina de estados.
+ * El flujo completo (animaci?n inicial, mostrar secuencia, entrada del
+ * jugador, evaluaci?n, victoria/derrota y reinicio) est? en TABLA.
+ */
+static void juego_cb(EVENTO_T ev, uint32_t aux) {
+    (void)ev;
+    uint8_t evento = (aux == ID_TIMEOUT)   ? EV_TIMEOUT
+                   : (aux == ID_ANIMACION) ? EV_ANIMACION
+                   : (aux < 4)             ? EV_BOTON
+                   : RT_FSM_NINGUNO;
+    rt_fsm_evento(&fsm, evento, aux);
+}
+
+static void animar_inicio(uint32_t aux) {
+    (void)aux;
+    drv_leds_animar(&ANIM_INICIO, ev_PULSAR_BOTON, ID_ANIMACION);
+}
+
+static void empezar(uint32_t aux) {
+    (void)aux;
+    apagar_leds();
+    programar_alarma(1000);
+}
+
+static void mostrar_objetivo(uint32_t aux) {
+    (void)aux;
+    drv_led_establecer((LED_id_t)SECUENCIA[indice_secuencia], LED_ON);
+    programar_alarma(tiempo_limite);
 }
 
 /**
- * M?quina de estados del juego Counter Strike.
- * Gestiona el flujo completo: animaci?n inicial, mostrar secuencia, entrada
- * del jugador, evaluaci?n, victoria/derrota y reinicio.
+ * Compara el bot?n con el LED objetivo y lanza el resultado.
  */
-static void juego_fsm(EVENTO_T ev, uint32_t aux) {
-    bool es_timeout = (aux == ID_TIMEOUT);
-    bool es_boton = (aux < 4);
-
-    switch (estado_actual) {
-
-    case e_INIT:
-        if (es_timeout) {
-            if (contador_parpadeos < 6) {
-                for (int i = 1; i <= 4; i++) {
-                    drv_led_conmutar((LED_id_t)i);
-                }
-                contador_parpadeos++;
-                programar_alarma(TIEMPO_BLINK_MS);
-            } else {
-                for (int i = 1; i <= 4; i++) {
-                    drv_led_establecer((LED_id_t)i, LED_OFF);
-                }
-                estado_actual = e_SHOW_SEQUENCE;
-                programar_alarma(1000);
-            }
-        }
-        break;
-
-    case e_SHOW_SEQUENCE:
-        if (es_timeout) {
-            uint8_t led_objetivo = SECUENCIA[indice_secuencia];
-
-            drv_led_establecer((LED_id_t)led_objetivo, LED_ON);
-
-            programar_alarma(tiempo_limite);
-            estado_actual = e_WAIT_FOR_INPUT;
-        }
-        break;
-
-    case e_WAIT_FOR_INPUT:
-
-        if (es_boton) {
-            uint8_t boton_pulsado = (uint8_t)aux;
-            uint8_t led_jugado = boton_pulsado + 1;
-            uint8_t led_objetivo = SECUENCIA[indice_secuencia];
-
-            if (led_jugado == led_objetivo) {
-                drv_led_establecer((LED_id_t)led_objetivo, LED_OFF);
-                cancelar_alarma();
-
-                indice_secuencia++;
-
-                if (tiempo_limite > 400) {
-                    tiempo_limite -= 100;
-                }
-
-                if (indice_secuencia >= TAMANO_SECUENCIA) {
-                    estado_actual = e_FIN_PARTIDA;
-                    programar_alarma(100);
-                } else {
-                    estado_actual = e_SHOW_SEQUENCE;
-                    programar_alarma(TIEMPO_PAUSA_MS);
-                }
-
-            } else {
-                cancelar_alarma();
-                estado_actual = e_FIN_PARTIDA;
-                programar_alarma(100);
-            }
-        } else if (es_timeout) {
-            uint8_t led_objetivo = SECUENCIA[indice_secuencia];
-            drv_led_establecer((LED_id_t)led_objetivo, LED_OFF);
-
-            estado_actual = e_FIN_PARTIDA;
-            programar_alarma(100);
-        }
-        break;
-
-    case e_FIN_PARTIDA:
-        if (es_timeout) {
-            for (int i = 1; i <= 4; i++) {
-                drv_led_establecer((LED_id_t)i, LED_OFF);
-            }
-
-            indice_secuencia = 0;
-            contador_parpadeos = 0;
-            tiempo_limite = TIEMPO_BASE_MS;
-
-            estado_actual = e_INIT;
-            programar_alarma(2000);
-        }
-        break;
+static void juzgar(uint32_t aux) {
+    uint8_t led_jugado = (uint8_t)aux + 1;
+
+    if (led_jugado != SECUENCIA[indice_secuencia]) {
+        rt_fsm_lanzar(&fsm, EV_FALLO, aux);
+    } else if (indice_secuencia + 1 >= TAMANO_SECUENCIA) {
+        rt_fsm_lanzar(&fsm, EV_COMPLETA, aux);
+    } else {
+        rt_fsm_lanzar(&fsm, EV_ACIERTO, aux);
+    }
+}
+
+static void avanzar(uint32_t aux) {
+    apagar_objetivo(aux);
+    indice_secuencia++;
+
+    if (tiempo_limite > 400) {
+        tiempo_limite -= 100;
+    }
+    programar_alarma(TIEMPO_PAUSA_MS);
+}
+
+static void apagar_objetivo(uint32_t aux) {
+    (void)aux;
+    drv_led_establecer((LED_id_t)SECUENCIA[indice_secuencia], LED_OFF);
+}
+
+/* Sustituye a la alarma de la ronda si quedaba pendiente */
+static void entrar_fin(uint32_t aux) {
+    (void)aux;
+    programar_alarma(100);
+}
+
+static void reiniciar(uint32_t aux) {
+    (void)aux;
+    apagar_leds();
+    indice_secuencia = 0;
+    tiempo_limite = TIEMPO_BASE_MS;
+    programar_alarma(2000);
+}
+
+static void apagar_leds(void) {
+    for (int i = 1; i <= 4; i++) {
+        drv_led_establecer((LED_id_t)i, LED_OFF);
     }
 }
 
@@ -169,11 +225,3 @@ static void programar_alarma(uint32_t ms) {
     uint32_t flags = svc_alarma_codificar(false, ms, 0);
     svc_alarma_activar(flags, ev_PULSAR_BOTON, ID_TIMEOUT);
 }
-
-/**
- * Cancela la alarma activa asociada al juego.
- */
-static void cancelar_alarma(void) {
-    svc_alarma_activar(0, ev_PULSAR_BOTON, ID_TIMEOUT);
-}
-
@@ -11,6 +11,8 @@
 	#include "board_nrf52840dk.h"
 #elif defined(BOARD_PCA10059)
   #include "board_nrf52840_dongle.h"	
+#elif defined(HOST_POSIX)
+	#include "board_host.h"
 #else
 	#error "Board is not defined"
 #endif
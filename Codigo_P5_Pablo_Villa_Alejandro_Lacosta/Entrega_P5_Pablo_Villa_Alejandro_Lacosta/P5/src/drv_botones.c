@@ -21,120 +21,385 @@
 #include "svc_alarmas.h"
 #include "rt_fifo.h"
 #include "svc_GE.h"
+#include "rt_fsm.h"
+#include "svc_energia.h"
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdio.h>
 #include "board.h"
 
+#define ID_MUESTREO      0u                       // aux de la alarma de muestreo
+#define MASCARA_BOTONES  ((1u << BUTTONS_NUMBER) - 1u)
+#define NUM_PUERTOS      2u                       // P0/P1 (el LPC solo usa P0)
+
+// Los botones de ambas placas se detectan por flanco de bajada en
+// hal_ext_int: un nivel bajo en el pin es una pulsación.
+#define NIVEL_PULSADO    0u
+
 static boton_t botones[BUTTONS_NUMBER];
 static const uint32_t s_board_button_pins[] = BUTTONS_LIST;
-static EVENTO_T s_evento_principal; // Guardamos el ID del evento a usar
+static EVENTO_T s_ev_pulsar;
+static EVENTO_T s_ev_soltar;
+
+// Estado del antirrebotes: bit i = botón i
+static uint32_t s_estable = 0;          // Estado validado (1 = pulsado)
+static uint32_t s_cnt0 = 0, s_cnt1 = 0; // Contador vertical de 2 bits por botón
+static volatile bool s_activo = false;  // Interrupciones enmascaradas, muestreo pedido
+static uint32_t s_puertos = 0;          // Puertos GPIO con algún botón
+
+// Ciclo de vida del muestreo (rt_fsm):
+//   REPOSO    interrupciones armadas, sin alarma
+//   MUESTREO  alarma periódica, antirrebotes en marcha hasta que todo se suelta
+//   INHIBIDO  botones físicos ignorados (reproducción de grabaciones)
+enum { E_REPOSO, E_MUESTREO, E_INHIBIDO, NUM_ESTADOS };
+enum { EV_MUESTRA, EV_SUELTOS, EV_INHIBIR, EV_HABILITAR, NUM_EVENTOS };
+static rt_fsm_t s_fsm;
+
+// Marcas de tiempo: flanco capturado en la ISR y primer cambio por botón
+static volatile Tiempo_us_t s_ts_flanco;
+static volatile bool s_ts_flanco_valido = false;
+static Tiempo_us_t s_ts_cambio[BUTTONS_NUMBER];
+static Tiempo_us_t s_ts_pulsacion[BUTTONS_NUMBER];
+
+// Ráfaga de rebotes en curso (bit i): s_ts_cambio[i] guarda su primer flanco
+// hasta que el cambio se valida o la entrada pasa RAFAGA_MUESTRAS muestras
+// seguidas en el estado estable
+#define RAFAGA_MUESTRAS 4u
+static uint32_t s_rafaga = 0;
+static uint8_t  s_quieto[BUTTONS_NUMBER];
+
+// Reconocimiento de gestos
+static drv_botones_config_t s_cfg = DRV_BOTONES_CONFIG_DEFECTO;
+static Tiempo_us_t s_ts_soltar[BUTTONS_NUMBER];
+static Tiempo_us_t s_ts_repeticion[BUTTONS_NUMBER];  // próxima repetición
+static uint32_t s_larga_emitida = 0;   // bit i: ya se notificó la pulsación larga
+static uint32_t s_toque_corto = 0;     // bit i: último toque corto (candidato a doble)
+
+static void habilitar_interrupciones(void);
+static void deshabilitar_interrupciones(void);
+static void armar_despertar(void);
+static svc_energia_modo_t veto_muestreo(void);
+static void muestrear(uint32_t aux);
+static void entrar_reposo(uint32_t aux);
+static void entrar_muestreo(uint32_t aux);
+static void salir_muestreo(uint32_t aux);
+static void entrar_inhibido(uint32_t aux);
+
+static const rt_fsm_estado_t ESTADOS[NUM_ESTADOS] = {
+    [E_REPOSO]   = { "REPOSO",   entrar_reposo,   NULL },
+    [E_MUESTREO] = { "MUESTREO", entrar_muestreo, salir_muestreo },
+    [E_INHIBIDO] = { "INHIBIDO", entrar_inhibido, NULL },
+};
+
+static const char * const EVENTOS[NUM_EVENTOS] = {
+    "MUESTRA", "SUELTOS", "INHIBIR", "HABILITAR"
+};
+
+static const rt_fsm_transicion_t TABLA[NUM_ESTADOS][NUM_EVENTOS] = {
+    [E_REPOSO] = {
+        [EV_MUESTRA]   = RT_FSM_T(NULL, muestrear, E_MUESTREO),
+        [EV_INHIBIR]   = RT_FSM_IR(E_INHIBIDO),
+    },
+    [E_MUESTREO] = {
+        [EV_MUESTRA]   = RT_FSM_HACER(muestrear),
+        [EV_SUELTOS]   = RT_FSM_IR(E_REPOSO),
+        [EV_INHIBIR]   = RT_FSM_IR(E_INHIBIDO),
+    },
+    [E_INHIBIDO] = {
+        [EV_HABILITAR] = RT_FSM_IR(E_REPOSO),
+    },
+};
 
-static void programar_alarma_unica(uint32_t retardo_ms, hal_ext_int_id_t id);
-static void programar_alarma_periodica(uint32_t periodo_ms, hal_ext_int_id_t id);
+static const rt_fsm_def_t FSM_BOTONES = {
+    "drv_botones", ESTADOS, NUM_ESTADOS, EVENTOS, NUM_EVENTOS, &TABLA[0][0], NULL
+};
+static void gesto_pulsacion(uint8_t i);
+static void gesto_liberacion(uint8_t i);
+static void gestos_mantenidos(void);
 
 // -----------------------------------------------------------------------------
-// Callback de la interrupci?n Hardware
+// Lectura vectorizada: un acceso por puerto y reordenado a bits de botón
 // -----------------------------------------------------------------------------
-void drv_botones_callback(hal_ext_int_id_t id){  
-    hal_ext_int_deshabilitar(id);
-    rt_FIFO_encolar(s_evento_principal, (uint32_t) id);
+static uint32_t leer_muestra(void) {
+    uint32_t nivel[NUM_PUERTOS] = { 0 };
+    uint32_t muestra = 0;
+
+    for (uint32_t p = 0; p < NUM_PUERTOS; p++)
+        if (s_puertos & (1u << p)) nivel[p] = hal_gpio_leer_puerto(p);
+
+    for (uint8_t i = 0; i < BUTTONS_NUMBER; i++) {
+        uint32_t pin = botones[i].pin;
+        if (((nivel[pin >> 5] >> (pin & 31u)) & 1u) == NIVEL_PULSADO)
+            muestra |= (1u << i);
+    }
+    return muestra;
+}
+
+// -----------------------------------------------------------------------------
+// Callback de la interrupción Hardware
+// -----------------------------------------------------------------------------
+void drv_botones_callback(hal_ext_int_id_t id, uint64_t ts_us){  
+    (void)id;
+    deshabilitar_interrupciones();
+    if (!s_activo) {
+        s_ts_flanco = (Tiempo_us_t)ts_us;
+        s_ts_flanco_valido = true;
+        s_activo = true;
+        rt_FIFO_encolar(ev_BOTON_MUESTREO, ID_MUESTREO);
+    }
 }
 
 // -----------------------------------------------------------------------------
 // Callback del Gestor de Eventos (Dispatcher)
 // -----------------------------------------------------------------------------
-static void drv_botones_cb(uint32_t ev, uint32_t aux){
-    hal_ext_int_id_t id = (hal_ext_int_id_t)aux;
-    drv_botones_actualizar(ev, id);
+static void drv_botones_cb(EVENTO_T ev, uint32_t aux){
+    drv_botones_actualizar(ev, aux);
 }
+SVC_GE_SUSCRIPCION_ESTATICA(ev_BOTON_MUESTREO, 0, drv_botones_cb);
 
 // -----------------------------------------------------------------------------
-// Inicializaci?n
+// Inicialización
 // -----------------------------------------------------------------------------
-void drv_botones_iniciar(void(*cb_a_llamar),uint32_t ev_pulsar, uint32_t ev_ignorado){
-    
-    s_evento_principal = ev_pulsar; // Guardamos el evento para usarlo en alarmas
+void drv_botones_iniciar(void(*cb_a_llamar),uint32_t ev_pulsar, uint32_t ev_soltar){
+    (void)cb_a_llamar;
+    s_ev_pulsar = (EVENTO_T)ev_pulsar;
+    s_ev_soltar = (EVENTO_T)ev_soltar;
+    s_estable = s_cnt0 = s_cnt1 = s_rafaga = 0;
+    s_activo = false;
+    s_puertos = 0;
+    s_larga_emitida = s_toque_corto = 0;
     hal_gpio_iniciar();
     
     for (uint8_t i = 0; i < BUTTONS_NUMBER; i++) {
         botones[i].pin = s_board_button_pins[i];
         botones[i].id_int = (hal_ext_int_id_t) i;
-        botones[i].estado = E_ESPERANDO;
         hal_gpio_sentido(botones[i].pin, HAL_GPIO_PIN_DIR_INPUT);
+        s_puertos |= 1u << (botones[i].pin >> 5);
     }
-    hal_ext_int_iniciar(drv_botones_callback);
-    
+    hal_ext_int_iniciar_ts(drv_botones_callback);
+    svc_energia_registrar_despertar(armar_despertar);
+    svc_energia_registrar_veto(veto_muestreo);
+    rt_fsm_iniciar(&s_fsm, &FSM_BOTONES, E_REPOSO);
+}
+
+// -----------------------------------------------------------------------------
+// Antirrebotes: integrador con contadores verticales
+// -----------------------------------------------------------------------------
+void drv_botones_actualizar(uint32_t ev, uint32_t aux){
+    (void)ev;
+    rt_fsm_evento(&s_fsm, EV_MUESTRA, aux);
+}
+
+static void muestrear(uint32_t aux){
+    (void)aux;
+
+    // Los botones cuya muestra difiere del estado estable avanzan su
+    // contador; los demás lo reinician. Al desbordar (4 muestras) cambian.
+    uint32_t muestra = leer_muestra();
+    uint32_t delta   = muestra ^ s_estable;
+
+    // Botones que empiezan una ráfaga en esta muestra: se anota cuándo.
+    // El primero hereda el instante exacto del flanco. Un rebote reinicia
+    // el contador pero no la ráfaga, que conserva su primer instante.
+    uint32_t nuevos = delta & ~s_rafaga & MASCARA_BOTONES;
+    if (nuevos != 0) {
+        Tiempo_us_t ts = s_ts_flanco_valido ? s_ts_flanco : drv_tiempo_actual_us();
+        s_ts_flanco_valido = false;
+        s_rafaga |= nuevos;
+        for (uint8_t i = 0; i < BUTTONS_NUMBER; i++)
+            if (nuevos & (1u << i)) s_ts_cambio[i] = ts;
+    }
+
+    s_cnt1 = (s_cnt1 ^ s_cnt0) & delta;
+    s_cnt0 = ~s_cnt0 & delta;
+    uint32_t cambio = delta & ~(s_cnt0 | s_cnt1) & MASCARA_BOTONES;
+    s_estable ^= cambio;
+    s_rafaga &= ~cambio;
+
+    // Ráfagas que vuelven al estado estable y se quedan en él: se abandonan
     for (uint8_t i = 0; i < BUTTONS_NUMBER; i++) {
-        hal_ext_int_habilitar(botones[i].id_int);
+        uint32_t bit = 1u << i;
+        if (!(s_rafaga & bit)) continue;
+        if (delta & bit)                             s_quieto[i] = 0;
+        else if (++s_quieto[i] >= RAFAGA_MUESTRAS) { s_quieto[i] = 0; s_rafaga &= ~bit; }
     }
-    svc_GE_suscribir(s_evento_principal, 0, drv_botones_cb);
-    
+
+    for (uint8_t i = 0; cambio != 0; i++, cambio >>= 1) {
+        if ((cambio & 1u) == 0) continue;
+        if (s_estable & (1u << i)) {
+            s_ts_pulsacion[i] = s_ts_cambio[i];
+            rt_FIFO_encolar(s_ev_pulsar, i);
+            gesto_pulsacion(i);
+        } else {
+            if (s_ev_soltar != ev_VOID)
+                rt_FIFO_encolar(s_ev_soltar, i);
+            gesto_liberacion(i);
+        }
+    }
+
+    if (s_estable != 0) gestos_mantenidos();
+
+    // Todo suelto y estable (sin ráfagas abiertas): se vuelve a esperar flanco
+    if (s_estable == 0 && muestra == 0 && s_rafaga == 0) rt_fsm_lanzar(&s_fsm, EV_SUELTOS, 0);
 }
 
 // -----------------------------------------------------------------------------
-// M?quina de Estados
+// Entradas y salidas de estado
 // -----------------------------------------------------------------------------
-void drv_botones_actualizar(uint32_t ev, hal_ext_int_id_t aux){
-    hal_ext_int_id_t id = aux;
-    boton_t *b = &botones[id];
+static void entrar_reposo(uint32_t aux){
+    (void)aux;
+    s_ts_flanco_valido = false;
+    s_activo = false;
+    habilitar_interrupciones();
 
-    // La l?gica depende EXCLUSIVAMENTE del estado actual
-    switch (b->estado) {
-        
-    case E_ESPERANDO:
-        b->estado = E_REBOTES;
-        programar_alarma_unica(TRP, id);
-        break;
+    // Una pulsación entre la última muestra y la rehabilitación no
+    // generaría flanco: se comprueba el nivel explícitamente.
+    if (leer_muestra() != 0) drv_botones_callback(HAL_EXT_INT_0, drv_tiempo_actual_us());
+}
 
-    case E_REBOTES:
-        b->estado = E_MUESTREO;
-        programar_alarma_periodica(TEP, id);
-        break;
+static void entrar_muestreo(uint32_t aux){
+    (void)aux;
+    svc_alarma_activar(svc_alarma_codificar(true, DRV_BOTONES_PERIODO_MS, 0),
+                       ev_BOTON_MUESTREO, ID_MUESTREO);
+}
+
+static void salir_muestreo(uint32_t aux){
+    (void)aux;
+    svc_alarma_desactivar(ev_BOTON_MUESTREO, ID_MUESTREO);
+}
+
+// Se deja s_activo a true para que un flanco que ya estuviera en vuelo no
+// vuelva a arrancar el muestreo.
+static void entrar_inhibido(uint32_t aux){
+    (void)aux;
+    deshabilitar_interrupciones();
+    s_activo = true;
+    s_ts_flanco_valido = false;
+    s_estable = s_cnt0 = s_cnt1 = s_rafaga = 0;
+}
+
+// -----------------------------------------------------------------------------
+// Gestos: todo se deduce de las marcas de tiempo en el propio muestreo
+// -----------------------------------------------------------------------------
+static void emitir_gesto(drv_boton_gesto_t tipo, uint32_t dato){
+    rt_FIFO_encolar(ev_BOTON_GESTO, DRV_BOTON_GESTO_AUX(tipo, dato));
+}
+
+static void gesto_pulsacion(uint8_t i){
+    uint32_t bit = 1u << i;
+    Tiempo_us_t ts = s_ts_pulsacion[i];
+
+    s_larga_emitida &= ~bit;
+    s_ts_repeticion[i] = ts + (Tiempo_us_t)s_cfg.repeticion_ms * 1000u;
+
+    // Doble toque: toque corto previo y vuelta a pulsar dentro de la ventana
+    if (s_cfg.doble_ms && (s_toque_corto & bit) &&
+        (ts - s_ts_soltar[i]) <= (Tiempo_us_t)s_cfg.doble_ms * 1000u) {
+        s_toque_corto &= ~bit;
+        emitir_gesto(DRV_BOTON_GESTO_DOBLE, i);
+    }
+
+    // Acorde: otros botones mantenidos cuya pulsación está dentro de la ventana
+    if (s_cfg.acorde_ms) {
+        Tiempo_us_t ventana = (Tiempo_us_t)s_cfg.acorde_ms * 1000u;
+        uint32_t mascara = bit;
+        for (uint8_t j = 0; j < BUTTONS_NUMBER; j++) {
+            if (j == i || !(s_estable & (1u << j))) continue;
+            Tiempo_us_t dif = (ts > s_ts_pulsacion[j]) ? ts - s_ts_pulsacion[j]
+                                                       : s_ts_pulsacion[j] - ts;
+            if (dif <= ventana) mascara |= 1u << j;
+        }
+        if (mascara != bit) emitir_gesto(DRV_BOTON_GESTO_ACORDE, mascara);
+    }
+}
+
+static void gesto_liberacion(uint8_t i){
+    uint32_t bit = 1u << i;
+    s_ts_soltar[i] = s_ts_cambio[i];
+    if (s_larga_emitida & bit) s_toque_corto &= ~bit;
+    else                       s_toque_corto |= bit;
+}
+
+static void gestos_mantenidos(void){
+    Tiempo_us_t ahora = drv_tiempo_actual_us();
+    for (uint8_t i = 0; i < BUTTONS_NUMBER; i++) {
+        uint32_t bit = 1u << i;
+        if (!(s_estable & bit)) continue;
 
-    case E_MUESTREO:
-        if (!hal_gpio_leer(id)) { 
-            b->estado = E_SALIDA;
-            programar_alarma_unica(TRD, id);
-            
-        }else {
-            // FALSO POSITIVO o REBOTE: A?n no est? estable o se solt?.
-            // No cambiamos de estado, dejamos que la alarma peri?dica salte otra vez.
+        if (s_cfg.larga_ms && !(s_larga_emitida & bit) &&
+            (ahora - s_ts_pulsacion[i]) >= (Tiempo_us_t)s_cfg.larga_ms * 1000u) {
+            s_larga_emitida |= bit;
+            emitir_gesto(DRV_BOTON_GESTO_LARGA, i);
         }
-        break;
 
-    case E_SALIDA:
-        b->estado = E_ESPERANDO;        
-        hal_ext_int_habilitar(id);
-        break;
+        if (s_cfg.repeticion_ms && ahora >= s_ts_repeticion[i]) {
+            uint16_t periodo = s_cfg.periodo_repeticion_ms ? s_cfg.periodo_repeticion_ms
+                                                           : s_cfg.repeticion_ms;
+            s_ts_repeticion[i] = ahora + (Tiempo_us_t)periodo * 1000u;
+            emitir_gesto(DRV_BOTON_GESTO_REPETICION, i);
+        }
     }
 }
 
+void drv_botones_configurar(const drv_botones_config_t *cfg){
+    if (cfg != NULL) s_cfg = *cfg;
+}
+
+// -----------------------------------------------------------------------------
+// Helpers de interrupciones
+// -----------------------------------------------------------------------------
+static void habilitar_interrupciones(void){
+    for (uint8_t i = 0; i < BUTTONS_NUMBER; i++)
+        hal_ext_int_habilitar(botones[i].id_int);
+}
+
+static void deshabilitar_interrupciones(void){
+    for (uint8_t i = 0; i < BUTTONS_NUMBER; i++)
+        hal_ext_int_deshabilitar(botones[i].id_int);
+}
+
+// Fuente de despertar de svc_energia: cualquier botón saca del apagado
+static void armar_despertar(void){
+    for (uint8_t i = 0; i < BUTTONS_NUMBER; i++)
+        hal_ext_int_habilitar_despertar(botones[i].id_int);
+}
+
+// Mientras el antirrebotes muestrea no se apaga: la liberación y los gestos
+// en curso se perderían (el despertar por GPIO solo ve pulsaciones nuevas)
+static svc_energia_modo_t veto_muestreo(void){
+    if (s_activo && rt_fsm_estado(&s_fsm) != E_INHIBIDO) return SVC_ENERGIA_REPOSO;
+    return SVC_ENERGIA_APAGADO;
+}
+
 // -----------------------------------------------------------------------------
-// Helpers de Alarmas
+// Entrada sintética (reproducción de grabaciones)
 // -----------------------------------------------------------------------------
-static void programar_alarma_unica(uint32_t retardo_ms, hal_ext_int_id_t id){
-    uint32_t cod = svc_alarma_codificar(false, retardo_ms, 0);
-    svc_alarma_activar(cod, s_evento_principal, id);
+void drv_botones_entrada_hw(bool habilitada){
+    rt_fsm_evento(&s_fsm, habilitada ? EV_HABILITAR : EV_INHIBIR, 0);
 }
 
-static void programar_alarma_periodica(uint32_t periodo_ms, hal_ext_int_id_t id){
-    uint32_t cod = svc_alarma_codificar(true, periodo_ms, 0);
-    svc_alarma_activar(cod, s_evento_principal, id);
+void drv_botones_inyectar(uint8_t boton_id, Tiempo_us_t ts){
+    if (boton_id >= BUTTONS_NUMBER) return;
+    s_ts_pulsacion[boton_id] = ts;
+    rt_FIFO_encolar(s_ev_pulsar, boton_id);
+}
+
+const rt_fsm_def_t* drv_botones_fsm(void){
+    return &FSM_BOTONES;
 }
 
 bool drv_boton_esta_pulsado(uint8_t boton_id) {  
-	if(boton_id <= BUTTONS_NUMBER) return false;
-	return (hal_gpio_leer(botones[boton_id].pin) == 0);
+	if (boton_id >= BUTTONS_NUMBER) return false;
+	return (s_estable & (1u << boton_id)) != 0;
 }
 
 
+Tiempo_us_t drv_botones_ts_pulsacion(uint8_t boton_id) {
+    if (boton_id >= BUTTONS_NUMBER) return 0;
+    return s_ts_pulsacion[boton_id];
+}
+
 const char* drv_botones_estado_str(uint8_t id) {
     if (id >= BUTTONS_NUMBER) return "INVALIDO";
-    switch (botones[id].estado) {
-        case E_ESPERANDO: return "ESPERANDO";
-        case E_REBOTES:   return "REBOTES";
-        case E_MUESTREO:  return "MUESTREO";
-        case E_SALIDA:    return "SALIDA";
-        default:          return "???";
-    }
+    return drv_boton_esta_pulsado(id) ? "PULSADO" : "SUELTO";
 } 
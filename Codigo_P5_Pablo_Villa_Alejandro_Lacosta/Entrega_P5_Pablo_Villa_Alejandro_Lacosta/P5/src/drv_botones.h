@@ -19,70 +19,139 @@
 
 #include "hal_gpio.h"
 #include "hal_ext_int.h"
+#include "drv_tiempo.h"
+#include "rt_fsm.h"
 #include <stdbool.h>
 
 // ===============================
-// Configuraci�n de tiempos (ms)
+// Configuración del antirrebotes
 // ===============================
+//
+// Todos los botones se muestrean a la vez con un único temporizador
+// compartido que solo está activo mientras algún botón está pulsado o
+// rebotando. Cada muestra lee el puerto GPIO completo y pasa por un
+// integrador de contadores verticales (2 bits por botón): un cambio se
+// acepta tras DRV_BOTONES_MUESTRAS lecturas iguales consecutivas.
 
-#define TRP 200    // Tiempo de rebote de presi�n
-#define TEP 20     // Tiempo de encuesta peri�dica
-#define TRD 50     // Tiempo de rebote de depresi�n
-
+#define DRV_BOTONES_PERIODO_MS 5    // Periodo de muestreo compartido
+#define DRV_BOTONES_MUESTRAS   4    // Muestras estables (4 x 5 ms = 20 ms)
 
 // ===============================
-// Definici�n de estados FSM
+// Gestos
 // ===============================
+//
+// Se reconocen en el mismo muestreo (sin alarmas adicionales) a partir de
+// las marcas de tiempo de pulsación y liberación. Se notifican con
+// ev_BOTON_GESTO y aux = (tipo << 8) | dato, donde dato es el id del botón
+// o, para los acordes, la máscara de botones (bit i = botón i).
+
 typedef enum {
-    E_ESPERANDO = 0,  ///< Espera de pulsaci�n
-    E_REBOTES,        ///< Espera fin de rebote de presi�n
-    E_MUESTREO,       ///< Muestreo peri�dico mientras est� pulsado
-    E_SALIDA          ///< Espera fin de rebote de depresi�n
-} estado_boton_t;
+    DRV_BOTON_GESTO_LARGA      = 1,  ///< Mantenido más de larga_ms
+    DRV_BOTON_GESTO_REPETICION = 2,  ///< Autorepetición mientras se mantiene
+    DRV_BOTON_GESTO_DOBLE      = 3,  ///< Dos toques cortos seguidos
+    DRV_BOTON_GESTO_ACORDE     = 4,  ///< Varios botones pulsados a la vez
+} drv_boton_gesto_t;
+
+#define DRV_BOTON_GESTO_AUX(tipo, dato) (((uint32_t)(tipo) << 8) | ((dato) & 0xFFu))
+#define DRV_BOTON_GESTO_TIPO(aux)       ((drv_boton_gesto_t)((aux) >> 8))
+#define DRV_BOTON_GESTO_DATO(aux)       ((uint8_t)((aux) & 0xFFu))
+
+// Umbrales en ms; 0 desactiva el gesto correspondiente
+typedef struct {
+    uint16_t larga_ms;              ///< Pulsación larga
+    uint16_t repeticion_ms;         ///< Retardo hasta la primera repetición
+    uint16_t periodo_repeticion_ms; ///< Periodo entre repeticiones
+    uint16_t doble_ms;              ///< Máximo entre soltar y volver a pulsar
+    uint16_t acorde_ms;             ///< Máxima separación entre pulsaciones de un acorde
+} drv_botones_config_t;
+
+#define DRV_BOTONES_CONFIG_DEFECTO { 1000, 0, 0, 300, 60 }
 
 // ===============================
-// Estructura de control del bot�n
+// Estructura de control del botón
 // ===============================
 typedef struct {
-    HAL_GPIO_PIN_T pin;          ///< Pin asociado al bot�n
-    hal_ext_int_id_t id_int;     ///< ID de interrupci�n externa
-    estado_boton_t estado;       ///< Estado actual del bot�n
+    HAL_GPIO_PIN_T pin;          ///< Pin asociado al botón
+    hal_ext_int_id_t id_int;     ///< ID de interrupción externa
 } boton_t;
 
 // ===============================
 // API del driver
 // ===============================
 /*
- * @brief Inicializa el m�dulo de botones.
- *        Configura los GPIO, interrupciones externas y FSM en reposo.
+ * @brief Inicializa el módulo de botones.
+ *        Configura los GPIO, interrupciones externas y el antirrebotes.
  *
- * @param cb_a_llamar Callback a ejecutar ante eventos de bot�n.
- * @param ev1_pulsar  Evento asociado a la pulsaci�n.
- * @param ev2_tiempo  Evento asociado a temporizaci�n.
+ * @param cb_a_llamar Reservado (no se usa).
+ * @param ev_pulsar   Evento emitido al validar una pulsación (aux = id).
+ * @param ev_soltar   Evento emitido al validar una liberación (aux = id),
+ *                    ev_VOID para no notificarla.
  */ 
 
-void drv_botones_iniciar(void(*cb_a_llamar),uint32_t ev_pulsar, uint32_t ev_ignorado);
+void drv_botones_iniciar(void(*cb_a_llamar),uint32_t ev_pulsar, uint32_t ev_soltar);
 /**
- * @brief Callback del HAL al producirse una interrupci�n externa.
- * @param id Identificador de la interrupci�n externa (bot�n pulsado)
+ * @brief Cambia los umbrales de reconocimiento de gestos.
+ * @param cfg Nueva configuración (se copia)
+ */
+void drv_botones_configurar(const drv_botones_config_t *cfg);
+
+/**
+ * @brief Callback del HAL al producirse una interrupción externa.
+ *        Enmascara todas las interrupciones de botón y arranca el muestreo.
+ * @param id    Identificador de la interrupción externa
+ * @param ts_us Instante del flanco (capturado por hardware si el HAL puede)
  */ 
-void drv_botones_callback(hal_ext_int_id_t id);
+void drv_botones_callback(hal_ext_int_id_t id, uint64_t ts_us);
 
 /**
- * @brief Actualiza la FSM de un bot�n ante un evento recibido.
- * @param ev  Tipo de evento (pulsaci�n o retardo)
- * @param id  ID del bot�n afectado
+ * @brief Toma una muestra de todos los botones y actualiza el antirrebotes.
+ *        Se ejecuta con cada ev_BOTON_MUESTREO.
+ * @param ev  Evento recibido (ev_BOTON_MUESTREO)
+ * @param aux No usado
  */
-void drv_botones_actualizar(uint32_t ev, hal_ext_int_id_t id);
+void drv_botones_actualizar(uint32_t ev, uint32_t aux);
 
 /**
- * @brief Devuelve una cadena con el estado actual del bot�n indicado.
- * @param id ID del bot�n a consultar
- * @return Puntero a cadena descriptiva ("ESPERANDO", "REBOTES", etc.)
+ * @brief Devuelve una cadena con el estado filtrado del botón indicado.
+ * @param id ID del botón a consultar
+ * @return "PULSADO", "SUELTO" o "INVALIDO"
  */
 const char* drv_botones_estado_str(uint8_t id);
 
-
+/**
+ * @brief Estado filtrado (tras antirrebotes) del botón indicado.
+ */
 bool drv_boton_esta_pulsado(uint8_t boton_id);
 
+/**
+ * @brief Instante (us) del flanco que originó la última pulsación validada.
+ *
+ * Se captura en la ISR de la interrupción externa, de modo que no incluye
+ * el retardo del antirrebotes ni el de la cola de eventos. Si el flanco no
+ * pudo capturarse (interrupciones ya enmascaradas por otro botón) se usa la
+ * primera muestra en la que se vio el cambio (error < DRV_BOTONES_PERIODO_MS).
+ * Los rebotes durante el antirrebotes no la mueven: vale el primer flanco.
+ */
+Tiempo_us_t drv_botones_ts_pulsacion(uint8_t boton_id);
+
+/**
+ * @brief Habilita o deshabilita los botones físicos.
+ *
+ * Deshabilitados, las interrupciones externas quedan enmascaradas y el
+ * muestreo parado; solo llegan pulsaciones inyectadas.
+ */
+void drv_botones_entrada_hw(bool habilitada);
+
+/**
+ * @brief Inyecta una pulsación como si la hubiera validado el antirrebotes.
+ * @param boton_id ID del botón
+ * @param ts       Instante del flanco que devolverá drv_botones_ts_pulsacion()
+ */
+void drv_botones_inyectar(uint8_t boton_id, Tiempo_us_t ts);
+
+/**
+ * @brief Tabla de la máquina de estados del muestreo (para volcarla).
+ */
+const rt_fsm_def_t* drv_botones_fsm(void);
+
 #endif  // DRV_BOTONES_H 
@@ -67,7 +67,7 @@ void test_GE_botones_leds(void){
     rt_GE_iniciar(10);
     LOG_INFO("Gestor de eventos iniciado");
 
-    drv_botones_iniciar(test_boton_cb, ev_PULSAR_BOTON, ev_BOTON_RETARDO);
+    drv_botones_iniciar(test_boton_cb, ev_PULSAR_BOTON, ev_SOLTAR_BOTON);
     LOG_INFO("Driver de botones iniciado");
     
     svc_GE_suscribir(ev_PULSAR_BOTON, 2, test_boton_cb);
@@ -21,7 +21,22 @@ void drv_consumo_esperar(void) {
     hal_consumo_esperar();
 }
 
+/* Espera ligera soltando el reloj de alta frecuencia */
+void drv_consumo_reposo(void) {
+    hal_consumo_reposo();
+}
+
 /* Pone el micro en modo sueo profundo (no retorna) */
 void drv_consumo_dormir(void) {
     hal_consumo_dormir();
 }
+
+/* true si el arranque actual viene de despertar del sueo profundo */
+bool drv_consumo_despertado(void) {
+    return hal_consumo_despertado();
+}
+
+/* RAM que se conserva durante el sueo profundo */
+void* drv_consumo_ram_retenida(uint32_t *bytes) {
+    return hal_consumo_ram_retenida(bytes);
+}
@@ -20,7 +20,16 @@ void drv_consumo_iniciar(void);
 /* Pone el micro en espera ligera (Wait For Interrupt) */
 void drv_consumo_esperar(void);
 
+/* Espera ligera soltando el reloj de alta frecuencia */
+void drv_consumo_reposo(void);
+
 /* Pone el micro en modo sueo profundo (no retorna) */
 void drv_consumo_dormir(void);
 
+/* true si el arranque actual viene de despertar del sueo profundo */
+bool drv_consumo_despertado(void);
+
+/* RAM que se conserva durante el sueo profundo */
+void* drv_consumo_ram_retenida(uint32_t *bytes);
+
 #endif /* DRV_CONSUMO_H */
@@ -0,0 +1,85 @@
+/* *****************************************************************************
+ * P.H.2025: drv_dominio.c
+ * Dominios de alimentacion con cuenta de referencias
+ *
+ * Autores: Alejandro Lacosta, Pablo Villa
+ *
+ * Notas:
+ *  - La cuenta y el cambio de estado van en seccion critica: la UART suelta
+ *    su dominio desde el lanzador pero otros drivers pueden hacerlo desde
+ *    una ISR.
+ *  - Un dominio con padre lo adquiere al encenderse y lo suelta al
+ *    apagarse, despues de apagar su propio hardware.
+ * *****************************************************************************/
+
+#include "drv_dominio.h"
+#include "drv_tiempo.h"
+#include "hal_uart.h"
+#include "hal_consumo.h"
+#include "hal_SC.h"
+#include <stddef.h>
+
+#define SIN_PADRE  DRV_DOMINIOS
+
+typedef struct {
+    const char   *nombre;
+    void        (*alimentar)(bool encender);
+    drv_dominio_t padre;
+} dominio_t;
+
+static const dominio_t DOMINIOS[DRV_DOMINIOS] = {
+    [DRV_DOMINIO_UART]  = { "uart",  hal_uart_alimentar, DRV_DOMINIO_HFCLK },
+    [DRV_DOMINIO_HFCLK] = { "hfclk", hal_consumo_hfclk,  SIN_PADRE },
+};
+
+static uint8_t     s_refs[DRV_DOMINIOS];
+static uint32_t    s_encendidos[DRV_DOMINIOS];
+static Tiempo_us_t s_desde_us[DRV_DOMINIOS];
+static uint64_t    s_encendido_us[DRV_DOMINIOS];
+
+void drv_dominio_adquirir(drv_dominio_t d) {
+    if (d >= DRV_DOMINIOS) return;
+
+    hal_sc_entrar();
+    if (s_refs[d]++ == 0) {
+        if (DOMINIOS[d].padre != SIN_PADRE) drv_dominio_adquirir(DOMINIOS[d].padre);
+        DOMINIOS[d].alimentar(true);
+        s_encendidos[d]++;
+        s_desde_us[d] = drv_tiempo_actual_us();
+    }
+    hal_sc_salir();
+}
+
+void drv_dominio_soltar(drv_dominio_t d) {
+    if (d >= DRV_DOMINIOS) return;
+
+    hal_sc_entrar();
+    if (s_refs[d] > 0 && --s_refs[d] == 0) {
+        DOMINIOS[d].alimentar(false);
+        s_encendido_us[d] += drv_tiempo_actual_us() - s_desde_us[d];
+        if (DOMINIOS[d].padre != SIN_PADRE) drv_dominio_soltar(DOMINIOS[d].padre);
+    }
+    hal_sc_salir();
+}
+
+bool drv_dominio_encendido(drv_dominio_t d) {
+    return (d < DRV_DOMINIOS) && s_refs[d] > 0;
+}
+
+uint32_t drv_dominio_encendidos(drv_dominio_t d) {
+    return (d < DRV_DOMINIOS) ? s_encendidos[d] : 0;
+}
+
+uint32_t drv_dominio_encendido_ms(drv_dominio_t d) {
+    if (d >= DRV_DOMINIOS) return 0;
+
+    hal_sc_entrar();
+    uint64_t us = s_encendido_us[d];
+    if (s_refs[d] > 0) us += drv_tiempo_actual_us() - s_desde_us[d];
+    hal_sc_salir();
+    return (uint32_t)(us / 1000u);
+}
+
+const char* drv_dominio_nombre(drv_dominio_t d) {
+    return (d < DRV_DOMINIOS) ? DOMINIOS[d].nombre : "?";
+}
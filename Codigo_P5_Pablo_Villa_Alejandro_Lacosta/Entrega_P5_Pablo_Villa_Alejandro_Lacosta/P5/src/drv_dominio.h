@@ -0,0 +1,70 @@
+/******************************************************************************
+ * Fichero: drv_dominio.h
+ * Proyecto: P.H.2025
+ *
+ * Dominios de alimentacion con cuenta de referencias.
+ *
+ * Cada dominio es un recurso que gasta aunque no se use (la UART, el
+ * oscilador de alta frecuencia). Los drivers lo adquieren mientras lo
+ * necesitan y lo sueltan al acabar; el dominio se enciende con la primera
+ * referencia y se apaga con la ultima.
+ *
+ *  - UART:  periferico de la linea serie (nRF: UARTE0, LPC: PCONP UART1).
+ *           Depende de HFCLK: mientras esta encendido lo mantiene pedido.
+ *  - HFCLK: cristal de alta frecuencia (solo nRF; en LPC no se apaga).
+ *
+ * Adquirir y soltar pueden llamarse desde interrupcion. Se lleva la cuenta
+ * de encendidos y del tiempo encendido de cada dominio.
+ *
+ * Autores:
+ *   Alejandro Lacosta
+ *   Pablo Villa
+ *
+ * Universidad de Zaragoza
+ *
+ *****************************************************************************/
+
+#ifndef DRV_DOMINIO_H
+#define DRV_DOMINIO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum {
+    DRV_DOMINIO_UART = 0,
+    DRV_DOMINIO_HFCLK,
+    DRV_DOMINIOS
+} drv_dominio_t;
+
+/**
+ * @brief Anade una referencia; enciende el dominio si era la primera.
+ */
+void drv_dominio_adquirir(drv_dominio_t d);
+
+/**
+ * @brief Quita una referencia; apaga el dominio si era la ultima.
+ *        Soltar un dominio sin referencias no hace nada.
+ */
+void drv_dominio_soltar(drv_dominio_t d);
+
+/**
+ * @brief Indica si el dominio esta encendido.
+ */
+bool drv_dominio_encendido(drv_dominio_t d);
+
+/**
+ * @brief Veces que se ha encendido el dominio.
+ */
+uint32_t drv_dominio_encendidos(drv_dominio_t d);
+
+/**
+ * @brief Tiempo total encendido (ms), incluido el tramo en curso.
+ */
+uint32_t drv_dominio_encendido_ms(drv_dominio_t d);
+
+/**
+ * @brief Nombre corto del dominio (para trazas y la shell).
+ */
+const char* drv_dominio_nombre(drv_dominio_t d);
+
+#endif // DRV_DOMINIO_H
@@ -15,15 +15,40 @@
  *   - hal_gpio_sentido(pin, HAL_GPIO_PIN_DIR_*)
  *   - hal_gpio_escribir(pin, valor)
  *   - hal_gpio_leer(pin)            => 0/1
+ *   - hal_gpio_escribir_puerto(puerto, alto, bajo)
+ *
+ * Requiere de hal_pwm.h (brillo y fundidos, un canal por LED):
+ *   - hal_pwm_iniciar, hal_pwm_nivel, hal_pwm_rampa, hal_pwm_soltar
+ *
+ * Un LED con brillo queda en manos del PWM hasta que se vuelve a fijar
+ * con drv_led_establecer / drv_leds_escribir_mascara (que lo sueltan).
  */
 
 #include "hal_gpio.h"
+#include "hal_pwm.h"
 #include "drv_leds.h"
 #include "board.h"
+#include "rt_fifo.h"
+#include "svc_alarmas.h"
+#include "svc_GE.h"
+#include "drv_tiempo.h"
 
 
 #if LEDS_NUMBER > 0
 	static const HAL_GPIO_PIN_T s_led_list[LEDS_NUMBER] = LEDS_LIST;
+
+/* Traduccion mascara logica -> registros, calculada en drv_leds_iniciar.
+ * La mascara se procesa por nibbles: s_alto[n][v][p] son los pines del
+ * puerto p que deben quedar a nivel alto cuando el nibble n de la mascara
+ * vale v. s_pines[p] son todos los pines de LED del puerto p. */
+#define NUM_PUERTOS  2
+#define NUM_NIBBLES  ((LEDS_NUMBER + 3) / 4)
+	static uint32_t s_alto[NUM_NIBBLES][16][NUM_PUERTOS];
+	static uint32_t s_pines[NUM_PUERTOS];
+
+/* LEDs controlados por el PWM (bit i = LED i+1) y su brillo final */
+	static uint8_t s_pwm = 0;
+	static uint8_t s_brillo[LEDS_NUMBER];
 #endif
 
 /* Helpers ------------------------------------------------------------------ */
@@ -59,23 +84,63 @@ static inline LED_status_t status_from_hw_level(uint32_t level) {
 #endif
 }
 
+#if LEDS_NUMBER > 0
+static void precalcular_mascaras(void) {
+    for (unsigned p = 0; p < NUM_PUERTOS; ++p) s_pines[p] = 0;
+
+    for (unsigned i = 0; i < LEDS_NUMBER; ++i) {
+        uint32_t puerto = s_led_list[i] / 32u;
+        uint32_t bit    = 1UL << (s_led_list[i] % 32u);
+        if (puerto >= NUM_PUERTOS) continue;
+        s_pines[puerto] |= bit;
+    }
+
+    for (unsigned n = 0; n < NUM_NIBBLES; ++n) {
+        for (unsigned v = 0; v < 16; ++v) {
+            for (unsigned p = 0; p < NUM_PUERTOS; ++p) s_alto[n][v][p] = 0;
+
+            for (unsigned b = 0; b < 4 && n * 4 + b < LEDS_NUMBER; ++b) {
+                HAL_GPIO_PIN_T pin = s_led_list[n * 4 + b];
+                LED_status_t st = (v & (1u << b)) ? LED_ON : LED_OFF;
+                if (pin / 32u < NUM_PUERTOS && hw_level_from_status(st))
+                    s_alto[n][v][pin / 32u] |= 1UL << (pin % 32u);
+            }
+        }
+    }
+}
+#endif
+
 /* API ---------------------------------------------------------------------- */
 
 unsigned int drv_leds_iniciar(){
 	#if LEDS_NUMBER > 0
     for (LED_id_t i = 1; i <= (LED_id_t)LEDS_NUMBER; ++i) {
         hal_gpio_sentido(s_led_list[i-1], HAL_GPIO_PIN_DIR_OUTPUT);
-        /* Apagar por defecto respetando activo-alto/bajo */
-        hal_gpio_escribir(s_led_list[i-1], hw_level_from_status(LED_OFF));
     }
+    precalcular_mascaras();
+    hal_pwm_iniciar(s_led_list, (uint8_t)LEDS_NUMBER, LEDS_ACTIVE_STATE);
+    s_pwm = 0;
+    /* Apagar por defecto respetando activo-alto/bajo */
+    drv_leds_escribir_mascara(0);
   #endif //LEDS_NUMBER > 0	
 	
 	return (unsigned int)LEDS_NUMBER;  //definido en board_xxx.h en cada placa... 
 }
 
+#if LEDS_NUMBER > 0
+/* Devuelve al GPIO los LEDs de 'mascara' que estuvieran en el PWM. */
+static void soltar_pwm(uint8_t mascara) {
+    uint8_t sueltos = s_pwm & mascara;
+    for (uint8_t i = 0; sueltos != 0; i++, sueltos >>= 1)
+        if (sueltos & 1u) hal_pwm_soltar(i);
+    s_pwm &= (uint8_t)~mascara;
+}
+#endif
+
 int drv_led_establecer(LED_id_t id, LED_status_t estado) {
 #if LEDS_NUMBER > 0
     if (!led_id_valido(id)) return 0;
+    soltar_pwm((uint8_t)(1u << (id - 1)));
     hal_gpio_escribir(s_led_list[id-1], hw_level_from_status(estado));
     return 1;
 #else
@@ -87,6 +152,10 @@ int drv_led_establecer(LED_id_t id, LED_status_t estado) {
 int drv_led_estado(LED_id_t id, LED_status_t *out_estado) {
 #if LEDS_NUMBER > 0
     if (!led_id_valido(id) || !out_estado) return 0;
+    if (s_pwm & (1u << (id - 1))) {
+        *out_estado = (s_brillo[id-1] != 0) ? LED_ON : LED_OFF;
+        return 1;
+    }
     int lvl = hal_gpio_leer(s_led_list[id-1]);
     *out_estado = status_from_hw_level(lvl);
     return 1;
@@ -109,4 +178,104 @@ int drv_led_conmutar(LED_id_t id) {
 #endif
 }
 
-//otras???
+int drv_led_brillo(LED_id_t id, uint8_t nivel) {
+#if LEDS_NUMBER > 0
+    if (!led_id_valido(id) || id > HAL_PWM_CANALES) return 0;
+    s_pwm |= (uint8_t)(1u << (id - 1));
+    s_brillo[id-1] = nivel;
+    hal_pwm_nivel((uint8_t)(id - 1), nivel);
+    return 1;
+#else
+    (void)id; (void)nivel;
+    return 0;
+#endif
+}
+
+int drv_led_fundido(LED_id_t id, uint8_t desde, uint8_t hasta, uint32_t ms) {
+#if LEDS_NUMBER > 0
+    if (!led_id_valido(id) || id > HAL_PWM_CANALES) return 0;
+    s_pwm |= (uint8_t)(1u << (id - 1));
+    s_brillo[id-1] = hasta;
+    hal_pwm_rampa((uint8_t)(id - 1), desde, hasta, ms);
+    return 1;
+#else
+    (void)id; (void)desde; (void)hasta; (void)ms;
+    return 0;
+#endif
+}
+
+void drv_leds_escribir_mascara(uint8_t mascara) {
+#if LEDS_NUMBER > 0
+    soltar_pwm(0xFFu);
+    for (unsigned p = 0; p < NUM_PUERTOS; ++p) {
+        if (s_pines[p] == 0) continue;
+
+        uint32_t alto = 0;
+        for (unsigned n = 0; n < NUM_NIBBLES; ++n)
+            alto |= s_alto[n][(mascara >> (4 * n)) & 0x0Fu][p];
+
+        hal_gpio_escribir_puerto(p, alto, s_pines[p] & ~alto);
+    }
+#else
+    (void)mascara;
+#endif
+}
+
+/* Animaciones -------------------------------------------------------------- */
+
+static const drv_leds_animacion_t *s_anim = NULL;
+static uint8_t  s_fotograma;
+static uint8_t  s_vuelta;
+static uint32_t s_ev_fin, s_aux_fin;
+static uint32_t s_vence_ms;              // fin del fotograma actual (absoluto)
+static uint8_t  s_generacion;            // aux de ev_LED_ANIMACION de la animacion actual
+
+/* Muestra el fotograma actual y programa su fin contra el instante absoluto
+ * en que acaba, para que la duracion total no acumule retrasos. */
+static void mostrar_fotograma(void) {
+    const drv_leds_fotograma_t *f = &s_anim->fotogramas[s_fotograma];
+    drv_leds_escribir_mascara(f->mascara);
+    s_vence_ms += f->duracion_ms;
+    svc_alarma_activar_en(s_vence_ms, ev_LED_ANIMACION, s_generacion);
+}
+
+/* Un ev_LED_ANIMACION ya encolado de una animacion anterior (parada o
+ * sustituida) lleva otra generacion: se ignora. */
+static void drv_leds_animacion_cb(EVENTO_T ev, uint32_t aux) {
+    if (ev != ev_LED_ANIMACION || s_anim == NULL || aux != s_generacion) return;
+
+    if (++s_fotograma >= s_anim->num_fotogramas) {
+        s_fotograma = 0;
+        if (s_anim->repeticiones != 0 && ++s_vuelta >= s_anim->repeticiones) {
+            s_anim = NULL;
+            if (s_ev_fin != ev_VOID) rt_FIFO_encolar(s_ev_fin, s_aux_fin);
+            return;
+        }
+    }
+    mostrar_fotograma();
+}
+SVC_GE_SUSCRIPCION_ESTATICA(ev_LED_ANIMACION, 1, drv_leds_animacion_cb);
+
+void drv_leds_animar(const drv_leds_animacion_t *anim, uint32_t ev_fin, uint32_t aux_fin) {
+    if (anim == NULL || anim->num_fotogramas == 0) return;
+
+    drv_leds_animacion_parar();
+    s_generacion++;
+    s_anim = anim;
+    s_fotograma = 0;
+    s_vuelta = 0;
+    s_ev_fin = ev_fin;
+    s_aux_fin = aux_fin;
+    s_vence_ms = drv_tiempo_actual_ms();
+    mostrar_fotograma();
+}
+
+void drv_leds_animacion_parar(void) {
+    if (s_anim == NULL) return;
+    s_anim = NULL;
+    svc_alarma_desactivar(ev_LED_ANIMACION, s_generacion);
+}
+
+bool drv_leds_animando(void) {
+    return s_anim != NULL;
+}
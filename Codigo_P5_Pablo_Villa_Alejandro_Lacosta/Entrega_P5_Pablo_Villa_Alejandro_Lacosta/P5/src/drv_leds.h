@@ -16,6 +16,7 @@
  *   - hal_gpio_sentido(HAL_GPIO_PIN_T gpio, hal_gpio_pin_dir_t dir)
  *   - hal_gpio_escribir(HAL_GPIO_PIN_T gpio, uint32_t valor)   // void
  *   - hal_gpio_leer(HAL_GPIO_PIN_T gpio) -> uint32_t (0/1)
+ *   - hal_gpio_escribir_puerto(puerto, alto, bajo)
  */
 
 #ifndef DRV_LEDS_H
@@ -24,6 +25,8 @@
 #include <stdint.h>
 #include <stddef.h>
 
+#include <stdbool.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -72,6 +75,81 @@ int drv_led_estado(LED_id_t id, LED_status_t *out_estado);
  */
 int drv_led_conmutar(LED_id_t id);
 
+/* ---- Brillo (PWM) ------------------------------------------------------- */
+
+#define DRV_LED_BRILLO_MAX 255u
+
+/**
+ * @brief Fija el brillo de un LED (0 = apagado, DRV_LED_BRILLO_MAX = maximo).
+ *
+ * El LED pasa a controlarlo el PWM hasta la siguiente llamada a
+ * drv_led_establecer / drv_leds_escribir_mascara sobre el.
+ *
+ * @return 1 si ok, 0 si id fuera de rango o sin canal PWM.
+ */
+int drv_led_brillo(LED_id_t id, uint8_t nivel);
+
+/**
+ * @brief Fundido de 'desde' a 'hasta' en 'ms' milisegundos; el LED se queda
+ *        en 'hasta'. En nRF lo recorre el hardware sin despertar a la CPU.
+ *
+ * @return 1 si ok, 0 si id fuera de rango o sin canal PWM.
+ */
+int drv_led_fundido(LED_id_t id, uint8_t desde, uint8_t hasta, uint32_t ms);
+
+/**
+ * @brief Fija el estado de todos los LEDs a la vez.
+ *
+ * Una sola escritura por puerto GPIO: todos los LEDs cambian en el mismo
+ * instante. La traduccion a registros se precalcula en drv_leds_iniciar.
+ *
+ * @param mascara Bit i = 1 enciende el LED i+1; a 0 lo apaga.
+ */
+void drv_leds_escribir_mascara(uint8_t mascara);
+
+/* ---- Animaciones ---------------------------------------------------------
+ *
+ * Tablas de fotogramas constantes (en flash): cada fotograma es una mascara
+ * de LEDs (bit i = LED i+1) y cuanto dura. La animacion se repite
+ * 'repeticiones' veces (0 = indefinidamente) y al acabar encola ev_fin/aux_fin.
+ *
+ * Un unico temporizador (alarma ev_LED_ANIMACION) avanza los fotogramas; el
+ * juego solo recibe el evento de fin.
+ */
+
+typedef struct {
+    uint8_t  mascara;
+    uint16_t duracion_ms;
+} drv_leds_fotograma_t;
+
+typedef struct {
+    const drv_leds_fotograma_t *fotogramas;
+    uint8_t num_fotogramas;
+    uint8_t repeticiones;
+} drv_leds_animacion_t;
+
+#define DRV_LEDS_NUM_FOTOGRAMAS(tabla) ((uint8_t)(sizeof(tabla) / sizeof((tabla)[0])))
+
+/**
+ * @brief Arranca una animacion (sustituye a la que estuviera en curso).
+ *
+ * @param anim   Tabla de fotogramas (debe seguir existiendo: const/flash).
+ * @param ev_fin Evento a encolar al terminar (ev_VOID = ninguno).
+ * @param aux_fin Dato auxiliar del evento de fin.
+ */
+void drv_leds_animar(const drv_leds_animacion_t *anim, uint32_t ev_fin, uint32_t aux_fin);
+
+/**
+ * @brief Detiene la animacion en curso sin encolar el evento de fin.
+ *        Los LEDs quedan como estuvieran.
+ */
+void drv_leds_animacion_parar(void);
+
+/**
+ * @brief Indica si hay una animacion en curso.
+ */
+bool drv_leds_animando(void);
+
 #if 0
 /* ---- Funciones opcionales de alto nivel ---- */
 
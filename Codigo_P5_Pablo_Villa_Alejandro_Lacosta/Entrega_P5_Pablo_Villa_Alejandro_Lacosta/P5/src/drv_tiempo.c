@@ -76,6 +76,22 @@ void drv_tiempo_periodico_ms(Tiempo_ms_t ms,void(*funcion_callback_app)(), uint3
 
 }
 
+/**
+ * Pospone el siguiente tick 'ms' milisegundos (en ticks de 32768 Hz,
+ * redondeando hacia abajo para no pasarse del vencimiento)
+ */
+void drv_tiempo_periodico_posponer_ms(Tiempo_ms_t ms) {
+    hal_tiempo_periodico_posponer((uint32_t)(((uint64_t)ms * 32768u) / 1000u));
+}
+
+void drv_tiempo_periodico_reanudar(void) {
+    hal_tiempo_periodico_reanudar();
+}
+
+void drv_tiempo_periodico_habilitar(bool habilitar) {
+    hal_tiempo_periodico_enable(habilitar);
+}
+
 uint32_t drv_tiempo_get_evento_id(void) {
     return s_ID_evento;
 }
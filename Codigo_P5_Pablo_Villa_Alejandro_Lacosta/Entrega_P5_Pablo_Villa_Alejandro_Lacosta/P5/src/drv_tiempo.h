@@ -29,4 +29,14 @@ Tiempo_ms_t drv_tiempo_esperar_hasta_ms(Tiempo_ms_t deadline_ms);
 /* Temporizador peridico en ms, ejecuta callback cada periodo */
 void drv_tiempo_periodico_ms(Tiempo_ms_t ms,void(*funcion_callback_app)(), uint32_t ID_evento);
 
+/* Retrasa el siguiente disparo del peridico 'ms' (dormir sin tick) */
+void drv_tiempo_periodico_posponer_ms(Tiempo_ms_t ms);
+
+/* Vuelve al periodo normal si se ha despertado antes del disparo pospuesto */
+void drv_tiempo_periodico_reanudar(void);
+
+/* Para o rearranca el peridico; al rearrancar el primer disparo llega un
+ * periodo despus de la llamada */
+void drv_tiempo_periodico_habilitar(bool habilitar);
+
 #endif // DRV_TIEMPO_H
@@ -12,23 +12,283 @@
  *
  *****************************************************************************/
  
+#include "drv_uart.h"
 #include "hal_uart.h"
+#include "drv_dominio.h"
+#include "rt_fifo.h"
+#include "svc_GE.h"
+#include "svc_energia.h"
 #include <stddef.h>
+#include <string.h>
+
+#define RX_MASK (DRV_UART_RX_TAM - 1u)
+
+// Cola circular de transmision: escribe el dispatcher, consume la ISR
+typedef struct {
+    volatile uint8_t *buf;
+    uint32_t          mascara;
+    volatile uint32_t escr;
+    volatile uint32_t lect;
+} cola_tx_t;
+
+static volatile uint8_t s_tx_normal_buf[DRV_UART_TX_TAM];
+static volatile uint8_t s_tx_alta_buf[DRV_UART_TX_ALTA_TAM];
+static cola_tx_t s_tx_normal = { s_tx_normal_buf, DRV_UART_TX_TAM - 1u, 0, 0 };
+static cola_tx_t s_tx_alta   = { s_tx_alta_buf, DRV_UART_TX_ALTA_TAM - 1u, 0, 0 };
+static cola_tx_t *s_tx_actual = NULL;   // cola con una linea a medio enviar (solo ISR)
+static bool s_tx_iniciado = false;
+static bool s_tx_alimentada = false;    // la transmision tiene el dominio UART
+static volatile bool s_tx_soltar = false;   // ev_UART_TX_VACIA encolado para soltarlo
+static volatile uint32_t s_ev_vacia = ev_VOID;  // aviso pedido al vaciarse
+
+// Buffer circular de recepcion: escribe la ISR, lee el dispatcher
+static volatile char     s_rx_buf[DRV_UART_RX_TAM];
+static volatile uint32_t s_rx_escr = 0;
+static volatile uint32_t s_rx_lect = 0;
+static volatile uint32_t s_rx_descartados = 0;
+static uint32_t s_rx_long_linea = 0;   // caracteres de la linea en curso (solo ISR)
+static bool s_rx_desbordada = false;   // la linea en curso no cabe (solo ISR)
+static uint32_t s_ev_linea;
+
+static inline uint32_t cola_libre(const cola_tx_t *c) {
+    return (c->mascara + 1u) - (c->escr - c->lect);
+}
+
+static inline bool cola_vacia(const cola_tx_t *c) {
+    return c->escr == c->lect;
+}
+
+/* Copia len bytes y los publica de una vez (la ISR no ve mensajes a medias). */
+static void cola_escribir(cola_tx_t *c, const char *msg, uint32_t len) {
+    uint32_t escr = c->escr;
+    for (uint32_t i = 0; i < len; i++) {
+        c->buf[(escr + i) & c->mascara] = (uint8_t)msg[i];
+    }
+    c->escr = escr + len;
+}
+
+/**
+ * Callback de transmision (contexto de ISR). Termina la linea en curso y,
+ * en cada frontera de linea, da preferencia a la cola prioritaria. Al
+ * quedarse sin datos encola el aviso pedido, si lo hay, y ev_UART_TX_VACIA
+ * para soltar el dominio UART desde el lanzador.
+ */
+static uint32_t drv_uart_tx_callback(uint8_t *buf, uint32_t max) {
+    uint32_t n = 0;
+    while (n < max) {
+        cola_tx_t *c = s_tx_actual;
+        if (c == NULL || cola_vacia(c)) {
+            if (!cola_vacia(&s_tx_alta))        c = &s_tx_alta;
+            else if (!cola_vacia(&s_tx_normal)) c = &s_tx_normal;
+            else {
+                if (s_tx_alimentada && !s_tx_soltar) {
+                    s_tx_soltar = true;
+                    rt_FIFO_encolar(ev_UART_TX_VACIA, 0);
+                    if (s_ev_vacia == ev_UART_TX_VACIA) s_ev_vacia = ev_VOID;
+                }
+                if (s_ev_vacia != ev_VOID) {
+                    rt_FIFO_encolar(s_ev_vacia, 0);
+                    s_ev_vacia = ev_VOID;
+                }
+                break;
+            }
+        }
+        uint8_t b = c->buf[c->lect & c->mascara];
+        c->lect++;
+        buf[n++] = b;
+        s_tx_actual = (b == '\n') ? NULL : c;
+    }
+    return n;
+}
+
+/**
+ * Adquiere el dominio UART (si no lo tiene ya) y arranca la transmision.
+ */
+static void tx_arrancar(void) {
+    if (!s_tx_alimentada) {
+        s_tx_alimentada = true;
+        drv_dominio_adquirir(DRV_DOMINIO_UART);
+    }
+    hal_uart_tx_arrancar();
+}
+
+/**
+ * Suelta el dominio UART si la transmision lo tiene y no queda nada
+ * encolado. Solo desde el lanzador, igual que tx_arrancar; apagar la UART
+ * espera a que salga el ultimo byte.
+ */
+static void tx_soltar(void) {
+    s_tx_soltar = false;
+    if (s_tx_alimentada && cola_vacia(&s_tx_alta) && cola_vacia(&s_tx_normal)) {
+        s_tx_alimentada = false;
+        drv_dominio_soltar(DRV_DOMINIO_UART);
+    }
+}
+
+static void drv_uart_tx_vacia_cb(EVENTO_T ev, uint32_t aux) {
+    (void)ev;
+    (void)aux;
+    tx_soltar();
+}
+SVC_GE_SUSCRIPCION_ESTATICA(ev_UART_TX_VACIA, 0, drv_uart_tx_vacia_cb);
+
+/**
+ * Veto de energia: con bytes por enviar la UART necesita el reloj de alta
+ * frecuencia (el tick si puede posponerse).
+ */
+static svc_energia_modo_t drv_uart_veto(void) {
+    if (!cola_vacia(&s_tx_alta) || !cola_vacia(&s_tx_normal) || hal_uart_tx_ocupada())
+        return SVC_ENERGIA_SIN_TICK;
+    return SVC_ENERGIA_APAGADO;
+}
 
 /**
  * Inicia el controlador del uart
  */
 void drv_uart_init(void) {
+    if (s_tx_iniciado) return;
     hal_uart_init();
+    hal_uart_tx_iniciar(drv_uart_tx_callback);
+    hal_uart_alimentar(false);      // configurada; la enciende el dominio UART
+    svc_energia_registrar_veto(drv_uart_veto);
+    s_tx_iniciado = true;
 }
 
 /**
- * Escribe un mensaje por la linea serie.
+ * Escribe un mensaje por la linea serie. Bloquea mientras la cola normal
+ * este llena; los mensajes largos se entregan por trozos.
  */
 void drv_uart_send(const char *msg) {
     if (msg == NULL) return;
 
-    while (*msg != '\0') {         
-			hal_uart_sendchar(*msg++); // Enviar cada car?cter con hal_uart_sendchar
+    if (!s_tx_iniciado) {
+        while (*msg != '\0') {
+            hal_uart_sendchar(*msg++); // Sin interrupciones: envio directo
+        }
+        return;
+    }
+
+    uint32_t pendiente = (uint32_t)strlen(msg);
+    while (pendiente > 0) {
+        uint32_t libre = cola_libre(&s_tx_normal);
+        if (libre == 0) {
+            tx_arrancar();
+            continue;
+        }
+        uint32_t n = (pendiente < libre) ? pendiente : libre;
+        cola_escribir(&s_tx_normal, msg, n);
+        msg += n;
+        pendiente -= n;
+        tx_arrancar();
     }
 }
+
+/**
+ * Encola un mensaje completo sin bloquear; lo descarta si no cabe.
+ */
+bool drv_uart_encolar(const char *msg, bool prioritario) {
+    if (msg == NULL || !s_tx_iniciado) return false;
+
+    cola_tx_t *c = prioritario ? &s_tx_alta : &s_tx_normal;
+    uint32_t len = (uint32_t)strlen(msg);
+    if (len > cola_libre(c)) return false;
+
+    cola_escribir(c, msg, len);
+    tx_arrancar();
+    return true;
+}
+
+/**
+ * Espera a que se transmita todo lo encolado.
+ */
+void drv_uart_vaciar(void) {
+    if (!s_tx_iniciado) return;
+    tx_arrancar();
+    while (!cola_vacia(&s_tx_alta) || !cola_vacia(&s_tx_normal) || hal_uart_tx_ocupada()) { }
+    tx_soltar();
+}
+
+void drv_uart_avisar_vacia(uint32_t ev_vacia) {
+    s_ev_vacia = ev_vacia;
+}
+
+/**
+ * Callback de recepcion (contexto de ISR). Guarda el caracter y al cerrar
+ * una linea no vacia la notifica al runtime. Siempre queda sitio para el
+ * terminador; si un caracter no cabe, la linea entera se descarta al
+ * cerrarse (nunca se entrega truncada ni pegada a la siguiente).
+ */
+static void drv_uart_rx_callback(char c) {
+    if (c == '\r' || c == '\n') {
+        if (s_rx_desbordada) {
+            // Lo ya escrito no tiene terminador: el lector no lo ha consumido
+            s_rx_escr -= s_rx_long_linea;
+            s_rx_descartados += s_rx_long_linea;
+            s_rx_long_linea = 0;
+            s_rx_desbordada = false;
+            return;
+        }
+        if (s_rx_long_linea == 0) return;          // Lineas vacias o "\r\n"
+        c = '\0';
+    } else if (s_rx_desbordada || (s_rx_escr - s_rx_lect) >= DRV_UART_RX_TAM - 1u) {
+        s_rx_desbordada = true;
+        s_rx_descartados++;
+        return;
+    }
+    s_rx_buf[s_rx_escr & RX_MASK] = c;
+    s_rx_escr++;
+
+    if (c == '\0') {
+        rt_FIFO_encolar(s_ev_linea, s_rx_long_linea);
+        s_rx_long_linea = 0;
+    } else {
+        s_rx_long_linea++;
+    }
+}
+
+/**
+ * Habilita la recepcion por interrupcion. Escuchar exige la UART
+ * encendida: la recepcion se queda el dominio UART para siempre.
+ */
+void drv_uart_rx_iniciar(uint32_t ev_linea) {
+    static bool s_rx_alimentada = false;
+
+    s_ev_linea = ev_linea;
+    s_rx_escr = s_rx_lect = 0;
+    s_rx_long_linea = 0;
+    s_rx_desbordada = false;
+    s_rx_descartados = 0;
+    if (!s_rx_alimentada) {
+        s_rx_alimentada = true;
+        drv_dominio_adquirir(DRV_DOMINIO_UART);
+    }
+    hal_uart_rx_iniciar(drv_uart_rx_callback);
+}
+
+/**
+ * Extrae la linea mas antigua del buffer de recepcion.
+ */
+uint32_t drv_uart_leer_linea(char *dst, uint32_t max) {
+    uint32_t lect = s_rx_lect;
+    uint32_t escr = s_rx_escr;
+    uint32_t n = 0;
+
+    if (dst == NULL || max == 0) return 0;
+
+    while (lect != escr) {
+        char c = s_rx_buf[lect & RX_MASK];
+        lect++;
+        if (c == '\0') {
+            dst[n] = '\0';
+            s_rx_lect = lect;
+            return n;
+        }
+        if (n < max - 1) dst[n++] = c;
+    }
+    dst[0] = '\0';
+    return 0;                                       // Linea aun incompleta
+}
+
+uint32_t drv_uart_rx_descartados(void) {
+    return s_rx_descartados;
+}
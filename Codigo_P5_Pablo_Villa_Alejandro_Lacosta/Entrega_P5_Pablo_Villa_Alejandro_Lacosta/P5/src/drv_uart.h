@@ -12,6 +12,18 @@
  *
  *****************************************************************************/
  
+#ifndef DRV_UART_H
+#define DRV_UART_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Tamano del buffer circular de recepcion (potencia de 2)
+#define DRV_UART_RX_TAM 64
+
+// Colas de transmision (potencias de 2): normal y prioritaria (errores)
+#define DRV_UART_TX_TAM      256
+#define DRV_UART_TX_ALTA_TAM 128
 
 /**
  * Inicia el controlador del uart
@@ -19,6 +31,47 @@
 void drv_uart_init(void);
 
 /**
- * Escribe un mensaje por la linea serie.
+ * Escribe un mensaje por la linea serie. Se encola en la cola normal y
+ * solo bloquea mientras no haya hueco (comportamiento historico).
  */
 void drv_uart_send(const char* message);
+
+/**
+ * Encola un mensaje completo sin bloquear nunca. Si no cabe entero se
+ * descarta y devuelve false. Los mensajes prioritarios adelantan a los
+ * normales en la siguiente frontera de linea.
+ */
+bool drv_uart_encolar(const char *msg, bool prioritario);
+
+/**
+ * Espera a que se haya transmitido todo lo encolado y suelta el dominio
+ * UART (antes de dormir).
+ */
+void drv_uart_vaciar(void);
+
+/**
+ * Pide que se encole ev_vacia (una sola vez) cuando la transmision se
+ * quede sin nada que enviar. Volver a pedirlo antes sustituye el evento.
+ */
+void drv_uart_avisar_vacia(uint32_t ev_vacia);
+
+/**
+ * Habilita la recepcion por interrupcion. Los caracteres se acumulan en un
+ * buffer circular y al recibir fin de linea ('\r' o '\n') se encola el
+ * evento ev_linea con la longitud de la linea como dato auxiliar.
+ */
+void drv_uart_rx_iniciar(uint32_t ev_linea);
+
+/**
+ * Extrae la linea mas antigua del buffer de recepcion (sin terminador).
+ * Devuelve la longitud copiada en dst (terminada en '\0'), 0 si no hay linea.
+ */
+uint32_t drv_uart_leer_linea(char *dst, uint32_t max);
+
+/**
+ * Caracteres descartados por buffer de recepcion lleno (una linea que no
+ * cabe se descarta entera).
+ */
+uint32_t drv_uart_rx_descartados(void);
+
+#endif // DRV_UART_H
@@ -20,7 +20,25 @@ void hal_consumo_iniciar(void);
 /* Pone el micro en modo espera ligero hasta la siguiente interrupcin */
 void hal_consumo_esperar(void);
 
+/* Espera como hal_consumo_esperar pero soltando el reloj de alta
+ * frecuencia (nRF: HFCLK); si estaba pedido lo recupera al despertar
+ * antes de volver */
+void hal_consumo_reposo(void);
+
+/* Pide (true) o suelta (false) el reloj de alta frecuencia (nRF: cristal
+ * HFCLK; sin efecto donde no se puede parar). Al pedirlo no se espera:
+ * hasta que arranca los perifericos tiran del oscilador interno. */
+void hal_consumo_hfclk(bool encender);
+
 /* Pone el micro en modo sueo profundo  */
 void hal_consumo_dormir(void);
 
+/* true si este arranque viene de despertar del sueo profundo (nRF:
+ * RESETREAS.OFF). La causa se lee y se limpia en la primera llamada. */
+bool hal_consumo_despertado(void);
+
+/* Zona de RAM que se conserva durante el sueo profundo; 'bytes' recibe
+ * su tamao. Su contenido tras un arranque en fro es indeterminado. */
+void* hal_consumo_ram_retenida(uint32_t *bytes);
+
 #endif /* HAL_CONSUMO_H */
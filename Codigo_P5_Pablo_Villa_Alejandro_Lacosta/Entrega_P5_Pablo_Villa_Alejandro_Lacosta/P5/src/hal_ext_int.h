@@ -34,12 +34,28 @@ typedef enum {
  */
 typedef void (*hal_ext_int_callback_t)(hal_ext_int_id_t id);
 
+/**
+ * @brief Variante del callback que recibe tambin el instante del flanco
+ *        en s, en la misma base que hal_tiempo_actual_tick64().
+ */
+typedef void (*hal_ext_int_ts_callback_t)(hal_ext_int_id_t id, uint64_t ts_us);
+
 /**
  * @brief Inicializa el sistema de interrupciones externas
  * @param cb Callback a ejecutar cuando ocurra una interrupcin
  */
 void hal_ext_int_iniciar(hal_ext_int_callback_t cb);
 
+/**
+ * @brief Inicializa las interrupciones externas con marca de tiempo del flanco.
+ *
+ * En nRF52840 el flanco se captura por hardware (GPIOTE -> PPI -> TIMER),
+ * sin latencia de entrada a la ISR. En LPC2105 la marca se toma al entrar
+ * en la ISR.
+ * @param cb Callback a ejecutar con el id y el instante del flanco
+ */
+void hal_ext_int_iniciar_ts(hal_ext_int_ts_callback_t cb);
+
 /**
  * @brief Habilita la interrupcin externa indicada
  */
@@ -0,0 +1,63 @@
+/******************************************************************************
+ * Fichero: hal_flash.h
+ * Proyecto: P.H.2025
+ *
+ * Acceso a las paginas de flash reservadas para datos persistentes.
+ *
+ * La zona tiene HAL_FLASH_PAGINAS paginas; cada una se lee directamente
+ * como memoria (hal_flash_pagina) y se escribe palabra a palabra. Como en
+ * cualquier flash NOR, escribir solo puede pasar bits de 1 a 0: para volver
+ * a escribir una palabra hay que borrar la pagina entera (todo a 1).
+ *
+ * - nRF52840: NVMC. El borrado se hace por tramos (ERASEPAGEPARTIAL) para
+ *   no bloquear la CPU los ~85 ms de un borrado completo.
+ * - LPC2105 (simulador): las paginas se emulan en RAM con la misma
+ *   semantica; sirve tambien de sustituto en las pruebas.
+ *
+ * Autores:
+ *   Alejandro Lacosta
+ *   Pablo Villa
+ *
+ * Universidad de Zaragoza
+ *
+ *****************************************************************************/
+
+#ifndef HAL_FLASH_H
+#define HAL_FLASH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define HAL_FLASH_PAGINAS  2
+#define HAL_FLASH_BORRADO  0xFFFFFFFFu
+
+/**
+ * @brief Prepara el controlador de flash.
+ */
+void hal_flash_iniciar(void);
+
+/**
+ * @brief Tamano de pagina en palabras de 32 bits.
+ */
+uint32_t hal_flash_palabras_pagina(void);
+
+/**
+ * @brief Contenido de una pagina (solo lectura, mapeado en memoria).
+ */
+const uint32_t* hal_flash_pagina(uint8_t pagina);
+
+/**
+ * @brief Escribe 'n' palabras a partir de la palabra 'offset' de la pagina.
+ *        Las palabras de destino deben estar borradas.
+ */
+void hal_flash_escribir(uint8_t pagina, uint32_t offset, const uint32_t *datos, uint32_t n);
+
+/**
+ * @brief Avanza el borrado de una pagina un tramo acotado.
+ * @return true cuando la pagina ha quedado borrada por completo.
+ *
+ * Se llama hasta que devuelva true; empezar otra pagina reinicia la cuenta.
+ */
+bool hal_flash_borrar_paso(uint8_t pagina);
+
+#endif // HAL_FLASH_H
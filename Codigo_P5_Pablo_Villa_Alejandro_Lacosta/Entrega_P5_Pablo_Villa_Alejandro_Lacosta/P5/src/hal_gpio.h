@@ -56,4 +56,24 @@ uint32_t hal_gpio_leer(HAL_GPIO_PIN_T gpio);
  */
 void hal_gpio_escribir(HAL_GPIO_PIN_T gpio, uint32_t valor);
 
+/**
+ * @brief Lee de una sola vez el nivel de todos los pines de un puerto.
+ *
+ * @param puerto ndice de puerto (pin / 32). El LPC2105 solo tiene el 0.
+ * @return Bit n = nivel del pin (puerto * 32 + n).
+ */
+uint32_t hal_gpio_leer_puerto(uint32_t puerto);
+
+/**
+ * @brief Cambia a la vez varios pines de un mismo puerto.
+ *
+ * Todos los pines cambian en la misma escritura de registro. Los pines que
+ * no aparecen en ninguna de las dos mascaras no se tocan.
+ *
+ * @param puerto ndice de puerto (pin / 32).
+ * @param alto   Bit n = 1: poner a nivel alto el pin (puerto * 32 + n).
+ * @param bajo   Bit n = 1: poner a nivel bajo el pin (puerto * 32 + n).
+ */
+void hal_gpio_escribir_puerto(uint32_t puerto, uint32_t alto, uint32_t bajo);
+
 #endif /* HAL_GPIO_H */
@@ -0,0 +1,52 @@
+/* *****************************************************************************
+ * P.H.2025: HAL PWM
+ *
+ * Modulacion por anchura de pulso para regular el brillo de los LEDs.
+ *
+ * - nRF52840: periferico PWM0 reproduciendo secuencias por EasyDMA. Un
+ *   fundido es una secuencia de escalones que el hardware recorre solo:
+ *   la CPU puede dormir mientras dura.
+ * - LPC2105: PWM por software sobre el Timer1 (match MR1). Solo genera
+ *   interrupciones mientras algun canal tiene un nivel intermedio.
+ *
+ * Cada canal se asocia a un pin al iniciar; el pin pasa a manos del PWM
+ * con la primera llamada a hal_pwm_nivel/hal_pwm_rampa y vuelve a ser un
+ * GPIO normal con hal_pwm_soltar.
+ */
+
+#ifndef HAL_PWM_H
+#define HAL_PWM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hal_gpio.h"
+
+#define HAL_PWM_CANALES    4
+#define HAL_PWM_NIVEL_MAX  255u
+
+/**
+ * @brief Prepara el PWM (no toma ningun pin todavia).
+ *
+ * @param pines       Pin de cada canal.
+ * @param num         Numero de canales (<= HAL_PWM_CANALES).
+ * @param activo_alto 1 si el nivel maximo es el pin a nivel alto, 0 si bajo.
+ */
+void hal_pwm_iniciar(const HAL_GPIO_PIN_T pines[], uint8_t num, uint32_t activo_alto);
+
+/**
+ * @brief Fija el nivel de un canal (0 = apagado, HAL_PWM_NIVEL_MAX = maximo).
+ */
+void hal_pwm_nivel(uint8_t canal, uint8_t nivel);
+
+/**
+ * @brief Lleva un canal de 'desde' a 'hasta' en 'ms' milisegundos y lo
+ *        deja en 'hasta'. Sustituye al fundido anterior del canal.
+ */
+void hal_pwm_rampa(uint8_t canal, uint8_t desde, uint8_t hasta, uint32_t ms);
+
+/**
+ * @brief Devuelve el pin del canal al control GPIO.
+ */
+void hal_pwm_soltar(uint8_t canal);
+
+#endif /* HAL_PWM_H */
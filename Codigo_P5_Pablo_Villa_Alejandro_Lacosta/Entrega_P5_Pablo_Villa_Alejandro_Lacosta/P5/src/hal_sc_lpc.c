@@ -1,5 +1,6 @@
 #include <LPC210x.H>
-#include "hal_sc.h"
+#include "compilador_lpc.h"
+#include "hal_SC.h"
 
 static uint32_t sc_nesting = 0;
 
@@ -37,9 +37,20 @@ void hal_tiempo_periodico_config_tick(uint32_t periodo_en_tick);
 /* Registra el callback llamado desde la IRQ */
 void hal_tiempo_periodico_set_callback(void (*cb)());
 
-/* Habilita/Deshabilita el reloj peridico */
+/* Habilita/Deshabilita el reloj peridico. Al habilitar el contador
+ * empieza de cero: el primer disparo llega un periodo despus */
 void hal_tiempo_periodico_enable(bool enable);
 
+/* Pospone el siguiente disparo a 'ticks' desde ahora (dormir sin tick).
+ * Tras ese disparo vuelve solo al periodo configurado. Con 'ticks' que no
+ * supera el periodo no pospone nada. Si el peridico estaba parado lo
+ * arranca, para que el disparo despierte igualmente. */
+void hal_tiempo_periodico_posponer(uint32_t ticks);
+
+/* Anula un disparo pospuesto (se ha despertado antes por otra causa):
+ * el siguiente llega un periodo despus de ahora */
+void hal_tiempo_periodico_reanudar(void);
+
 /* */ 
 void hal_tiempo_reloj_periodico_tick(uint32_t periodo_en_tick,void(*funcion_callback_drv)()); 
 
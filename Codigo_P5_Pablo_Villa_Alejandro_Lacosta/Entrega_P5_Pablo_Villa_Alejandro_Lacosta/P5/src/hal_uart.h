@@ -15,10 +15,38 @@
 #ifndef HAL_UART_H
 #define HAL_UART_H
 
+#include <stdint.h>
+#include <stdbool.h>
+
 // Inicializa la UART espec�fica de cada plataforma
 void hal_uart_init(void);
 
 // Env�a un caracter a trav�s de la UART
 int hal_uart_sendchar(char ch);
 
+// Callback invocado desde la ISR de recepcion con cada caracter recibido
+typedef void (*hal_uart_rx_callback_t)(char ch);
+
+// Habilita la recepcion por interrupcion; cada caracter se entrega al callback
+void hal_uart_rx_iniciar(hal_uart_rx_callback_t cb);
+
+// Callback de transmision (contexto de ISR): copia en buf hasta max bytes
+// pendientes y devuelve cuantos ha copiado (0 = nada mas que enviar)
+typedef uint32_t (*hal_uart_tx_callback_t)(uint8_t *buf, uint32_t max);
+
+// Habilita la transmision por interrupcion alimentada por el callback.
+// A partir de aqui no debe usarse hal_uart_sendchar.
+void hal_uart_tx_iniciar(hal_uart_tx_callback_t cb);
+
+// Arranca la transmision si el periferico esta parado (llamar tras encolar)
+void hal_uart_tx_arrancar(void);
+
+// Indica si queda una transmision en curso
+bool hal_uart_tx_ocupada(void);
+
+// Enciende o apaga el periferico conservando su configuracion. Tras
+// hal_uart_init queda encendido; despues lo gestiona el dominio
+// DRV_DOMINIO_UART. Al apagar se espera a que salga el ultimo byte.
+void hal_uart_alimentar(bool encender);
+
 #endif // HAL_UART_H
@@ -18,8 +18,14 @@
 #include "drv_wdt.h"
 #include "test.h"
 
+// Los proyectos (Keil o CMake) pueden fijarlos con -D
+#ifndef RUN_MODE
 #define RUN_MODE 0
+#endif
+
+#ifndef DEBUG
 #define DEBUG 1
+#endif
 
 #if DEBUG
 #include "drv_uart.h"
@@ -30,8 +30,8 @@
 void rt_GE_iniciar(uint32_t M_overflow);
 
 /**
- * @brief Activa la alarma de inactividad ("ev_INACTIVIDAD") y despacha eventos
- * de usuario a sus tareas suscritas. Si no hay eventos pendientes, espera.
+ * @brief Despacha eventos de usuario a sus tareas suscritas. Si no hay eventos
+ * pendientes, deja que svc_energia elija cunto dormir.
  */
 void rt_GE_lanzador(void);
 
@@ -40,8 +40,8 @@ void rt_GE_lanzador(void);
  * @param ID_evento Identificador del evento ocurrido
  * @param aux Parmetro auxiliar o dato adicional del evento
  *
- * Si ocurre un evento de usuario, reprograma la alarma.
- * Si ocurre un evento de inactividad, entra en deepSleep().
+ * Una pulsacin cuenta como actividad para svc_energia (reinicia la cuenta
+ * de inactividad que lleva al apagado).
  */
 void rt_GE_actualizar(EVENTO_T ID_evento, uint32_t aux);
 
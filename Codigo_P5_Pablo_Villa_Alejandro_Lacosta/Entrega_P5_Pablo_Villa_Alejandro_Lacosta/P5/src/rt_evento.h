@@ -27,9 +27,16 @@ typedef enum {
 	  ev_BOTON_RETARDO = 3,
 	  ev_INACTIVIDAD = 4,  // no existe actividad 
 	  ev_BEAT_TIMEOUT = 5,
+	  ev_UART_LINEA = 6,   // linea completa recibida por la UART (aux = longitud)
+	  ev_SOLTAR_BOTON = 7, // boton liberado tras el antirrebotes (aux = id)
+	  ev_BOTON_MUESTREO = 8, // interno de drv_botones: muestreo periodico
+	  ev_BOTON_GESTO = 9,  // gesto reconocido (aux = tipo << 8 | id o mascara)
+	  ev_GRABACION = 10,   // interno de svc_grabacion: siguiente entrada a reproducir
+	  ev_LED_ANIMACION = 11, // interno de drv_leds: siguiente fotograma
+	  ev_UART_TX_VACIA = 12, // la transmision de la UART se ha quedado sin datos
 } EVENTO_T;
 
-#define EVENT_TYPES 6  // n�mero total de tipos de evento
+#define EVENT_TYPES 13  // n�mero total de tipos de evento
 #define ev_NUM_EV_USUARIO 1
 #define ev_USUARIO {ev_PULSAR_BOTON,  ev_BOTON_RETARDo}
 #define ev_TIMER {ev_PERIODICO}
@@ -20,16 +20,26 @@
 
 
 
+/* Evento empaquetado en 8 bytes (antes 16 con el relleno):
+ *  - ID_aux: ID en los 8 bits altos, dato auxiliar en los 24 bajos.
+ *  - TS: us desde s_epoca_us; se amplia a 64 bits al extraer. */
 typedef struct {
-    EVENTO_T ID_EVENTO;
-    uint32_t auxData;
-    Tiempo_us_t TS;
+    uint32_t ID_aux;
+    uint32_t TS;
 } EVENTO;
 
+#define EVENTO_EMPAQUETAR(id, aux) (((uint32_t)(id) << RT_FIFO_AUX_BITS) | ((aux) & RT_FIFO_AUX_MAX))
+#define EVENTO_ID(ID_aux)          ((EVENTO_T)((ID_aux) >> RT_FIFO_AUX_BITS))
+#define EVENTO_AUX(ID_aux)         ((ID_aux) & RT_FIFO_AUX_MAX)
+
 static EVENTO colaEventos[RT_FIFO_TAM];
 static uint8_t indice_insercion = 0;
 static uint8_t indice_extraccion = 0;
 static uint8_t num_eventos = 0;
+static uint8_t max_eventos = 0;
+
+// Origen de las marcas de tiempo de los eventos pendientes
+static Tiempo_us_t s_epoca_us = 0;
 
 static uint32_t monitor_overflow_id = 0;
 static uint32_t contador_eventos[EVENT_TYPES] = {0};
@@ -48,6 +58,8 @@ void rt_FIFO_inicializar(uint32_t monitor_overflow) {
     indice_insercion = 0;
     indice_extraccion = 0;
     num_eventos = 0;
+    max_eventos = 0;
+    s_epoca_us = 0;
     monitor_overflow_id = monitor_overflow;
 
     for (uint8_t i = 0; i < EVENT_TYPES; i++) {
@@ -55,6 +67,28 @@ void rt_FIFO_inicializar(uint32_t monitor_overflow) {
     }
 }
 
+/* Marca de tiempo relativa a la epoca. La epoca avanza sola cada vez que
+ * la cola se vacia; si lleva mas de 2^32 us (71 min) sin vaciarse se lleva
+ * al evento mas antiguo, rebajando los pendientes. Un evento pendiente mas
+ * de 71 min (el WDT salta mucho antes) se queda en el maximo. */
+static uint32_t marca_tiempo(Tiempo_us_t ahora) {
+    if (cola_vacia()) {
+        s_epoca_us = ahora;
+        return 0;
+    }
+    if (ahora - s_epoca_us > 0xFFFFFFFFu) {
+        uint32_t corte = colaEventos[indice_extraccion].TS;
+        uint8_t i = indice_extraccion;
+        for (uint8_t n = 0; n < num_eventos; n++) {
+            colaEventos[i].TS -= corte;
+            i = (i + 1) % RT_FIFO_TAM;
+        }
+        s_epoca_us += corte;
+        if (ahora - s_epoca_us > 0xFFFFFFFFu) return 0xFFFFFFFFu;
+    }
+    return (uint32_t)(ahora - s_epoca_us);
+}
+
 /* Encola un nuevo evento junto con su marca temporal interna.
  * Si la cola est� llena, marca el overflow y entra en modo de bajo consumo indefinido. */
 void rt_FIFO_encolar(uint32_t ID_evento, uint32_t auxData) {
@@ -64,12 +98,13 @@ void rt_FIFO_encolar(uint32_t ID_evento, uint32_t auxData) {
         while (1) { drv_consumo_dormir(); }
     }
 
-    colaEventos[indice_insercion].ID_EVENTO = (EVENTO_T)ID_evento;
-    colaEventos[indice_insercion].auxData = auxData;
-    colaEventos[indice_insercion].TS = drv_tiempo_actual_us();
+    colaEventos[indice_insercion].ID_aux = EVENTO_EMPAQUETAR(ID_evento, auxData);
+    colaEventos[indice_insercion].TS = marca_tiempo(drv_tiempo_actual_us());
 
     indice_insercion = (indice_insercion + 1) % RT_FIFO_TAM;
     num_eventos++;
+    if (num_eventos > max_eventos)
+        max_eventos = num_eventos;
     if (ID_evento < EVENT_TYPES)
         contador_eventos[ID_evento]++;
 				
@@ -83,11 +118,12 @@ uint8_t rt_FIFO_extraer(EVENTO_T *ID_evento, uint32_t *auxData, Tiempo_us_t *TS)
 	
     if (cola_vacia()) return 0;
 	
-    *ID_evento = colaEventos[indice_extraccion].ID_EVENTO;
-    *auxData   = colaEventos[indice_extraccion].auxData;
-    *TS        = colaEventos[indice_extraccion].TS;
+    uint32_t ID_aux = colaEventos[indice_extraccion].ID_aux;
+    *ID_evento = EVENTO_ID(ID_aux);
+    *auxData   = EVENTO_AUX(ID_aux);
+    *TS        = s_epoca_us + colaEventos[indice_extraccion].TS;
 
-    colaEventos[indice_extraccion].ID_EVENTO = ev_VOID;  // Marcar como tratado
+    colaEventos[indice_extraccion].ID_aux = ev_VOID;  // Marcar como tratado
 
     indice_extraccion = (indice_extraccion + 1) % RT_FIFO_TAM;
     num_eventos--;
@@ -107,6 +143,19 @@ uint32_t rt_FIFO_estadisticas(EVENTO_T ID_evento) {
         return 0;
 }
 
+/* Ocupacion maxima alcanzada por la cola desde el ultimo reset. */
+uint8_t rt_FIFO_max_ocupacion(void) {
+    return max_eventos;
+}
+
+/* Resetea contadores y ocupacion maxima sin vaciar la cola. */
+void rt_FIFO_resetear_estadisticas(void) {
+    max_eventos = num_eventos;
+    for (uint8_t i = 0; i < EVENT_TYPES; i++) {
+        contador_eventos[i] = 0;
+    }
+}
+
 /* Test interno del m�dulo FIFO.
  * Encola y extrae una secuencia de eventos de prueba verificando el orden y los datos.
  * Devuelve true si todas las operaciones se realizan correctamente. */
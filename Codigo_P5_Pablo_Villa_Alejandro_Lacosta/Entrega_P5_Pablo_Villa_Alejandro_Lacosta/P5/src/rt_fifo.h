@@ -4,8 +4,12 @@
 #include <stdint.h>
 #include "rt_evento.h"
 
-// Tamao mximo de la cola
-#define RT_FIFO_TAM 64
+// Tamao mximo de la cola (cada evento ocupa 8 bytes)
+#define RT_FIFO_TAM 128
+
+// Bits del dato auxiliar que se guardan (el ID va en los 8 de arriba)
+#define RT_FIFO_AUX_BITS 24
+#define RT_FIFO_AUX_MAX  ((1u << RT_FIFO_AUX_BITS) - 1u)
 
 // === Funciones principales ===
 
@@ -14,6 +18,7 @@ void rt_FIFO_inicializar(uint32_t monitor_overflow);
 
 // Encola un evento con ID y dato auxiliar
 // Internamente aade marca de tiempo (TS en microsegundos)
+// Del ID se guardan 8 bits y del dato auxiliar RT_FIFO_AUX_BITS
 void rt_FIFO_encolar(uint32_t ID_evento, uint32_t auxData);
 
 // Extrae el evento ms antiguo
@@ -25,6 +30,13 @@ uint8_t rt_FIFO_extraer(EVENTO_T *ID_evento, uint32_t *auxData, Tiempo_us_t *TS)
 //  - Si ID_evento vlido ? n de veces que ese tipo se ha encolado
 uint32_t rt_FIFO_estadisticas(EVENTO_T ID_evento);
 
+// Maximo numero de eventos pendientes observado desde el ultimo reset
+uint8_t rt_FIFO_max_ocupacion(void);
+
+// Pone a cero los contadores por tipo y la marca de ocupacion maxima
+// (no toca los eventos pendientes)
+void rt_FIFO_resetear_estadisticas(void);
+
 bool rt_FIFO_test(void);
 
 #endif // RT_FIFO_H
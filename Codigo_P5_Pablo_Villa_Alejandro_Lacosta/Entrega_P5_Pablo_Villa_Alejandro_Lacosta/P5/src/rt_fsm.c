@@ -0,0 +1,120 @@
+/* *****************************************************************************
+ * P.H.2025: rt_fsm.c
+ * Motor de maquinas de estados por tabla
+ *
+ * Autores: Alejandro Lacosta, Pablo Villa
+ *
+ * Notas:
+ *  - Coste constante por evento: una celda de la tabla, como mucho una
+ *    guarda, una salida, una accion y una entrada.
+ *  - Solo cabe un evento lanzado pendiente: las acciones deciden una sola
+ *    cosa. Un segundo rt_fsm_lanzar en la misma transicion sustituye al
+ *    primero.
+ * *****************************************************************************/
+
+#include "rt_fsm.h"
+#include <stdio.h>
+
+static const rt_fsm_transicion_t* celda(const rt_fsm_def_t *def, uint8_t estado, uint8_t evento) {
+    return &def->tabla[(uint32_t)estado * def->num_eventos + evento];
+}
+
+static void transicion(rt_fsm_t *m, uint8_t evento, uint32_t aux) {
+    const rt_fsm_def_t *def = m->def;
+    if (evento >= def->num_eventos || m->estado >= def->num_estados) return;
+
+    const rt_fsm_transicion_t *t = celda(def, m->estado, evento);
+    if (!t->definida) return;
+    if (t->guarda != NULL && !t->guarda(aux)) return;
+
+    if (t->destino == RT_FSM_INTERNA || t->destino >= def->num_estados) {
+        if (t->accion != NULL) t->accion(aux);
+        return;
+    }
+
+    uint8_t origen = m->estado;
+    if (def->estados[origen].salida != NULL) def->estados[origen].salida(0);
+    if (t->accion != NULL) t->accion(aux);
+    m->estado = t->destino;
+    if (def->traza != NULL) def->traza(m, origen, evento);
+    if (def->estados[m->estado].entrada != NULL) def->estados[m->estado].entrada(0);
+}
+
+void rt_fsm_iniciar(rt_fsm_t *m, const rt_fsm_def_t *def, uint8_t inicial) {
+    m->def = def;
+    m->estado = inicial;
+    m->pendiente = RT_FSM_NINGUNO;
+    m->en_curso = true;
+    if (def->estados[inicial].entrada != NULL) def->estados[inicial].entrada(0);
+    m->en_curso = false;
+
+    // Una entrada inicial tambien puede lanzar un evento
+    if (m->pendiente != RT_FSM_NINGUNO) {
+        uint8_t ev = m->pendiente;
+        m->pendiente = RT_FSM_NINGUNO;
+        rt_fsm_evento(m, ev, m->aux_pendiente);
+    }
+}
+
+void rt_fsm_evento(rt_fsm_t *m, uint8_t evento, uint32_t aux) {
+    if (evento == RT_FSM_NINGUNO || m->def == NULL) return;
+
+    // Llamada desde dentro de una accion: se deja para el final
+    if (m->en_curso) {
+        rt_fsm_lanzar(m, evento, aux);
+        return;
+    }
+
+    m->en_curso = true;
+    transicion(m, evento, aux);
+    while (m->pendiente != RT_FSM_NINGUNO) {
+        evento = m->pendiente;
+        m->pendiente = RT_FSM_NINGUNO;
+        transicion(m, evento, m->aux_pendiente);
+    }
+    m->en_curso = false;
+}
+
+void rt_fsm_lanzar(rt_fsm_t *m, uint8_t evento, uint32_t aux) {
+    if (!m->en_curso) {
+        rt_fsm_evento(m, evento, aux);
+        return;
+    }
+    m->pendiente = evento;
+    m->aux_pendiente = aux;
+}
+
+uint8_t rt_fsm_estado(const rt_fsm_t *m) {
+    return m->estado;
+}
+
+void rt_fsm_volcar(const rt_fsm_def_t *def, void (*escribir)(const char *linea)) {
+    char linea[128];
+
+    snprintf(linea, sizeof(linea), "digraph %s {", def->nombre);
+    escribir(linea);
+
+    for (uint8_t s = 0; s < def->num_estados; s++) {
+        for (uint8_t e = 0; e < def->num_eventos; e++) {
+            const rt_fsm_transicion_t *t = celda(def, s, e);
+            if (!t->definida) continue;
+
+            // Destino fuera de rango: interna, como en transicion()
+            bool interna = t->destino == RT_FSM_INTERNA || t->destino >= def->num_estados;
+            uint8_t d = interna ? s : t->destino;
+#if RT_FSM_NOMBRES
+            snprintf(linea, sizeof(linea), "  %s -> %s [label=\"%s%s%s%s%s%s\"];",
+                     def->estados[s].nombre, def->estados[d].nombre, def->eventos[e],
+                     t->guarda ? " [" : "", t->guarda ? t->nombre_guarda : "",
+                     t->guarda ? "]" : "",
+                     t->accion ? " / " : "", t->accion ? t->nombre_accion : "");
+            escribir(linea);
+#else
+            snprintf(linea, sizeof(linea), "  %s -> %s [label=\"%s\"];",
+                     def->estados[s].nombre, def->estados[d].nombre, def->eventos[e]);
+            escribir(linea);
+#endif
+        }
+    }
+    escribir("}");
+}
@@ -0,0 +1,133 @@
+/******************************************************************************
+ * Fichero: rt_fsm.h
+ * Proyecto: P.H.2025
+ *
+ * Maquinas de estados por tabla.
+ *
+ * Cada maquina se describe con datos constantes (en flash):
+ *   - estados: nombre y acciones de entrada / salida
+ *   - eventos: nombres de los eventos propios de la maquina (indices 0..N-1)
+ *   - tabla[estado][evento]: guarda, accion y estado destino
+ *
+ * Despachar un evento es un acceso indexado a la tabla. Quien usa la
+ * maquina traduce primero (ev, aux) del gestor de eventos a un indice.
+ *
+ * Semantica de una transicion:
+ *   1. guarda(aux) == false (o celda vacia): el evento se ignora
+ *   2. destino == RT_FSM_INTERNA: solo se ejecuta la accion
+ *   3. si no: salida(origen), accion(aux), entrada(destino). Un destino igual
+ *      al origen vuelve a ejecutar salida y entrada.
+ *
+ * Las decisiones que dependen del resultado de una accion se resuelven
+ * lanzando un evento de la propia maquina (rt_fsm_lanzar), que se procesa
+ * en cuanto termina la transicion en curso.
+ *
+ * Autores:
+ *   Alejandro Lacosta
+ *   Pablo Villa
+ *
+ * Universidad de Zaragoza
+ *
+ *****************************************************************************/
+
+#ifndef RT_FSM_H
+#define RT_FSM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief 1: la tabla guarda los nombres de guardas y acciones para el
+ *        volcado (rt_fsm_volcar). 0: ahorra esas cadenas en flash.
+ */
+#ifndef RT_FSM_NOMBRES
+#define RT_FSM_NOMBRES 1
+#endif
+
+#define RT_FSM_INTERNA  0xFEu      // destino: transicion sin salida/entrada
+#define RT_FSM_NINGUNO  0xFFu      // evento: nada que despachar
+
+typedef bool (*rt_fsm_guarda_t)(uint32_t aux);
+typedef void (*rt_fsm_accion_t)(uint32_t aux);
+
+typedef struct {
+    rt_fsm_guarda_t guarda;    // NULL: siempre
+    rt_fsm_accion_t accion;    // NULL: ninguna
+    uint8_t destino;           // estado o RT_FSM_INTERNA
+    uint8_t definida;          // 0: celda vacia (evento ignorado)
+#if RT_FSM_NOMBRES
+    const char *nombre_guarda;
+    const char *nombre_accion;
+#endif
+} rt_fsm_transicion_t;
+
+#if RT_FSM_NOMBRES
+#define RT_FSM_T(guarda, accion, destino) \
+    { (guarda), (accion), (uint8_t)(destino), 1u, #guarda, #accion }
+#else
+#define RT_FSM_T(guarda, accion, destino) \
+    { (guarda), (accion), (uint8_t)(destino), 1u }
+#endif
+
+/* Atajos: cambio de estado sin mas / accion sin cambio de estado */
+#define RT_FSM_IR(destino)   RT_FSM_T(NULL, NULL, destino)
+#define RT_FSM_HACER(accion) RT_FSM_T(NULL, accion, RT_FSM_INTERNA)
+
+typedef struct {
+    const char     *nombre;
+    rt_fsm_accion_t entrada;   // NULL: ninguna (reciben aux = 0)
+    rt_fsm_accion_t salida;
+} rt_fsm_estado_t;
+
+typedef struct rt_fsm rt_fsm_t;
+
+/* Notificacion de cada cambio de estado (trazas); puede ser NULL */
+typedef void (*rt_fsm_traza_t)(const rt_fsm_t *m, uint8_t origen, uint8_t evento);
+
+typedef struct {
+    const char                *nombre;
+    const rt_fsm_estado_t     *estados;
+    uint8_t                    num_estados;
+    const char * const        *eventos;
+    uint8_t                    num_eventos;
+    const rt_fsm_transicion_t *tabla;      // [num_estados][num_eventos]
+    rt_fsm_traza_t             traza;
+} rt_fsm_def_t;
+
+/* Instancia (en RAM): solo el estado actual y el evento lanzado pendiente */
+struct rt_fsm {
+    const rt_fsm_def_t *def;
+    uint8_t  estado;
+    uint8_t  pendiente;
+    uint32_t aux_pendiente;
+    bool     en_curso;
+};
+
+/**
+ * @brief Pone la maquina en el estado inicial y ejecuta su entrada.
+ */
+void rt_fsm_iniciar(rt_fsm_t *m, const rt_fsm_def_t *def, uint8_t inicial);
+
+/**
+ * @brief Despacha un evento de la maquina (RT_FSM_NINGUNO se descarta).
+ */
+void rt_fsm_evento(rt_fsm_t *m, uint8_t evento, uint32_t aux);
+
+/**
+ * @brief Desde una accion: evento a procesar al acabar la transicion en
+ *        curso. Fuera de una transicion equivale a rt_fsm_evento.
+ */
+void rt_fsm_lanzar(rt_fsm_t *m, uint8_t evento, uint32_t aux);
+
+/**
+ * @brief Estado actual.
+ */
+uint8_t rt_fsm_estado(const rt_fsm_t *m);
+
+/**
+ * @brief Vuelca la tabla en formato Graphviz (dot), una linea por llamada.
+ */
+void rt_fsm_volcar(const rt_fsm_def_t *def, void (*escribir)(const char *linea));
+
+#endif // RT_FSM_H
@@ -10,12 +10,15 @@
  * Funciones principales:
  *  - svc_GE_suscribir(): Registra un callback a un evento.
  *  - svc_GE_cancelar(): Elimina un callback de un evento y compacta la lista.
- * 
+ *  - svc_GE_despachar(): Llama a los suscritos a un evento.
  *
  * Notas:
  *  - Si se intenta suscribir ms de rt_GE_MAX_SUSCRITOS callbacks a un evento,
  *    el sistema entra en bucle infinito (overflow).
  *  - La prioridad ms baja (0) se ejecuta primero.
+ *  - Las suscripciones estticas (SVC_GE_SUSCRIPCION_ESTATICA) estn en
+ *    flash y van antes que las de la tabla. Sus lmites los pone el
+ *    enlazador: __start_/__stop_ con GNU ld y $$Base/$$Limit con armlink.
  * *****************************************************************************/
 
 #include "svc_GE.h"
@@ -23,39 +26,47 @@
 #include "drv_leds.h"
 
 // -----------------------------------------------------------------------------
-// Suscribe una funcin callback a un evento con prioridad dada
-// Si la tabla est llena, entra en bucle infinito (overflow)
+// Tablas
 // -----------------------------------------------------------------------------
 
+#if defined(__CC_ARM) || defined(__ARMCC_VERSION)
+extern const Suscripcion_t svc_ge_estaticas$$Base[] __attribute__((weak));
+extern const Suscripcion_t svc_ge_estaticas$$Limit[] __attribute__((weak));
+#define ESTATICAS_INICIO  svc_ge_estaticas$$Base
+#define ESTATICAS_FIN     svc_ge_estaticas$$Limit
+#else
+extern const Suscripcion_t __start_svc_ge_estaticas[] __attribute__((weak));
+extern const Suscripcion_t __stop_svc_ge_estaticas[] __attribute__((weak));
+#define ESTATICAS_INICIO  __start_svc_ge_estaticas
+#define ESTATICAS_FIN     __stop_svc_ge_estaticas
+#endif
 
-Suscripcion_t s_tabla[rt_GE_MAX_SUSCRITOS];
+// Dinmicas: las s_num primeras entradas, en orden de suscripcin
+static Suscripcion_t s_tabla[rt_GE_MAX_SUSCRITOS];
+static uint8_t s_num = 0;
 
+// Despacho en curso: entrada que se est llamando y cuntas entraban al
+// empezar. Cancelar durante el despacho los corrige al compactar.
+static int16_t s_cursor = -1;
+static uint8_t s_limite = 0;
+
+// -----------------------------------------------------------------------------
+// Suscribe una funcin callback a un evento con prioridad dada
+// Si la tabla est llena, entra en bucle infinito (overflow)
+// -----------------------------------------------------------------------------
 void svc_GE_suscribir(EVENTO_T ID_evento, uint8_t prioridad,
                       SVC_CALLBACK_T funcion_callback) {
-    // Contar cuntas suscripciones estn activas
-    uint8_t cont = 0;
-												
-    for (int i = 0; i < rt_GE_MAX_SUSCRITOS; i++) {
-        if (s_tabla[i].activa)
-            cont++;
-    }
-
     // Si est llena ? overflow crtico
-    if (cont >= rt_GE_MAX_SUSCRITOS) {
+    if (s_num >= rt_GE_MAX_SUSCRITOS) {
         drv_led_establecer(1, LED_ON);
         while (1) { } // bucle infinito
     }
 
-    // Buscar una posicin libre y suscribir
-    for (int i = 0; i < rt_GE_MAX_SUSCRITOS; i++) {
-        if (!s_tabla[i].activa) {
-            s_tabla[i].activa = true;
-					  s_tabla[i].evento = ID_evento;
-            s_tabla[i].f_callback = funcion_callback;
-            s_tabla[i].prioridad = prioridad;
-            return;
-        }
-    }
+    // Siempre al final: durante un despacho queda fuera de s_limite
+    s_tabla[s_num].evento = ID_evento;
+    s_tabla[s_num].f_callback = funcion_callback;
+    s_tabla[s_num].prioridad = prioridad;
+    s_num++;
 }
 
 // -----------------------------------------------------------------------------
@@ -64,25 +75,52 @@ void svc_GE_suscribir(EVENTO_T ID_evento, uint8_t prioridad,
 void svc_GE_cancelar(EVENTO_T ID_evento,
                      SVC_CALLBACK_T funcion_callback) {
 
-    for (int i = 0; i < rt_GE_MAX_SUSCRITOS; i++) {
-        if (s_tabla[i].activa &&
-            s_tabla[i].evento == ID_evento &&
+    for (uint8_t i = 0; i < s_num; i++) {
+        if (s_tabla[i].evento == ID_evento &&
             s_tabla[i].f_callback == funcion_callback) {
 
-            s_tabla[i].activa = false;
-
             // Compactar la tabla (mover hacia arriba las siguientes activas)
-            for (int j = i; j < rt_GE_MAX_SUSCRITOS - 1; j++) {
+            s_num--;
+            for (uint8_t j = i; j < s_num; j++) {
                 s_tabla[j] = s_tabla[j + 1];
             }
 
-            s_tabla[rt_GE_MAX_SUSCRITOS - 1].activa = false;
-            s_tabla[rt_GE_MAX_SUSCRITOS - 1].evento = ev_VOID;
-            s_tabla[rt_GE_MAX_SUSCRITOS - 1].f_callback = NULL;
-            s_tabla[rt_GE_MAX_SUSCRITOS - 1].prioridad = 0;
-
+            // Si el despacho ya la haba pasado (o es la que se est
+            // llamando), su cursor retrocede con el resto de la tabla
+            if (i < s_limite) {
+                s_limite--;
+                if (i <= s_cursor) s_cursor--;
+            }
             return; // Solo se elimina la primera coincidencia
         }
     }
 }
 
+// -----------------------------------------------------------------------------
+// Despacho de un evento
+// -----------------------------------------------------------------------------
+void svc_GE_despachar(EVENTO_T ID_evento, uint32_t auxData) {
+    for (const Suscripcion_t *s = ESTATICAS_INICIO; s < ESTATICAS_FIN; s++) {
+        if (s->evento == ID_evento)
+            s->f_callback(ID_evento, auxData);
+    }
+
+    s_limite = s_num;
+    for (s_cursor = 0; s_cursor < s_limite; s_cursor++) {
+        if (s_tabla[s_cursor].evento == ID_evento)
+            s_tabla[s_cursor].f_callback(ID_evento, auxData);
+    }
+    s_limite = 0;
+    s_cursor = -1;
+}
+
+// -----------------------------------------------------------------------------
+// Nmero de suscripciones activas
+// -----------------------------------------------------------------------------
+uint8_t svc_GE_num_suscritos(void) {
+    return s_num;
+}
+
+uint8_t svc_GE_num_estaticas(void) {
+    return (uint8_t)(ESTATICAS_FIN - ESTATICAS_INICIO);
+}
@@ -26,13 +26,27 @@
 typedef void (*SVC_CALLBACK_T)(EVENTO_T, uint32_t);
 
 typedef struct {
-	bool activa;           /**< Indica si esta entrada est en uso */
 	EVENTO_T evento;       /**< Evento al que est suscrita */
 	uint8_t prioridad;     /**< Prioridad (0 = ms alta) */
 	SVC_CALLBACK_T f_callback; /**< Funcin callback asociada al evento */
 }Suscripcion_t;
 
-extern Suscripcion_t s_tabla[rt_GE_MAX_SUSCRITOS];
+/*
+ * Suscripciones estticas: rutas que no cambian nunca (eventos internos de
+ * un driver). Son constantes en flash, en la seccin svc_ge_estaticas, y no
+ * gastan RAM de la tabla ni tiempo de arranque. Se despachan antes que las
+ * dinmicas, en el orden en que las deja el enlazador, y no se cancelan.
+ * Evento y callback tienen que ser identificadores (dan nombre a la entrada):
+ *
+ *   SVC_GE_SUSCRIPCION_ESTATICA(ev_BOTON_MUESTREO, 0, drv_botones_cb);
+ *
+ * Con armlink hay que conservar la seccin (--keep=*(svc_ge_estaticas)):
+ * nadie la referencia por smbolo.
+ */
+#define SVC_GE_SUSCRIPCION_ESTATICA(ID_evento, prioridad, f_callback) \
+	static const Suscripcion_t svc_ge_##f_callback##_##ID_evento \
+	__attribute__((used, section("svc_ge_estaticas"), aligned(__alignof__(Suscripcion_t)))) = \
+	{ ID_evento, prioridad, f_callback }
 
 /**
 
@@ -51,4 +65,28 @@ extern Suscripcion_t s_tabla[rt_GE_MAX_SUSCRITOS];
   */
   void svc_GE_cancelar(EVENTO_T ID_evento, SVC_CALLBACK_T f_callback);
 
+/**
+
+* @brief Devuelve el nmero de suscripciones activas en la tabla.
+  */
+  uint8_t svc_GE_num_suscritos(void);
+
+/**
+
+* @brief Devuelve el nmero de suscripciones estticas (en flash).
+  */
+  uint8_t svc_GE_num_estaticas(void);
+
+/**
+
+* @brief Llama a los suscritos a un evento: primero los estticos y despus
+*        los de la tabla, en orden de suscripcin.
+*        Un callback puede suscribir o cancelar: las altas no reciben el
+*        evento en curso y las bajas dejan de recibirlo si an no les tocaba.
+*        No es reentrante (ningn callback debe despachar).
+* @param ID_evento Evento a despachar.
+* @param auxData Dato auxiliar del evento.
+  */
+  void svc_GE_despachar(EVENTO_T ID_evento, uint32_t auxData);
+
 #endif  // SVC_GE_H
@@ -40,6 +40,13 @@ static SVC_ALARMA_CALLBACK_T func_callback = NULL;
 static EVENTO_T evento_tick;
 static uint32_t monitor_overflow = 0;
 
+// Sin alarmas vivas el tick de 1 ms no hace nada: se para
+static uint8_t  s_activas = 0;
+static bool     s_tick_suspendido = false;
+static uint32_t s_suspensiones = 0;
+static uint32_t s_suspension_inicio_ms = 0;
+static uint32_t s_suspendido_ms = 0;
+
 
 static ALARMA_T* buscar_alarma(EVENTO_T ID_evento, uint32_t auxData) {
     for (int i = 0; i < SVC_ALARMAS_MAX; i++)
@@ -55,9 +62,47 @@ static ALARMA_T* buscar_libre(void) {
     return NULL;
 }
 
+/* Para el peridico si no queda ninguna alarma. Se repite aunque ya se
+ * considere suspendido: el gestor de energa puede haberlo arrancado para
+ * un despertar y el tick resultante vuelve a pararlo. */
+static void suspender_tick_si_ocioso(void) {
+    if (s_activas != 0) return;
+    drv_tiempo_periodico_habilitar(false);
+    if (!s_tick_suspendido) {
+        s_tick_suspendido = true;
+        s_suspensiones++;
+        s_suspension_inicio_ms = drv_tiempo_actual_ms();
+    }
+}
+
+/* Rearranca el peridico desde cero: el primer tick llega un periodo
+ * despus de programar la alarma, como si nunca se hubiera parado */
+static void reanudar_tick(void) {
+    if (!s_tick_suspendido) return;
+    s_tick_suspendido = false;
+    s_suspendido_ms += drv_tiempo_actual_ms() - s_suspension_inicio_ms;
+    drv_tiempo_periodico_habilitar(true);
+}
+
+static void liberar(ALARMA_T *a) {
+    a->activa = false;
+    s_activas--;
+}
+
+static void ocupar(ALARMA_T *a) {
+    if (!a->activa) {
+        a->activa = true;
+        s_activas++;
+    }
+    reanudar_tick();
+}
+
 void svc_alarma_desactivar(EVENTO_T ID_evento, uint32_t auxData) {
     ALARMA_T *a = buscar_alarma(ID_evento, auxData);
-    if (a) a->activa = false;
+    if (a) {
+        liberar(a);
+        suspender_tick_si_ocioso();
+    }
 }
 
 static void tick_handler(void) {
@@ -81,8 +126,14 @@ void svc_alarma_iniciar(uint32_t M_overflow, SVC_ALARMA_CALLBACK_T callback, EVE
         alarmas[i].ID_evento = ev_VOID;
         alarmas[i].auxData = 0;
     }
+    s_activas = 0;
+    s_tick_suspendido = false;
+    s_suspensiones = 0;
+    s_suspendido_ms = 0;
+
 		//svc_GE_suscribir(evento_tick, 1, svc_alarma_actualizar);
     drv_tiempo_periodico_ms(1, tick_handler, evento_tick);
+    suspender_tick_si_ocioso();
 }
 
 
@@ -91,17 +142,39 @@ void svc_alarma_activar(uint32_t alarma_flags, EVENTO_T ID_evento, uint32_t auxD
     uint8_t flags = (alarma_flags >> 1) & 0x7F;
 		uint32_t retardo_ms = (alarma_flags >> 8) & 0x00FFFFFF;
 
+    if (retardo_ms == 0) {
+        svc_alarma_desactivar(ID_evento, auxData);
+        return;
+    }
+
     ALARMA_T *alarma = buscar_alarma(ID_evento, auxData);
     if (!alarma) alarma = buscar_libre();
-    if (!alarma || retardo_ms == 0) return;
+    if (!alarma) return;
 
-    alarma->activa = true;
     alarma->periodica = periodica;
     alarma->flags = flags;
     alarma->retardo_ms = retardo_ms;           
     alarma->comienzo_ms = drv_tiempo_actual_ms();
     alarma->ID_evento = ID_evento;
     alarma->auxData = auxData;
+    ocupar(alarma);
+}
+
+void svc_alarma_activar_en(uint32_t vencimiento_ms, EVENTO_T ID_evento, uint32_t auxData) {
+    ALARMA_T *alarma = buscar_alarma(ID_evento, auxData);
+    if (!alarma) alarma = buscar_libre();
+    if (!alarma) return;
+
+    uint32_t ahora = drv_tiempo_actual_ms();
+    int32_t  falta = (int32_t)(vencimiento_ms - ahora);
+
+    alarma->periodica = false;
+    alarma->flags = 0;
+    alarma->retardo_ms = (falta > 0) ? (uint32_t)falta : 0;
+    alarma->comienzo_ms = ahora;
+    alarma->ID_evento = ID_evento;
+    alarma->auxData = auxData;
+    ocupar(alarma);
 }
 
 void svc_alarma_actualizar(EVENTO_T ID_evento, uint32_t auxData) {
@@ -116,12 +189,18 @@ void svc_alarma_actualizar(EVENTO_T ID_evento, uint32_t auxData) {
             if (func_callback)
                 func_callback(alarmas[i].ID_evento, alarmas[i].auxData);
 
-            if (alarmas[i].periodica)
-                alarmas[i].comienzo_ms = ahora;
-            else
-                alarmas[i].activa = false;     
+            // Las peridicas avanzan un periodo exacto para no acumular el
+            // retraso de despacho; si van ms de un periodo tarde se resincronizan.
+            if (alarmas[i].periodica) {
+                alarmas[i].comienzo_ms += alarmas[i].retardo_ms;
+                if ((ahora - alarmas[i].comienzo_ms) >= alarmas[i].retardo_ms)
+                    alarmas[i].comienzo_ms = ahora;
+            } else {
+                liberar(&alarmas[i]);
+            }
         }
     }
+    suspender_tick_si_ocioso();
 }
 
 uint32_t svc_alarma_codificar(bool periodica, uint32_t retardo_ms, uint8_t flags) {
@@ -131,3 +210,35 @@ uint32_t svc_alarma_codificar(bool periodica, uint32_t retardo_ms, uint8_t flags
     valor |= (retardo_ms & 0x00FFFFFF) << 8; 
     return valor;
 }
+
+uint8_t svc_alarma_activas(void) {
+    return s_activas;
+}
+
+bool svc_alarma_tick_suspendido(void) {
+    return s_tick_suspendido;
+}
+
+uint32_t svc_alarma_tick_suspensiones(void) {
+    return s_suspensiones;
+}
+
+uint32_t svc_alarma_tick_suspendido_ms(void) {
+    uint32_t total = s_suspendido_ms;
+    if (s_tick_suspendido) total += drv_tiempo_actual_ms() - s_suspension_inicio_ms;
+    return total;
+}
+
+uint32_t svc_alarma_proximo_ms(void) {
+    uint32_t ahora = drv_tiempo_actual_ms();
+    uint32_t proximo = SVC_ALARMA_NINGUNA;
+
+    for (int i = 0; i < SVC_ALARMAS_MAX; i++) {
+        if (!alarmas[i].activa) continue;
+
+        uint32_t pasado = ahora - alarmas[i].comienzo_ms;
+        uint32_t falta = (pasado >= alarmas[i].retardo_ms) ? 0 : alarmas[i].retardo_ms - pasado;
+        if (falta < proximo) proximo = falta;
+    }
+    return proximo;
+}
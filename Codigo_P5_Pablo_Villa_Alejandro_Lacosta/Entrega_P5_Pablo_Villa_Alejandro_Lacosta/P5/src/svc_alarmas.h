@@ -59,6 +59,27 @@ void svc_alarma_activar(uint32_t alarma_flags,
                         EVENTO_T ID_evento,
                         uint32_t auxData);
 
+/**
+ * @brief Activa una alarma de disparo nico para un instante absoluto.
+ * @param vencimiento_ms Instante (drv_tiempo_actual_ms) en que debe vencer;
+ *        si ya ha pasado, vence en el siguiente tick
+ * @param ID_evento Evento que se disparar al vencer la alarma
+ * @param auxData Datos auxiliares que se pasarn al disparar la alarma
+ *
+ * Al programar contra instantes absolutos el retraso de despacho de un
+ * disparo no se arrastra al siguiente.
+ */
+void svc_alarma_activar_en(uint32_t vencimiento_ms,
+                           EVENTO_T ID_evento,
+                           uint32_t auxData);
+
+/**
+ * @brief Desactiva la alarma asociada a un evento y dato auxiliar.
+ * @param ID_evento Evento de la alarma
+ * @param auxData  Dato auxiliar con el que se program
+ */
+void svc_alarma_desactivar(EVENTO_T ID_evento, uint32_t auxData);
+
 /**
  * @brief Revisa y dispara las alarmas vencidas.
  * @param ID_evento Evento recibido del tick peridico
@@ -79,4 +100,41 @@ uint32_t svc_alarma_codificar(bool periodica,
                               uint32_t retardo_ms,
                               uint8_t flags);
 
+/**
+ * @brief Devuelve el nmero de alarmas actualmente activas.
+ */
+uint8_t svc_alarma_activas(void);
+
+/**
+ * @brief Valor de svc_alarma_proximo_ms cuando no hay ninguna alarma activa.
+ */
+#define SVC_ALARMA_NINGUNA  0xFFFFFFFFu
+
+/**
+ * @brief Milisegundos que faltan para el vencimiento ms prximo
+ *        (0 si alguna ya ha vencido, SVC_ALARMA_NINGUNA si no hay).
+ *
+ * Lo usa el gestor de energa para decidir cunto puede dormir sin tick.
+ */
+uint32_t svc_alarma_proximo_ms(void);
+
+/**
+ * @brief Indica si el tick peridico est parado por no haber alarmas.
+ *
+ * El servicio para el temporizador peridico cuando la ltima alarma se
+ * desactiva o vence, y lo rearranca desde cero (en fase con la nueva
+ * alarma) en el siguiente svc_alarma_activar / svc_alarma_activar_en.
+ */
+bool svc_alarma_tick_suspendido(void);
+
+/**
+ * @brief Veces que se ha parado el tick desde svc_alarma_iniciar.
+ */
+uint32_t svc_alarma_tick_suspensiones(void);
+
+/**
+ * @brief Tiempo total con el tick parado (ms), incluido el tramo en curso.
+ */
+uint32_t svc_alarma_tick_suspendido_ms(void);
+
 #endif // SVC_ALARMAS_H
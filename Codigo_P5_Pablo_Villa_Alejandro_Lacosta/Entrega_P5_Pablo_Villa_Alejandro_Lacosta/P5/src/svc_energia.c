@@ -0,0 +1,210 @@
+/* *****************************************************************************
+ * P.H.2025: svc_energia.c
+ * Gestor de energia: eleccion del modo de reposo
+ *
+ * Autores: Alejandro Lacosta, Pablo Villa
+ *
+ * Notas:
+ *  - SIN_TICK y REPOSO posponen el tick hasta el vencimiento mas proximo;
+ *    al despertar por otra causa se reanuda el periodo normal. La hora no
+ *    depende del tick (Timer1 en LPC, RTC2 en nRF), asi que las alarmas
+ *    vencen igual.
+ *  - Nunca se duerme sin tick mas de MAX_SIN_TICK_MS: cada despertar pasa
+ *    por el lanzador, que es quien alimenta el WDT.
+ *  - Sin alarmas svc_alarmas para el tick; aun asi se pospone (lo que lo
+ *    arranca para un unico disparo) hasta el limite anterior, y ese tick
+ *    sin alarmas lo vuelve a parar.
+ *  - Entre que el lanzador ve la cola vacia y el WFI puede llegar una
+ *    interrupcion: se vuelve a mirar la cola con las interrupciones
+ *    enmascaradas (el WFI despierta igualmente con una pendiente).
+ *  - REPOSO suelta el cristal de alta frecuencia: mientras alguien tenga
+ *    el dominio HFCLK (la UART, por ejemplo) se queda en SIN_TICK.
+ * *****************************************************************************/
+
+#include "svc_energia.h"
+#include "svc_alarmas.h"
+#include "svc_kv.h"
+#include "drv_tiempo.h"
+#include "drv_consumo.h"
+#include "drv_uart.h"
+#include "drv_wdt.h"
+#include "drv_dominio.h"
+#include "rt_fifo.h"
+#include "hal_SC.h"
+#include <stddef.h>
+
+#define UMBRAL_SIN_TICK_MS  2u      // por debajo no compensa posponer el tick
+#define UMBRAL_REPOSO_MS    10u     // margen para el arranque del HFCLK
+#define MAX_SIN_TICK_MS     500u
+
+static svc_energia_veto_t      s_vetos[SVC_ENERGIA_MAX_VETOS];
+static uint8_t                 s_num_vetos = 0;
+static svc_energia_despertar_t s_fuentes[SVC_ENERGIA_MAX_FUENTES];
+static uint8_t                 s_num_fuentes = 0;
+static svc_energia_aviso_t     s_avisos[SVC_ENERGIA_MAX_AVISOS];
+static uint8_t                 s_num_avisos = 0;
+
+static uint32_t s_ultima_actividad = 0;
+static bool     s_apagado_pedido = false;
+
+static uint32_t s_entradas[SVC_ENERGIA_MODOS];
+static uint64_t s_residencia_us[SVC_ENERGIA_MODOS];
+
+static const char * const NOMBRES[SVC_ENERGIA_MODOS] = {
+    "espera", "sin_tick", "reposo", "apagado"
+};
+
+void svc_energia_iniciar(void) {
+    s_ultima_actividad = drv_tiempo_actual_ms();
+    s_apagado_pedido = false;
+    for (uint8_t m = 0; m < SVC_ENERGIA_MODOS; m++) {
+        s_entradas[m] = 0;
+        s_residencia_us[m] = 0;
+    }
+}
+
+bool svc_energia_registrar_veto(svc_energia_veto_t veto) {
+    for (uint8_t i = 0; i < s_num_vetos; i++)
+        if (s_vetos[i] == veto) return true;
+    if (veto == NULL || s_num_vetos >= SVC_ENERGIA_MAX_VETOS) return false;
+    s_vetos[s_num_vetos++] = veto;
+    return true;
+}
+
+bool svc_energia_registrar_despertar(svc_energia_despertar_t armar) {
+    for (uint8_t i = 0; i < s_num_fuentes; i++)
+        if (s_fuentes[i] == armar) return true;
+    if (armar == NULL || s_num_fuentes >= SVC_ENERGIA_MAX_FUENTES) return false;
+    s_fuentes[s_num_fuentes++] = armar;
+    return true;
+}
+
+bool svc_energia_registrar_aviso(svc_energia_aviso_t aviso) {
+    for (uint8_t i = 0; i < s_num_avisos; i++)
+        if (s_avisos[i] == aviso) return true;
+    if (aviso == NULL || s_num_avisos >= SVC_ENERGIA_MAX_AVISOS) return false;
+    s_avisos[s_num_avisos++] = aviso;
+    return true;
+}
+
+void svc_energia_actividad(void) {
+    s_ultima_actividad = drv_tiempo_actual_ms();
+    s_apagado_pedido = false;
+}
+
+void svc_energia_solicitar_apagado(void) {
+    s_apagado_pedido = true;
+}
+
+// -----------------------------------------------------------------------------
+// Eleccion del modo
+// -----------------------------------------------------------------------------
+
+svc_energia_modo_t svc_energia_elegir(uint32_t *espera_ms) {
+    svc_energia_modo_t limite = SVC_ENERGIA_APAGADO;
+    for (uint8_t i = 0; i < s_num_vetos; i++) {
+        svc_energia_modo_t m = s_vetos[i]();
+        if (m < limite) limite = m;
+    }
+
+    uint32_t espera = svc_alarma_proximo_ms();
+
+    if (s_num_fuentes == 0) {
+        // Sin nada que despierte, apagar seria definitivo
+        if (limite > SVC_ENERGIA_REPOSO) limite = SVC_ENERGIA_REPOSO;
+    } else {
+        uint32_t inactivo = drv_tiempo_actual_ms() - s_ultima_actividad;
+        bool apagar = s_apagado_pedido || inactivo >= SVC_ENERGIA_INACTIVIDAD_MS;
+
+        if (apagar && limite == SVC_ENERGIA_APAGADO) {
+            if (espera_ms != NULL) *espera_ms = 0;
+            return SVC_ENERGIA_APAGADO;
+        }
+        // Despertar a tiempo de apagar por inactividad
+        if (!apagar && SVC_ENERGIA_INACTIVIDAD_MS - inactivo < espera)
+            espera = SVC_ENERGIA_INACTIVIDAD_MS - inactivo;
+    }
+
+    if (espera > MAX_SIN_TICK_MS) espera = MAX_SIN_TICK_MS;
+    if (espera_ms != NULL) *espera_ms = espera;
+
+    svc_energia_modo_t modo;
+    if (espera <= UMBRAL_SIN_TICK_MS)  modo = SVC_ENERGIA_ESPERA;
+    else if (espera < UMBRAL_REPOSO_MS) modo = SVC_ENERGIA_SIN_TICK;
+    else                                modo = SVC_ENERGIA_REPOSO;
+
+    if (modo == SVC_ENERGIA_REPOSO && drv_dominio_encendido(DRV_DOMINIO_HFCLK))
+        modo = SVC_ENERGIA_SIN_TICK;
+
+    return (modo < limite) ? modo : limite;
+}
+
+// -----------------------------------------------------------------------------
+// Reposo
+// -----------------------------------------------------------------------------
+
+static void apagar(void) {
+    drv_wdt_alimentar();
+    for (uint8_t i = 0; i < s_num_avisos; i++)
+        s_avisos[i]();
+
+    drv_uart_vaciar();      // No perder logs pendientes al dormir
+    svc_kv_sincronizar();   // Ni valores sin escribir en flash
+
+    for (uint8_t i = 0; i < s_num_fuentes; i++)
+        s_fuentes[i]();
+
+    s_entradas[SVC_ENERGIA_APAGADO]++;
+    Tiempo_us_t inicio = drv_tiempo_actual_us();
+    drv_consumo_dormir();
+    s_residencia_us[SVC_ENERGIA_APAGADO] += drv_tiempo_actual_us() - inicio;
+
+    // Solo se vuelve en LPC (power-down); en nRF el despertar es un reset
+    drv_wdt_alimentar();
+    svc_energia_actividad();
+}
+
+void svc_energia_ocioso(void) {
+    uint32_t espera;
+    svc_energia_modo_t modo = svc_energia_elegir(&espera);
+
+    if (modo == SVC_ENERGIA_APAGADO) {
+        apagar();
+        return;
+    }
+
+    Tiempo_us_t inicio = drv_tiempo_actual_us();
+
+    // Con el tick parado nada despertaria a tiempo: hay que programarlo
+    bool posponer = modo != SVC_ENERGIA_ESPERA || svc_alarma_tick_suspendido();
+
+    hal_sc_entrar();
+    if (rt_FIFO_estadisticas(ev_VOID) == 0) {
+        if (posponer) drv_tiempo_periodico_posponer_ms(espera);
+
+        if (modo == SVC_ENERGIA_REPOSO) drv_consumo_reposo();
+        else                            drv_consumo_esperar();
+
+        if (posponer) drv_tiempo_periodico_reanudar();
+        s_entradas[modo]++;
+    }
+    hal_sc_salir();
+
+    s_residencia_us[modo] += drv_tiempo_actual_us() - inicio;
+}
+
+// -----------------------------------------------------------------------------
+// Estadisticas
+// -----------------------------------------------------------------------------
+
+uint32_t svc_energia_entradas(svc_energia_modo_t modo) {
+    return (modo < SVC_ENERGIA_MODOS) ? s_entradas[modo] : 0;
+}
+
+uint32_t svc_energia_residencia_ms(svc_energia_modo_t modo) {
+    return (modo < SVC_ENERGIA_MODOS) ? (uint32_t)(s_residencia_us[modo] / 1000u) : 0;
+}
+
+const char* svc_energia_nombre(svc_energia_modo_t modo) {
+    return (modo < SVC_ENERGIA_MODOS) ? NOMBRES[modo] : "?";
+}
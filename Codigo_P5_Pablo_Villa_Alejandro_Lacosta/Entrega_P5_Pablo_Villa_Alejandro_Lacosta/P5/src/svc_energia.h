@@ -0,0 +1,135 @@
+/******************************************************************************
+ * Fichero: svc_energia.h
+ * Proyecto: P.H.2025
+ *
+ * Gestor de energia: decide cuanto dormir cada vez que el sistema queda
+ * ocioso (rt_GE_lanzador con la cola vacia).
+ *
+ * Modos, de menos a mas profundo:
+ *  - ESPERA:   WFI con el tick de 1 ms en marcha.
+ *  - SIN_TICK: WFI con el tick pospuesto hasta la proxima alarma.
+ *  - REPOSO:   como SIN_TICK soltando ademas el reloj de alta frecuencia.
+ *  - APAGADO:  SYSTEM OFF (nRF) / power-down (LPC); solo despierta por GPIO.
+ *
+ * El modo sale de:
+ *  - El vencimiento mas proximo de svc_alarmas: cuanto mas lejos, mas hondo.
+ *  - Los vetos de los modulos: funciones que devuelven el modo mas profundo
+ *    que admiten en ese momento (p.ej. la UART con bytes por enviar).
+ *  - Las fuentes de despertar: sin ninguna registrada no se apaga nunca.
+ *  - La actividad del usuario: tras SVC_ENERGIA_INACTIVIDAD_MS sin pulsar
+ *    se apaga, igual que si la aplicacion lo pide (fin de partida).
+ *
+ * Los modulos no llaman a drv_consumo: registran vetos, fuentes y avisos.
+ *
+ * Autores:
+ *   Alejandro Lacosta
+ *   Pablo Villa
+ *
+ * Universidad de Zaragoza
+ *
+ *****************************************************************************/
+
+#ifndef SVC_ENERGIA_H
+#define SVC_ENERGIA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum {
+    SVC_ENERGIA_ESPERA = 0,
+    SVC_ENERGIA_SIN_TICK,
+    SVC_ENERGIA_REPOSO,
+    SVC_ENERGIA_APAGADO,
+    SVC_ENERGIA_MODOS
+} svc_energia_modo_t;
+
+/**
+ * @brief Veto: devuelve el modo mas profundo que admite el modulo ahora.
+ *        Se consulta en cada reposo, con lo que debe ser breve.
+ */
+typedef svc_energia_modo_t (*svc_energia_veto_t)(void);
+
+/**
+ * @brief Fuente de despertar: prepara el hardware justo antes de APAGADO.
+ */
+typedef void (*svc_energia_despertar_t)(void);
+
+/**
+ * @brief Aviso de apagado: ultima ocasion de guardar estado (antes de
+ *        vaciar la UART y sincronizar svc_kv).
+ */
+typedef void (*svc_energia_aviso_t)(void);
+
+#define SVC_ENERGIA_MAX_VETOS       4
+#define SVC_ENERGIA_MAX_FUENTES     4
+#define SVC_ENERGIA_MAX_AVISOS      4
+
+/**
+ * @brief Tiempo sin actividad del usuario tras el que se apaga.
+ */
+#define SVC_ENERGIA_INACTIVIDAD_MS  10000u
+
+/**
+ * @brief Empieza a contar la inactividad y pone a cero las estadisticas.
+ *        Los vetos y fuentes ya registrados se mantienen.
+ */
+void svc_energia_iniciar(void);
+
+/**
+ * @brief Registra un veto (registrar dos veces el mismo no lo duplica).
+ * @return false si la tabla esta llena
+ */
+bool svc_energia_registrar_veto(svc_energia_veto_t veto);
+
+/**
+ * @brief Registra una fuente de despertar para APAGADO.
+ * @return false si la tabla esta llena
+ */
+bool svc_energia_registrar_despertar(svc_energia_despertar_t armar);
+
+/**
+ * @brief Registra un aviso que se llama justo antes de APAGADO.
+ * @return false si la tabla esta llena
+ */
+bool svc_energia_registrar_aviso(svc_energia_aviso_t aviso);
+
+/**
+ * @brief Notifica actividad del usuario: reinicia la cuenta de inactividad
+ *        y anula una peticion de apagado pendiente.
+ */
+void svc_energia_actividad(void);
+
+/**
+ * @brief Pide apagar en cuanto el sistema quede ocioso y los vetos lo
+ *        permitan.
+ */
+void svc_energia_solicitar_apagado(void);
+
+/**
+ * @brief Modo que se usaria ahora mismo.
+ * @param espera_ms Si no es NULL, tiempo maximo a dormir (sin tick)
+ */
+svc_energia_modo_t svc_energia_elegir(uint32_t *espera_ms);
+
+/**
+ * @brief Duerme en el modo elegido hasta la siguiente interrupcion.
+ *        Se llama con la cola de eventos vacia.
+ */
+void svc_energia_ocioso(void);
+
+/**
+ * @brief Veces que se ha entrado en un modo.
+ */
+uint32_t svc_energia_entradas(svc_energia_modo_t modo);
+
+/**
+ * @brief Tiempo total dormido en un modo (ms).
+ */
+uint32_t svc_energia_residencia_ms(svc_energia_modo_t modo);
+
+/**
+ * @brief Nombre corto del modo (para trazas y la shell).
+ */
+const char* svc_energia_nombre(svc_energia_modo_t modo);
+
+#endif // SVC_ENERGIA_H
@@ -0,0 +1,212 @@
+/* *****************************************************************************
+ * P.H.2025: svc_grabacion.c
+ * Servicio de grabacion y reproduccion de entrada (SVC_GRABACION)
+ *
+ * Graba las pulsaciones validadas por drv_botones (con el instante del
+ * flanco) y los gestos, y las reproduce despues en los mismos instantes
+ * relativos encolandolas en rt_FIFO.
+ *
+ * Autores: Alejandro Lacosta, Pablo Villa
+ *
+ * Notas:
+ *  - Los tiempos se guardan en us relativos al inicio (32 bits: ~71 min).
+ *  - ev_PULSAR_BOTON tambien lo usan los juegos para sus timeouts (aux
+ *    fuera del rango de botones): esos no se graban, los regenera el juego.
+ *  - La reproduccion usa una unica alarma (ev_GRABACION) reprogramada para
+ *    la siguiente entrada; la resolucion es la del tick de alarmas (1 ms),
+ *    pero el instante que ve el juego (drv_botones_ts_pulsacion) es exacto.
+ * *****************************************************************************/
+
+#include "svc_grabacion.h"
+#include "svc_GE.h"
+#include "svc_alarmas.h"
+#include "svc_logs.h"
+#include "rt_fifo.h"
+#include "drv_botones.h"
+#include "drv_tiempo.h"
+#include "drv_uart.h"
+#include "board.h"
+#include <stdio.h>
+
+static uint8_t  s_modo = SVC_GRABACION_INACTIVA;
+static Tiempo_us_t s_t0;                       // origen de tiempos
+static uint32_t s_semilla;
+
+// Grabacion en RAM
+static svc_grabacion_entrada_t s_buffer[SVC_GRABACION_MAX];
+static uint16_t s_num = 0;
+static uint32_t s_descartadas = 0;
+
+// Reproduccion
+static const svc_grabacion_entrada_t *s_traza;
+static uint16_t s_traza_num;
+static uint16_t s_pos;
+
+static void svc_grabacion_cb(EVENTO_T ev, uint32_t aux);
+
+// -----------------------------------------------------------------------------
+// Utilidades
+// -----------------------------------------------------------------------------
+
+static uint32_t tiempo_relativo(Tiempo_us_t t) {
+    return (t > s_t0) ? (uint32_t)(t - s_t0) : 0;
+}
+
+/* Una entrada por linea, con formato de inicializador C. */
+static void emitir_entrada(const svc_grabacion_entrada_t *e, bool bloqueante) {
+    char linea[32];
+    snprintf(linea, sizeof(linea), "  { %lu, %u, %u },\r\n",
+             (unsigned long)e->t_us, e->ev, e->aux);
+    if (bloqueante) drv_uart_send(linea);
+    else            drv_uart_encolar(linea, false);
+}
+
+static void emitir_semilla(void) {
+    char linea[24];
+    snprintf(linea, sizeof(linea), "SEMILLA %lu\r\n", (unsigned long)s_semilla);
+    drv_uart_encolar(linea, false);
+}
+
+static void cancelar_suscripciones(void) {
+    svc_GE_cancelar(ev_PULSAR_BOTON, svc_grabacion_cb);
+    svc_GE_cancelar(ev_BOTON_GESTO, svc_grabacion_cb);
+    svc_GE_cancelar(ev_GRABACION, svc_grabacion_cb);
+}
+
+// -----------------------------------------------------------------------------
+// Grabacion
+// -----------------------------------------------------------------------------
+
+static void anotar(EVENTO_T ev, uint32_t aux, Tiempo_us_t t) {
+    if (s_num >= SVC_GRABACION_MAX) {
+        if (s_descartadas++ == 0)
+            svc_logs_escribir(LOG_LEVEL_ERROR, "[REC] buffer lleno\r\n");
+        return;
+    }
+    svc_grabacion_entrada_t *e = &s_buffer[s_num++];
+    e->t_us = tiempo_relativo(t);
+    e->ev   = (uint8_t)ev;
+    e->aux  = (uint16_t)aux;
+    emitir_entrada(e, false);
+}
+
+void svc_grabacion_grabar(void) {
+    svc_grabacion_parar();
+    s_num = 0;
+    s_descartadas = 0;
+    s_t0 = drv_tiempo_actual_us();
+    s_modo = SVC_GRABACION_GRABAR;
+    svc_GE_suscribir(ev_PULSAR_BOTON, 1, svc_grabacion_cb);
+    svc_GE_suscribir(ev_BOTON_GESTO, 1, svc_grabacion_cb);
+}
+
+// -----------------------------------------------------------------------------
+// Reproduccion
+// -----------------------------------------------------------------------------
+
+static void inyectar(const svc_grabacion_entrada_t *e) {
+    if (e->ev == ev_PULSAR_BOTON)
+        drv_botones_inyectar((uint8_t)e->aux, s_t0 + e->t_us);
+    else
+        rt_FIFO_encolar(e->ev, e->aux);
+}
+
+/* Encola todo lo vencido y arma la alarma para la siguiente entrada. */
+static void avanzar_reproduccion(void) {
+    while (s_pos < s_traza_num) {
+        const svc_grabacion_entrada_t *e = &s_traza[s_pos];
+        uint32_t ahora = tiempo_relativo(drv_tiempo_actual_us());
+
+        if (e->t_us > ahora) {
+            uint32_t ms = (e->t_us - ahora + 999u) / 1000u;
+            svc_alarma_activar(svc_alarma_codificar(false, ms, 0), ev_GRABACION, 0);
+            return;
+        }
+        inyectar(e);
+        s_pos++;
+    }
+    svc_logs_escribir(LOG_LEVEL_INFO, "[REC] fin de reproduccion\r\n");
+    svc_grabacion_parar();
+}
+
+void svc_grabacion_reproducir(const svc_grabacion_entrada_t *traza,
+                              uint16_t num, uint32_t semilla) {
+    svc_grabacion_parar();
+    s_traza = traza;
+    s_traza_num = num;
+    s_pos = 0;
+    s_semilla = semilla;
+    s_t0 = drv_tiempo_actual_us();
+    s_modo = SVC_GRABACION_REPRODUCIR;
+
+    drv_botones_entrada_hw(false);
+    svc_GE_suscribir(ev_GRABACION, 1, svc_grabacion_cb);
+    avanzar_reproduccion();
+}
+
+// -----------------------------------------------------------------------------
+// Callback del gestor de eventos
+// -----------------------------------------------------------------------------
+
+static void svc_grabacion_cb(EVENTO_T ev, uint32_t aux) {
+    if (s_modo == SVC_GRABACION_GRABAR) {
+        if (ev == ev_PULSAR_BOTON) {
+            if (aux >= BUTTONS_NUMBER) return;   // timeout del juego
+            anotar(ev, aux, drv_botones_ts_pulsacion((uint8_t)aux));
+        } else if (ev == ev_BOTON_GESTO) {
+            anotar(ev, aux, drv_tiempo_actual_us());
+        }
+    } else if (s_modo == SVC_GRABACION_REPRODUCIR && ev == ev_GRABACION) {
+        avanzar_reproduccion();
+    }
+}
+
+// -----------------------------------------------------------------------------
+// API
+// -----------------------------------------------------------------------------
+
+void svc_grabacion_iniciar(void) {
+#if SVC_GRABACION_MODO == SVC_GRABACION_GRABAR
+    svc_grabacion_grabar();
+#elif SVC_GRABACION_MODO == SVC_GRABACION_REPRODUCIR
+    svc_grabacion_reproducir(svc_grabacion_traza, svc_grabacion_traza_num,
+                             svc_grabacion_traza_semilla);
+#endif
+}
+
+void svc_grabacion_parar(void) {
+    if (s_modo == SVC_GRABACION_REPRODUCIR) {
+        svc_alarma_desactivar(ev_GRABACION, 0);
+        drv_botones_entrada_hw(true);
+    }
+    if (s_modo != SVC_GRABACION_INACTIVA) cancelar_suscripciones();
+    s_modo = SVC_GRABACION_INACTIVA;
+}
+
+uint32_t svc_grabacion_semilla(uint32_t propuesta) {
+    if (s_modo == SVC_GRABACION_GRABAR) {
+        s_semilla = propuesta;
+        emitir_semilla();
+    } else if (s_modo != SVC_GRABACION_REPRODUCIR) {
+        s_semilla = propuesta;
+    }
+    return s_semilla;
+}
+
+uint8_t svc_grabacion_modo(void) {
+    return s_modo;
+}
+
+uint16_t svc_grabacion_num(void) {
+    return s_num;
+}
+
+const svc_grabacion_entrada_t* svc_grabacion_buffer(void) {
+    return s_buffer;
+}
+
+void svc_grabacion_volcar(void) {
+    emitir_semilla();
+    for (uint16_t i = 0; i < s_num; i++)
+        emitir_entrada(&s_buffer[i], true);   // bloqueante: no se pierde ninguna linea
+}
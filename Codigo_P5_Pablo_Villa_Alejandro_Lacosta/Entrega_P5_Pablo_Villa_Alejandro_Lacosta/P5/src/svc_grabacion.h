@@ -0,0 +1,122 @@
+/******************************************************************************
+ * Fichero: svc_grabacion.h
+ * Proyecto: P.H.2025
+ *
+ * Grabacion y reproduccion determinista de la entrada de usuario.
+ *
+ * En modo GRABAR se anotan en RAM las pulsaciones (id y flanco), los gestos
+ * y la semilla del generador aleatorio, y cada entrada se emite por la UART
+ * como inicializador C:
+ *
+ *   SEMILLA 12345
+ *     { 1523000, 2, 1 },
+ *     ...
+ *
+ * Pegando esa salida en svc_grabacion_traza.c y compilando en modo
+ * REPRODUCIR, la misma secuencia se vuelve a encolar en rt_FIFO en los
+ * mismos instantes (relativos al inicio), con los botones fisicos
+ * deshabilitados. Sirve para repetir partidas y comparar versiones del
+ * firmware con la misma entrada.
+ *
+ * Autores:
+ *   Alejandro Lacosta
+ *   Pablo Villa
+ *
+ * Universidad de Zaragoza
+ *
+ *****************************************************************************/
+
+#ifndef SVC_GRABACION_H
+#define SVC_GRABACION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "rt_evento.h"
+
+/**
+ * @brief Modos de funcionamiento.
+ */
+#define SVC_GRABACION_INACTIVA   0
+#define SVC_GRABACION_GRABAR     1
+#define SVC_GRABACION_REPRODUCIR 2
+
+/**
+ * @brief Modo con el que arrancan las aplicaciones (svc_grabacion_iniciar).
+ */
+#ifndef SVC_GRABACION_MODO
+#define SVC_GRABACION_MODO SVC_GRABACION_INACTIVA
+#endif
+
+/**
+ * @brief Numero maximo de entradas grabadas en RAM.
+ */
+#define SVC_GRABACION_MAX 256
+
+/**
+ * @brief Entrada de la traza: evento, dato y microsegundos desde el inicio.
+ */
+typedef struct {
+    uint32_t t_us;
+    uint8_t  ev;
+    uint16_t aux;
+} svc_grabacion_entrada_t;
+
+/**
+ * @brief Traza compilada que se reproduce en modo REPRODUCIR
+ *        (definida en svc_grabacion_traza.c).
+ */
+extern const svc_grabacion_entrada_t svc_grabacion_traza[];
+extern const uint16_t svc_grabacion_traza_num;
+extern const uint32_t svc_grabacion_traza_semilla;
+
+/**
+ * @brief Arranca el servicio en el modo SVC_GRABACION_MODO. Debe llamarse
+ *        tras iniciar drv_botones y antes de sembrar el generador aleatorio:
+ *        el instante de la llamada es el origen de tiempos de la traza.
+ */
+void svc_grabacion_iniciar(void);
+
+/**
+ * @brief Empieza a grabar desde cero (origen de tiempos = ahora).
+ */
+void svc_grabacion_grabar(void);
+
+/**
+ * @brief Reproduce una traza con los botones fisicos deshabilitados.
+ * @param traza   Entradas ordenadas por tiempo
+ * @param num     Numero de entradas
+ * @param semilla Semilla que devolvera svc_grabacion_semilla()
+ */
+void svc_grabacion_reproducir(const svc_grabacion_entrada_t *traza,
+                              uint16_t num, uint32_t semilla);
+
+/**
+ * @brief Detiene la grabacion o reproduccion en curso.
+ */
+void svc_grabacion_parar(void);
+
+/**
+ * @brief Filtra la semilla del generador aleatorio.
+ *
+ * Grabando la anota y la emite; reproduciendo devuelve la grabada; en otro
+ * caso devuelve la propuesta sin cambios.
+ */
+uint32_t svc_grabacion_semilla(uint32_t propuesta);
+
+/**
+ * @brief Modo actual (SVC_GRABACION_INACTIVA, _GRABAR o _REPRODUCIR).
+ */
+uint8_t svc_grabacion_modo(void);
+
+/**
+ * @brief Entradas grabadas y buffer en RAM (para volcarlo o reproducirlo).
+ */
+uint16_t svc_grabacion_num(void);
+const svc_grabacion_entrada_t* svc_grabacion_buffer(void);
+
+/**
+ * @brief Vuelve a emitir por la UART la grabacion completa.
+ */
+void svc_grabacion_volcar(void);
+
+#endif // SVC_GRABACION_H
@@ -0,0 +1,19 @@
+/* *****************************************************************************
+ * P.H.2025: svc_grabacion_traza.c
+ * Traza que reproduce svc_grabacion con SVC_GRABACION_MODO = REPRODUCIR.
+ *
+ * Autores: Alejandro Lacosta, Pablo Villa
+ *
+ * Para reproducir una partida: pegar aqui las lineas "{ t, ev, aux }," que
+ * emite la UART en modo GRABAR, la semilla de la linea "SEMILLA n" y
+ * ajustar el numero de entradas.
+ * *****************************************************************************/
+
+#include "svc_grabacion.h"
+
+const svc_grabacion_entrada_t svc_grabacion_traza[] = {
+    { 0, 0, 0 },   // (vacia)
+};
+
+const uint16_t svc_grabacion_traza_num = 0;
+const uint32_t svc_grabacion_traza_semilla = 1;
@@ -0,0 +1,81 @@
+/* *****************************************************************************
+ * P.H.2025: svc_instantanea.c
+ * Instantanea del estado en RAM retenida
+ *
+ * Autores: Alejandro Lacosta, Pablo Villa
+ *
+ * Formato de la zona retenida:
+ *   MAGIA | longitud(16) crc16(16) | reanudaciones | datos...
+ * El CRC cubre longitud, reanudaciones y datos. Tras un arranque en frio la
+ * RAM tiene basura: la MAGIA y el CRC la descartan.
+ * *****************************************************************************/
+
+#include "svc_instantanea.h"
+#include "drv_consumo.h"
+#include <string.h>
+
+#define MAGIA  0x494E5331u      // "INS1"
+
+typedef struct {
+    uint32_t magia;
+    uint16_t len;
+    uint16_t crc;
+    uint32_t reanudaciones;
+    uint8_t  datos[SVC_INSTANTANEA_MAX_BYTES];
+} zona_t;
+
+static zona_t  *s_zona = NULL;
+static bool     s_valida = false;
+static uint32_t s_reanudaciones = 0;
+
+/* CRC-16/CCITT */
+static uint16_t crc16(uint16_t crc, const uint8_t *p, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        crc ^= (uint16_t)p[i] << 8;
+        for (uint8_t k = 0; k < 8; k++)
+            crc = (crc & 0x8000u) ? (uint16_t)((crc << 1) ^ 0x1021u) : (uint16_t)(crc << 1);
+    }
+    return crc;
+}
+
+static uint16_t crc_zona(const zona_t *z) {
+    uint16_t crc = crc16(0xFFFFu, (const uint8_t *)&z->len, sizeof(z->len));
+    crc = crc16(crc, (const uint8_t *)&z->reanudaciones, sizeof(z->reanudaciones));
+    return crc16(crc, z->datos, z->len);
+}
+
+bool svc_instantanea_iniciar(void) {
+    uint32_t bytes;
+    s_zona = (zona_t *)drv_consumo_ram_retenida(&bytes);
+    if (bytes < sizeof(zona_t)) s_zona = NULL;
+
+    s_valida = s_zona != NULL && drv_consumo_despertado()
+            && s_zona->magia == MAGIA && s_zona->len <= SVC_INSTANTANEA_MAX_BYTES
+            && s_zona->crc == crc_zona(s_zona);
+
+    s_reanudaciones = s_valida ? s_zona->reanudaciones + 1u : 0;
+    if (s_zona != NULL && !s_valida) s_zona->magia = 0;
+    return s_valida;
+}
+
+bool svc_instantanea_guardar(const void *datos, uint32_t len) {
+    if (s_zona == NULL || len > SVC_INSTANTANEA_MAX_BYTES) return false;
+
+    s_zona->magia = 0;                  // invalida mientras se escribe
+    s_zona->len = (uint16_t)len;
+    s_zona->reanudaciones = s_reanudaciones;
+    memcpy(s_zona->datos, datos, len);
+    s_zona->crc = crc_zona(s_zona);
+    s_zona->magia = MAGIA;
+    return true;
+}
+
+uint32_t svc_instantanea_recuperar(void *datos, uint32_t max) {
+    if (!s_valida) return 0;
+    memcpy(datos, s_zona->datos, (s_zona->len < max) ? s_zona->len : max);
+    return s_zona->len;
+}
+
+uint32_t svc_instantanea_reanudaciones(void) {
+    return s_reanudaciones;
+}
@@ -0,0 +1,63 @@
+/******************************************************************************
+ * Fichero: svc_instantanea.h
+ * Proyecto: P.H.2025
+ *
+ * Instantanea del estado en RAM retenida para reanudar rapido tras el
+ * apagado.
+ *
+ * En nRF despertar de SYSTEM OFF es un reset: sin esto se repite todo el
+ * arranque (lectura de la flash, animacion de inicio...). La aplicacion
+ * guarda aqui lo que necesita para seguir (parametros, record, ultima
+ * partida) justo antes de apagar y, al arrancar, si el arranque viene del
+ * apagado y la instantanea es valida, la recupera y se salta lo demas.
+ *
+ * - La zona la da drv_consumo_ram_retenida; se valida con MAGIA, longitud
+ *   y CRC-16. Un arranque en frio o un reset por WDT nunca la usan.
+ * - En LPC el power-down vuelve sin reset: nunca hay nada que recuperar.
+ *
+ * Autores:
+ *   Alejandro Lacosta
+ *   Pablo Villa
+ *
+ * Universidad de Zaragoza
+ *
+ *****************************************************************************/
+
+#ifndef SVC_INSTANTANEA_H
+#define SVC_INSTANTANEA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Tamano maximo de la instantanea de la aplicacion en bytes.
+ */
+#define SVC_INSTANTANEA_MAX_BYTES  128
+
+/**
+ * @brief Comprueba si hay una instantanea valida de un apagado anterior.
+ *        Se llama una vez al arrancar.
+ * @return true si se puede reanudar
+ */
+bool svc_instantanea_iniciar(void);
+
+/**
+ * @brief Copia la instantanea en la zona retenida (antes de apagar).
+ * @return false si no cabe
+ */
+bool svc_instantanea_guardar(const void *datos, uint32_t len);
+
+/**
+ * @brief Recupera la instantanea validada por svc_instantanea_iniciar.
+ * @param datos Destino
+ * @param max   Tamano del destino en bytes
+ * @return Longitud guardada (0 si no hay instantanea)
+ */
+uint32_t svc_instantanea_recuperar(void *datos, uint32_t max);
+
+/**
+ * @brief Reanudaciones seguidas desde el ultimo arranque en frio.
+ */
+uint32_t svc_instantanea_reanudaciones(void);
+
+#endif // SVC_INSTANTANEA_H
@@ -0,0 +1,269 @@
+/* *****************************************************************************
+ * P.H.2025: svc_kv.c
+ * Almacen clave/valor persistente en flash (log estructurado)
+ *
+ * Autores: Alejandro Lacosta, Pablo Villa
+ *
+ * Formato de una pagina (palabras de 32 bits):
+ *   [0] MAGIA   [1] secuencia   [2..] registros   [...] borrado (0xFFFFFFFF)
+ *
+ * Registro: cabecera = clave(8) | longitud(8) | crc16(16), seguida de los
+ * datos rellenos a palabra con 0xFF. La clave es < SVC_KV_CLAVES, asi que
+ * una cabecera nunca vale 0xFFFFFFFF (fin del log).
+ *
+ * Orden de escritura para tolerar cortes:
+ *  - Registro: primero los datos, la cabecera al final.
+ *  - Compactacion: primero los registros, luego la secuencia y por ultimo
+ *    la MAGIA. Hasta entonces la pagina nueva no es valida.
+ * Al montar, cualquier resto (registro con CRC erroneo, palabras escritas
+ * despues del ultimo registro) fuerza una compactacion, que solo copia lo
+ * valido.
+ * *****************************************************************************/
+
+#include "svc_kv.h"
+#include "hal_flash.h"
+#include <string.h>
+
+#define MAGIA          0x4B563031u      // "KV01"
+#define CABECERA_PAG   2u
+#define SIN_PAGINA     0xFFu
+#define PALABRAS_MAX   ((SVC_KV_MAX_BYTES + 3u) / 4u)
+
+static uint8_t  s_activa;               // pagina con el log vigente
+static uint8_t  s_reserva;              // la otra pagina
+static bool     s_reserva_sucia;        // hay que borrarla antes de usarla
+static uint32_t s_secuencia;
+static uint32_t s_fin;                  // primera palabra libre de la activa
+static uint16_t s_pos[SVC_KV_CLAVES];   // cabecera del ultimo registro (0: no hay)
+
+// Compactacion en curso
+static bool     s_compactar;
+static uint8_t  s_copia_clave;
+static uint32_t s_copia_fin;
+static uint16_t s_copia_pos[SVC_KV_CLAVES];
+
+// Valores aun no escritos en flash
+static uint32_t s_pend[SVC_KV_CLAVES][PALABRAS_MAX];
+static uint8_t  s_pend_len[SVC_KV_CLAVES];
+static uint32_t s_sucias = 0;           // bit k: clave k pendiente
+
+// -----------------------------------------------------------------------------
+// Registros
+// -----------------------------------------------------------------------------
+
+static uint32_t palabras(uint32_t len) {
+    return (len + 3u) / 4u;
+}
+
+/* CRC-16/CCITT de clave, longitud y datos */
+static uint16_t crc16(uint8_t clave, uint8_t len, const uint8_t *datos) {
+    uint8_t cab[2] = { clave, len };
+    uint16_t crc = 0xFFFFu;
+    for (uint32_t i = 0; i < 2u + len; i++) {
+        uint8_t b = (i < 2u) ? cab[i] : datos[i - 2u];
+        crc ^= (uint16_t)b << 8;
+        for (uint8_t k = 0; k < 8; k++)
+            crc = (crc & 0x8000u) ? (uint16_t)((crc << 1) ^ 0x1021u) : (uint16_t)(crc << 1);
+    }
+    return crc;
+}
+
+static uint32_t cabecera(uint8_t clave, uint8_t len, const uint32_t *datos) {
+    return ((uint32_t)clave << 24) | ((uint32_t)len << 16) |
+           crc16(clave, len, (const uint8_t *)datos);
+}
+
+static uint8_t cab_clave(uint32_t c) { return (uint8_t)(c >> 24); }
+static uint8_t cab_len(uint32_t c)   { return (uint8_t)(c >> 16); }
+
+static bool borrada_desde(uint8_t pagina, uint32_t desde) {
+    const uint32_t *p = hal_flash_pagina(pagina);
+    for (uint32_t i = desde; i < hal_flash_palabras_pagina(); i++)
+        if (p[i] != HAL_FLASH_BORRADO) return false;
+    return true;
+}
+
+/* Escribe un registro en 'pagina' a partir de 'off' (datos y luego cabecera) */
+static void escribir_registro(uint8_t pagina, uint32_t off, uint32_t cab, const uint32_t *datos) {
+    hal_flash_escribir(pagina, off + 1u, datos, palabras(cab_len(cab)));
+    hal_flash_escribir(pagina, off, &cab, 1);
+}
+
+// -----------------------------------------------------------------------------
+// Montaje
+// -----------------------------------------------------------------------------
+
+static bool pagina_valida(uint8_t pagina) {
+    return hal_flash_pagina(pagina)[0] == MAGIA;
+}
+
+/* Recorre el log de la pagina activa. Devuelve false si hay restos. */
+static bool recorrer_log(void) {
+    const uint32_t *p = hal_flash_pagina(s_activa);
+    const uint32_t n = hal_flash_palabras_pagina();
+    uint32_t off = CABECERA_PAG;
+
+    while (off < n && p[off] != HAL_FLASH_BORRADO) {
+        uint32_t cab = p[off];
+        uint8_t clave = cab_clave(cab), len = cab_len(cab);
+
+        if (clave >= SVC_KV_CLAVES || len > SVC_KV_MAX_BYTES ||
+            off + 1u + palabras(len) > n ||
+            (uint16_t)cab != crc16(clave, len, (const uint8_t *)&p[off + 1u])) {
+            s_fin = off;
+            return false;
+        }
+        s_pos[clave] = (uint16_t)off;
+        off += 1u + palabras(len);
+    }
+    s_fin = off;
+    return borrada_desde(s_activa, off);
+}
+
+void svc_kv_iniciar(void) {
+    hal_flash_iniciar();
+    memset(s_pos, 0, sizeof(s_pos));
+    s_sucias = 0;
+    s_compactar = false;
+
+    bool v0 = pagina_valida(0), v1 = pagina_valida(1);
+    if (v0 && v1) {
+        // Corte entre la cabecera nueva y el borrado de la vieja: gana la
+        // secuencia mas reciente
+        int32_t d = (int32_t)(hal_flash_pagina(1)[1] - hal_flash_pagina(0)[1]);
+        s_activa = (d > 0) ? 1 : 0;
+    } else if (v0 || v1) {
+        s_activa = v0 ? 0 : 1;
+    } else {
+        s_activa = SIN_PAGINA;
+    }
+
+    if (s_activa == SIN_PAGINA) {
+        // Flash nueva o sin ningun log completo: se formatea compactando
+        // un almacen vacio en la pagina 0
+        s_reserva = 0;
+        s_secuencia = 0;
+        s_fin = CABECERA_PAG;
+        s_compactar = true;
+    } else {
+        s_reserva = (uint8_t)(s_activa ^ 1u);
+        s_secuencia = hal_flash_pagina(s_activa)[1];
+        if (!recorrer_log()) s_compactar = true;
+    }
+    s_reserva_sucia = !borrada_desde(s_reserva, 0);
+    s_copia_clave = 0;
+    s_copia_fin = CABECERA_PAG;
+}
+
+// -----------------------------------------------------------------------------
+// Lectura / escritura
+// -----------------------------------------------------------------------------
+
+uint32_t svc_kv_leer(uint8_t clave, void *datos, uint32_t max) {
+    if (clave >= SVC_KV_CLAVES) return 0;
+
+    const void *origen;
+    uint32_t len;
+    if (s_sucias & (1u << clave)) {
+        origen = s_pend[clave];
+        len = s_pend_len[clave];
+    } else if (s_pos[clave] != 0) {
+        const uint32_t *p = hal_flash_pagina(s_activa) + s_pos[clave];
+        origen = p + 1;
+        len = cab_len(*p);
+    } else {
+        return 0;
+    }
+    memcpy(datos, origen, (len < max) ? len : max);
+    return len;
+}
+
+bool svc_kv_escribir(uint8_t clave, const void *datos, uint32_t len) {
+    if (clave >= SVC_KV_CLAVES || len > SVC_KV_MAX_BYTES) return false;
+
+    // Nada que hacer si coincide con lo que ya hay en flash
+    if (!(s_sucias & (1u << clave)) && s_pos[clave] != 0) {
+        const uint32_t *p = hal_flash_pagina(s_activa) + s_pos[clave];
+        if (cab_len(*p) == len && memcmp(p + 1, datos, len) == 0) return true;
+    }
+
+    memset(s_pend[clave], 0xFF, sizeof(s_pend[clave]));
+    memcpy(s_pend[clave], datos, len);
+    s_pend_len[clave] = (uint8_t)len;
+    s_sucias |= 1u << clave;
+    return true;
+}
+
+bool svc_kv_pendiente(void) {
+    return s_sucias != 0 || s_compactar;
+}
+
+// -----------------------------------------------------------------------------
+// Trabajo en segundo plano
+// -----------------------------------------------------------------------------
+
+/* Un paso de compactacion: copiar una clave o cerrar la pagina nueva */
+static void paso_compactar(void) {
+    if (s_copia_clave < SVC_KV_CLAVES) {
+        uint8_t k = s_copia_clave++;
+        s_copia_pos[k] = 0;
+        if (s_activa != SIN_PAGINA && s_pos[k] != 0) {
+            const uint32_t *p = hal_flash_pagina(s_activa) + s_pos[k];
+            escribir_registro(s_reserva, s_copia_fin, p[0], p + 1);
+            s_copia_pos[k] = (uint16_t)s_copia_fin;
+            s_copia_fin += 1u + palabras(cab_len(p[0]));
+        }
+        return;
+    }
+
+    // Todo copiado: la cabecera convierte la reserva en la pagina activa
+    uint32_t cab[2] = { MAGIA, s_secuencia + 1u };
+    hal_flash_escribir(s_reserva, 1, &cab[1], 1);
+    hal_flash_escribir(s_reserva, 0, &cab[0], 1);
+
+    uint8_t vieja = s_activa;
+    s_activa = s_reserva;
+    s_secuencia++;
+    s_fin = s_copia_fin;
+    memcpy(s_pos, s_copia_pos, sizeof(s_pos));
+
+    s_reserva = (uint8_t)(s_activa ^ 1u);
+    s_reserva_sucia = (vieja != SIN_PAGINA) || !borrada_desde(s_reserva, 0);
+    s_compactar = false;
+    s_copia_clave = 0;
+    s_copia_fin = CABECERA_PAG;
+}
+
+bool svc_kv_trabajar(void) {
+    // La reserva se borra antes de nada: la compactacion la necesita limpia
+    if (s_reserva_sucia) {
+        if (hal_flash_borrar_paso(s_reserva)) s_reserva_sucia = false;
+        return true;
+    }
+
+    if (s_compactar) {
+        paso_compactar();
+        return true;
+    }
+
+    if (s_sucias == 0) return false;
+
+    uint8_t k = 0;
+    while (!(s_sucias & (1u << k))) k++;
+
+    uint32_t n = 1u + palabras(s_pend_len[k]);
+    if (s_fin + n > hal_flash_palabras_pagina()) {
+        s_compactar = true;
+        return true;
+    }
+
+    escribir_registro(s_activa, s_fin, cabecera(k, s_pend_len[k], s_pend[k]), s_pend[k]);
+    s_pos[k] = (uint16_t)s_fin;
+    s_fin += n;
+    s_sucias &= ~(1u << k);
+    return true;
+}
+
+void svc_kv_sincronizar(void) {
+    while (svc_kv_pendiente()) svc_kv_trabajar();
+}
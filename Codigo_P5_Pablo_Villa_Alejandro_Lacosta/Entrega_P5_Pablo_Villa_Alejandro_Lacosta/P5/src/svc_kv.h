@@ -0,0 +1,85 @@
+/******************************************************************************
+ * Fichero: svc_kv.h
+ * Proyecto: P.H.2025
+ *
+ * Almacen clave/valor persistente en flash (log estructurado).
+ *
+ * Guarda pocos valores pequenos (records, estadisticas acumuladas,
+ * parametros ajustados) que deben sobrevivir al SYSTEM OFF y a los reinicios
+ * del watchdog.
+ *
+ * - Cada escritura anade un registro al final de la pagina activa; el valor
+ *   vigente de una clave es su ultimo registro. Asi cada palabra de flash se
+ *   escribe una vez por borrado y el desgaste se reparte por toda la pagina.
+ * - Con la pagina llena se compacta: se copia el ultimo valor de cada clave
+ *   a la otra pagina, que solo pasa a ser la activa al escribir su cabecera.
+ *   Un corte de alimentacion en cualquier punto deja la pagina anterior o
+ *   la nueva completas; un registro a medias se detecta por su CRC.
+ * - svc_kv_escribir no toca la flash: deja el valor en RAM. La escritura la
+ *   hace svc_kv_trabajar a trozos acotados cuando el sistema esta ocioso
+ *   (rt_GE_lanzador con la cola vacia), sin bloquear el juego.
+ *
+ * Autores:
+ *   Alejandro Lacosta
+ *   Pablo Villa
+ *
+ * Universidad de Zaragoza
+ *
+ *****************************************************************************/
+
+#ifndef SVC_KV_H
+#define SVC_KV_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Numero de claves (0 .. SVC_KV_CLAVES-1).
+ */
+#define SVC_KV_CLAVES     8
+
+/**
+ * @brief Tamano maximo de un valor en bytes.
+ */
+#define SVC_KV_MAX_BYTES  32
+
+/**
+ * @brief Monta el almacen: elige la pagina valida mas reciente y localiza
+ *        el ultimo registro de cada clave.
+ */
+void svc_kv_iniciar(void);
+
+/**
+ * @brief Lee el valor de una clave.
+ * @param clave Clave
+ * @param datos Destino
+ * @param max   Tamano del destino en bytes
+ * @return Longitud del valor guardado (0 si la clave no existe)
+ */
+uint32_t svc_kv_leer(uint8_t clave, void *datos, uint32_t max);
+
+/**
+ * @brief Cambia el valor de una clave. Se guarda en flash mas tarde
+ *        (svc_kv_trabajar); un valor igual al guardado no escribe nada.
+ * @return false si la clave o la longitud no son validas
+ */
+bool svc_kv_escribir(uint8_t clave, const void *datos, uint32_t len);
+
+/**
+ * @brief Hace un paso acotado de trabajo pendiente: escribir un registro,
+ *        copiar una clave en la compactacion o un tramo de borrado.
+ * @return true si queda trabajo
+ */
+bool svc_kv_trabajar(void);
+
+/**
+ * @brief true si hay valores que aun no estan en flash.
+ */
+bool svc_kv_pendiente(void);
+
+/**
+ * @brief Escribe todo lo pendiente (bloquea). Antes de dormir en SYSTEM OFF.
+ */
+void svc_kv_sincronizar(void);
+
+#endif // SVC_KV_H
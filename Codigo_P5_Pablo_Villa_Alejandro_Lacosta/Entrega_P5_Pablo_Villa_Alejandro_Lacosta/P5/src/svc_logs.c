@@ -13,6 +13,16 @@
  *****************************************************************************/
 
 #include "svc_logs.h"
+#include "svc_GE.h"
+#include <stdarg.h>
+#include <stdio.h>
+
+#define LOG_LINEA_MAX 96
+
+static uint8_t  s_nivel = LOG_LEVEL;
+static uint32_t s_descartados[LOG_LEVEL_DEBUG + 1];
+static uint32_t s_pendientes_aviso = 0;   // descartes aun no notificados
+static char     s_linea[LOG_LINEA_MAX];
 
 /**
  * Inicia el servicio de logs, internamente llama a la funcion
@@ -21,3 +31,68 @@
 void svc_logs_iniciar(void) {
     drv_uart_init(); // Inicializa UART a trav�s de la capa de abstracci�n
 }
+
+/**
+ * Fija el nivel de log en tiempo de ejecucion (acotado a LOG_LEVEL).
+ */
+void svc_logs_nivel_establecer(uint8_t nivel) {
+    s_nivel = (nivel > LOG_LEVEL) ? LOG_LEVEL : nivel;
+}
+
+uint8_t svc_logs_nivel(void) {
+    return s_nivel;
+}
+
+/**
+ * Emite el aviso de mensajes descartados si hay hueco para el. Si no lo
+ * hay, se vuelve a intentar cuando la UART acabe de transmitir.
+ */
+static void notificar_descartes(void) {
+    char aviso[40];
+    if (s_pendientes_aviso == 0) return;
+    snprintf(aviso, sizeof(aviso), "WARN: %lu mensajes descartados" ENDLINE,
+             (unsigned long)s_pendientes_aviso);
+    if (drv_uart_encolar(aviso, false)) {
+        s_pendientes_aviso = 0;
+    } else {
+        drv_uart_avisar_vacia(ev_UART_TX_VACIA);
+    }
+}
+
+static void svc_logs_tx_vacia_cb(EVENTO_T ev, uint32_t aux) {
+    (void)ev;
+    (void)aux;
+    notificar_descartes();
+}
+SVC_GE_SUSCRIPCION_ESTATICA(ev_UART_TX_VACIA, 0, svc_logs_tx_vacia_cb);
+
+/**
+ * Encola un mensaje ya formateado con politica de descarte.
+ */
+void svc_logs_escribir(uint8_t nivel, const char *msg) {
+    if (nivel == LOG_LEVEL_NONE || nivel > s_nivel) return;
+
+    notificar_descartes();
+    if (!drv_uart_encolar(msg, nivel == LOG_LEVEL_ERROR)) {
+        s_descartados[nivel]++;
+        s_pendientes_aviso++;
+        drv_uart_avisar_vacia(ev_UART_TX_VACIA);
+    }
+}
+
+/**
+ * Variante con formato. El coste esta acotado por LOG_LINEA_MAX.
+ */
+void svc_logs_printf(uint8_t nivel, const char *fmt, ...) {
+    va_list args;
+    if (nivel == LOG_LEVEL_NONE || nivel > s_nivel) return;
+
+    va_start(args, fmt);
+    vsnprintf(s_linea, sizeof(s_linea), fmt, args);
+    va_end(args);
+    svc_logs_escribir(nivel, s_linea);
+}
+
+uint32_t svc_logs_descartados(uint8_t nivel) {
+    return (nivel <= LOG_LEVEL_DEBUG) ? s_descartados[nivel] : 0;
+}
@@ -33,23 +33,39 @@
 // === Inicializacin del servicio de logs ===
 void svc_logs_iniciar(void);
 
+// === Nivel en tiempo de ejecucion ===
+// LOG_LEVEL fija el maximo compilado; este nivel filtra por debajo de el
+// y puede cambiarse en caliente (p.ej. desde la shell UART).
+void svc_logs_nivel_establecer(uint8_t nivel);
+uint8_t svc_logs_nivel(void);
+
+// === Escritura sin bloqueo ===
+// Si el mensaje no cabe en la cola de la UART se descarta y se contabiliza
+// por nivel; en cuanto vuelve a haber hueco se emite un aviso con el
+// numero de mensajes perdidos. Los ERROR van por la cola prioritaria.
+void svc_logs_escribir(uint8_t nivel, const char *msg);
+void svc_logs_printf(uint8_t nivel, const char *fmt, ...);
+
+// Mensajes descartados de un nivel desde el arranque
+uint32_t svc_logs_descartados(uint8_t nivel);
+
 // === Macros de log condicional ===
 #define ENDLINE "\r\n"
 
 #if LOG_LEVEL >= LOG_LEVEL_DEBUG
-    #define LOG_DEBUG(msg) drv_uart_send("DEBUG: " msg ENDLINE)
+    #define LOG_DEBUG(msg) svc_logs_escribir(LOG_LEVEL_DEBUG, "DEBUG: " msg ENDLINE)
 #else
     #define LOG_DEBUG(msg)
 #endif
 
 #if LOG_LEVEL >= LOG_LEVEL_INFO
-    #define LOG_INFO(msg) drv_uart_send("INFO: " msg ENDLINE)
+    #define LOG_INFO(msg) svc_logs_escribir(LOG_LEVEL_INFO, "INFO: " msg ENDLINE)
 #else
     #define LOG_INFO(msg)
 #endif
 
 #if LOG_LEVEL >= LOG_LEVEL_ERROR
-    #define LOG_ERROR(msg) drv_uart_send("ERROR: " msg ENDLINE)
+    #define LOG_ERROR(msg) svc_logs_escribir(LOG_LEVEL_ERROR, "ERROR: " msg ENDLINE)
 #else
     #define LOG_ERROR(msg)
 #endif
@@ -0,0 +1,264 @@
+/* *****************************************************************************
+ * P.H.2025: svc_shell.c
+ * Servicio de shell por linea serie (SVC_SHELL)
+ *
+ * Interprete de comandos para introspeccion en caliente. Las lineas llegan
+ * como eventos ev_UART_LINEA (encolados desde la ISR de recepcion) y se
+ * procesan en el contexto del dispatcher como cualquier otro suscriptor.
+ *
+ * Autores: Alejandro Lacosta, Pablo Villa
+ *
+ * Notas:
+ *  - Los comandos son cortos y no bloquean mas alla del envio por UART.
+ *  - Los parametros se registran desde las aplicaciones con un rango
+ *    [min, max]; la shell solo escribe valores dentro de ese rango.
+ * *****************************************************************************/
+
+#include "svc_shell.h"
+#include "svc_GE.h"
+#include "svc_alarmas.h"
+#include "svc_logs.h"
+#include "svc_energia.h"
+#include "rt_fifo.h"
+#include "drv_uart.h"
+#include "drv_tiempo.h"
+#include "drv_dominio.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_TOKENS 3
+
+typedef struct {
+    const char *nombre;
+    uint32_t   *valor;
+    uint32_t    min;
+    uint32_t    max;
+} parametro_t;
+
+static parametro_t s_params[SVC_SHELL_MAX_PARAMS];
+static uint8_t     s_num_params = 0;
+static const rt_fsm_def_t *s_fsm[SVC_SHELL_MAX_FSM];
+static uint8_t     s_num_fsm = 0;
+static EVENTO_T    s_ev_linea;
+static char        s_salida[64];
+
+// -----------------------------------------------------------------------------
+// Utilidades
+// -----------------------------------------------------------------------------
+
+static void responder(const char *msg) {
+    drv_uart_send(msg);
+    drv_uart_send("\r\n");
+}
+
+/* Convierte un token decimal a entero; false si no es un numero valido. */
+static bool parsear_numero(const char *tok, uint32_t *valor) {
+    char *fin;
+    if (tok == NULL || *tok == '\0') return false;
+    unsigned long v = strtoul(tok, &fin, 10);
+    if (*fin != '\0') return false;
+    *valor = (uint32_t)v;
+    return true;
+}
+
+static parametro_t* buscar_parametro(const char *nombre) {
+    for (uint8_t i = 0; i < s_num_params; i++)
+        if (strcmp(s_params[i].nombre, nombre) == 0)
+            return &s_params[i];
+    return NULL;
+}
+
+// -----------------------------------------------------------------------------
+// Comandos
+// -----------------------------------------------------------------------------
+
+static void cmd_help(void) {
+    responder("help | stats | reset | log [0-3] | set [nombre valor] | fsm [nombre]");
+}
+
+static void cmd_stats(void) {
+    snprintf(s_salida, sizeof(s_salida), "fifo: pendientes=%lu max=%u/%u",
+             (unsigned long)rt_FIFO_estadisticas(ev_VOID),
+             rt_FIFO_max_ocupacion(), RT_FIFO_TAM);
+    responder(s_salida);
+
+    for (uint32_t ev = 1; ev < EVENT_TYPES; ev++) {
+        snprintf(s_salida, sizeof(s_salida), "  ev %lu: %lu",
+                 (unsigned long)ev,
+                 (unsigned long)rt_FIFO_estadisticas((EVENTO_T)ev));
+        responder(s_salida);
+    }
+
+    snprintf(s_salida, sizeof(s_salida), "alarmas: %u/%u  suscritos: %u/%u (+%u fijos)",
+             svc_alarma_activas(), SVC_ALARMAS_MAX,
+             svc_GE_num_suscritos(), rt_GE_MAX_SUSCRITOS, svc_GE_num_estaticas());
+    responder(s_salida);
+
+    snprintf(s_salida, sizeof(s_salida), "tick parado: %lu veces, %lu de %lu ms",
+             (unsigned long)svc_alarma_tick_suspensiones(),
+             (unsigned long)svc_alarma_tick_suspendido_ms(),
+             (unsigned long)drv_tiempo_actual_ms());
+    responder(s_salida);
+
+    snprintf(s_salida, sizeof(s_salida), "uart rx descartados: %lu",
+             (unsigned long)drv_uart_rx_descartados());
+    responder(s_salida);
+
+    snprintf(s_salida, sizeof(s_salida), "logs descartados: E=%lu I=%lu D=%lu",
+             (unsigned long)svc_logs_descartados(LOG_LEVEL_ERROR),
+             (unsigned long)svc_logs_descartados(LOG_LEVEL_INFO),
+             (unsigned long)svc_logs_descartados(LOG_LEVEL_DEBUG));
+    responder(s_salida);
+
+    responder("energia:");
+    for (uint32_t m = 0; m < SVC_ENERGIA_MODOS; m++) {
+        snprintf(s_salida, sizeof(s_salida), "  %s: %lu veces, %lu ms",
+                 svc_energia_nombre((svc_energia_modo_t)m),
+                 (unsigned long)svc_energia_entradas((svc_energia_modo_t)m),
+                 (unsigned long)svc_energia_residencia_ms((svc_energia_modo_t)m));
+        responder(s_salida);
+    }
+
+    responder("dominios:");
+    for (uint32_t d = 0; d < DRV_DOMINIOS; d++) {
+        snprintf(s_salida, sizeof(s_salida), "  %s: %s, %lu encendidos, %lu ms",
+                 drv_dominio_nombre((drv_dominio_t)d),
+                 drv_dominio_encendido((drv_dominio_t)d) ? "on" : "off",
+                 (unsigned long)drv_dominio_encendidos((drv_dominio_t)d),
+                 (unsigned long)drv_dominio_encendido_ms((drv_dominio_t)d));
+        responder(s_salida);
+    }
+}
+
+static void cmd_reset(void) {
+    rt_FIFO_resetear_estadisticas();
+    responder("ok");
+}
+
+static void cmd_log(const char *arg) {
+    uint32_t nivel;
+    if (arg != NULL) {
+        if (!parsear_numero(arg, &nivel) || nivel > LOG_LEVEL_DEBUG) {
+            responder("error: nivel 0..3");
+            return;
+        }
+        svc_logs_nivel_establecer((uint8_t)nivel);
+    }
+    snprintf(s_salida, sizeof(s_salida), "log: %u (max %u)",
+             svc_logs_nivel(), LOG_LEVEL);
+    responder(s_salida);
+}
+
+static void cmd_set(const char *nombre, const char *arg) {
+    if (nombre == NULL) {
+        for (uint8_t i = 0; i < s_num_params; i++) {
+            snprintf(s_salida, sizeof(s_salida), "  %s = %lu [%lu..%lu]",
+                     s_params[i].nombre,
+                     (unsigned long)*s_params[i].valor,
+                     (unsigned long)s_params[i].min,
+                     (unsigned long)s_params[i].max);
+            responder(s_salida);
+        }
+        return;
+    }
+
+    parametro_t *p = buscar_parametro(nombre);
+    uint32_t valor;
+    if (p == NULL) {
+        responder("error: parametro desconocido");
+    } else if (!parsear_numero(arg, &valor) || valor < p->min || valor > p->max) {
+        snprintf(s_salida, sizeof(s_salida), "error: %s en [%lu..%lu]",
+                 p->nombre, (unsigned long)p->min, (unsigned long)p->max);
+        responder(s_salida);
+    } else {
+        *p->valor = valor;
+        responder("ok");
+    }
+}
+
+/* Sin nombre: lista las maquinas; con nombre: su tabla en Graphviz. */
+static void cmd_fsm(const char *nombre) {
+    for (uint8_t i = 0; i < s_num_fsm; i++) {
+        if (nombre == NULL) {
+            snprintf(s_salida, sizeof(s_salida), "  %s (%u estados, %u eventos)",
+                     s_fsm[i]->nombre, (unsigned)s_fsm[i]->num_estados,
+                     (unsigned)s_fsm[i]->num_eventos);
+            responder(s_salida);
+        } else if (strcmp(s_fsm[i]->nombre, nombre) == 0) {
+            rt_fsm_volcar(s_fsm[i], responder);
+            return;
+        }
+    }
+    if (nombre != NULL) responder("error: maquina desconocida");
+}
+
+// -----------------------------------------------------------------------------
+// Interprete
+// -----------------------------------------------------------------------------
+
+void svc_shell_ejecutar(const char *linea) {
+    char copia[SVC_SHELL_LINEA_MAX];
+    char *tok[MAX_TOKENS] = { NULL };
+    uint8_t n = 0;
+
+    if (linea == NULL) return;
+    strncpy(copia, linea, sizeof(copia) - 1);
+    copia[sizeof(copia) - 1] = '\0';
+
+    // Separa por espacios en como mucho MAX_TOKENS palabras
+    char *p = copia;
+    while (*p != '\0' && n < MAX_TOKENS) {
+        while (*p == ' ') *p++ = '\0';
+        if (*p == '\0') break;
+        tok[n++] = p;
+        while (*p != '\0' && *p != ' ') p++;
+    }
+    if (n == 0) return;
+
+    if      (strcmp(tok[0], "help")  == 0) cmd_help();
+    else if (strcmp(tok[0], "stats") == 0) cmd_stats();
+    else if (strcmp(tok[0], "reset") == 0) cmd_reset();
+    else if (strcmp(tok[0], "log")   == 0) cmd_log(tok[1]);
+    else if (strcmp(tok[0], "set")   == 0) cmd_set(tok[1], tok[2]);
+    else if (strcmp(tok[0], "fsm")   == 0) cmd_fsm(tok[1]);
+    else responder("error: comando desconocido (help)");
+}
+
+/* Callback del gestor de eventos: consume todas las lineas completas. */
+static void svc_shell_cb(EVENTO_T ev, uint32_t aux) {
+    char linea[SVC_SHELL_LINEA_MAX];
+    (void)aux;
+    if (ev != s_ev_linea) return;
+
+    while (drv_uart_leer_linea(linea, sizeof(linea)) > 0) {
+        svc_shell_ejecutar(linea);
+    }
+}
+
+void svc_shell_iniciar(EVENTO_T ev_linea) {
+    s_ev_linea = ev_linea;
+    drv_uart_rx_iniciar(ev_linea);
+    svc_GE_suscribir(ev_linea, 3, svc_shell_cb);
+}
+
+bool svc_shell_registrar_fsm(const rt_fsm_def_t *def) {
+    if (def == NULL || s_num_fsm >= SVC_SHELL_MAX_FSM) return false;
+    s_fsm[s_num_fsm++] = def;
+    return true;
+}
+
+bool svc_shell_registrar_parametro(const char *nombre, uint32_t *valor,
+                                   uint32_t min, uint32_t max) {
+    parametro_t *p = buscar_parametro(nombre);
+    if (p == NULL) {
+        if (s_num_params >= SVC_SHELL_MAX_PARAMS) return false;
+        p = &s_params[s_num_params++];
+    }
+    p->nombre = nombre;
+    p->valor  = valor;
+    p->min    = min;
+    p->max    = max;
+    return true;
+}
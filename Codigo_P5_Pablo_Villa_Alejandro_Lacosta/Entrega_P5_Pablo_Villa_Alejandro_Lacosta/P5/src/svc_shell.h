@@ -0,0 +1,78 @@
+/******************************************************************************
+ * Fichero: svc_shell.h
+ * Proyecto: P.H.2025
+ *
+ * Interprete de comandos sobre la linea serie. Se ejecuta como suscriptor
+ * del gestor de eventos: la UART encola ev_UART_LINEA al completar una linea
+ * y la shell la procesa en el dispatcher, sin detener el sistema.
+ *
+ * Comandos:
+ *   help                 lista de comandos
+ *   stats                estadisticas de FIFO, alarmas, suscriptores y energia
+ *   reset                pone a cero los contadores de la FIFO
+ *   log [nivel]          consulta/cambia el nivel de log (0..3)
+ *   set [nombre valor]   lista/modifica parametros registrados
+ *   fsm [nombre]         lista las maquinas de estados / vuelca una en dot
+ *
+ * Autores:
+ *   Alejandro Lacosta
+ *   Pablo Villa
+ *
+ * Universidad de Zaragoza
+ *
+ *****************************************************************************/
+
+#ifndef SVC_SHELL_H
+#define SVC_SHELL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "rt_evento.h"
+#include "rt_fsm.h"
+
+/**
+ * @brief Numero maximo de parametros ajustables registrados.
+ */
+#define SVC_SHELL_MAX_PARAMS 8
+
+/**
+ * @brief Numero maximo de maquinas de estados registradas.
+ */
+#define SVC_SHELL_MAX_FSM 4
+
+/**
+ * @brief Longitud maxima de una linea de comando (incluido '\0').
+ */
+#define SVC_SHELL_LINEA_MAX 48
+
+/**
+ * @brief Inicia la shell: habilita la recepcion UART y se suscribe al evento.
+ * @param ev_linea Evento que la UART encola al completar una linea
+ */
+void svc_shell_iniciar(EVENTO_T ev_linea);
+
+/**
+ * @brief Registra una variable de 32 bits modificable con "set".
+ * @param nombre Nombre del parametro (cadena constante)
+ * @param valor  Puntero a la variable
+ * @param min    Valor minimo admitido
+ * @param max    Valor maximo admitido
+ * @return false si la tabla de parametros esta llena
+ */
+bool svc_shell_registrar_parametro(const char *nombre, uint32_t *valor,
+                                   uint32_t min, uint32_t max);
+
+/**
+ * @brief Registra una maquina de estados para volcarla con "fsm".
+ * @param def Tabla de la maquina (constante)
+ * @return false si la tabla de maquinas esta llena
+ */
+bool svc_shell_registrar_fsm(const rt_fsm_def_t *def);
+
+/**
+ * @brief Interpreta y ejecuta una linea de comando.
+ * @param linea Cadena terminada en '\0' (sin fin de linea)
+ */
+void svc_shell_ejecutar(const char *linea);
+
+#endif // SVC_SHELL_H
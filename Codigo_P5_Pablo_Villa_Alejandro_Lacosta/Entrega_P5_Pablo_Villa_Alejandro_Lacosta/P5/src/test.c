@@ -23,6 +23,8 @@
 #include "svc_alarmas_test.h"
 #include "drv_botones_test.h"
 #include "test_wdt.h"
+#include "test_kv.h"
+#include "test_botones.h"
 #include "svc_logs.h"
 
 void ejecutar_sesion_test(uint8_t sesion) {
@@ -55,6 +57,14 @@ void ejecutar_sesion_test(uint8_t sesion) {
 					  test_fifo_run();
 					  break;
 
+        case 7:
+            test_kv_run();
+            break;
+
+        case 8:
+            test_botones_run();
+            break;
+
 
         default:
             LOG_ERROR("Sesion Test invalida");
@@ -0,0 +1,88 @@
+/* *****************************************************************************
+ * P.H.2025: test_botones.c
+ *
+ * Pruebas del antirrebotes de drv_botones con rebotes reales
+ * Autores: Alejandro Lacosta, Pablo Villa
+ *
+ * Necesita el guion host/guiones/rebote.txt en el simulador (p5_sim con
+ * P5_RUN_MODE=1 y P5_TEST_ID=8); los instantes de abajo son los suyos:
+ * - Pulsacion del boton 1 que rebota a mitad del antirrebotes: una sola
+ *   pulsacion, con la marca del primer flanco y no la del rebote
+ * - Pulsacion limpia posterior con la marca de su flanco
+ * - Tantas liberaciones como pulsaciones
+ *
+ * Los resultados se muestran mediante LEDs de estado al soltar la segunda.
+ *
+ ******************************************************************************/
+
+#include "test_botones.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include "drv_botones.h"
+#include "drv_leds.h"
+#include "drv_tiempo.h"
+#include "drv_consumo.h"
+#include "rt_GE.h"
+#include "svc_GE.h"
+
+/* ----------------- CONFIGURACION LEDS ----------------- */
+#define LED_BOT_UNICA      1
+#define LED_BOT_REBOTE     2
+#define LED_BOT_LIMPIA     3
+#define LED_BOT_SUELTAS    4
+
+/* ----------------- GUION (host/guiones/rebote.txt) ----------------- */
+#define FLANCO_REBOTE_US   1000000u
+#define FLANCO_LIMPIO_US   2000000u
+#define NUM_PULSACIONES    2u
+
+static uint32_t    s_pulsaciones = 0;
+static uint32_t    s_liberaciones = 0;
+static Tiempo_us_t s_ts[NUM_PULSACIONES];
+
+/* ----------------- HELPERS ----------------- */
+static bool TEST_ASSERT(bool condition) {
+    return condition;
+}
+
+/* Marca del flanco, salvo el coste de despertar del simulador */
+static bool es_flanco(Tiempo_us_t ts, Tiempo_us_t flanco) {
+    return ts >= flanco && ts - flanco < 1000u;
+}
+
+static void veredicto(void) {
+    bool ok1 = TEST_ASSERT(s_pulsaciones == NUM_PULSACIONES);
+    bool ok2 = TEST_ASSERT(es_flanco(s_ts[0], FLANCO_REBOTE_US));
+    bool ok3 = TEST_ASSERT(es_flanco(s_ts[1], FLANCO_LIMPIO_US));
+    bool ok4 = TEST_ASSERT(s_liberaciones == s_pulsaciones);
+
+    drv_led_establecer(LED_BOT_UNICA,   ok1 ? LED_ON : LED_OFF);
+    drv_led_establecer(LED_BOT_REBOTE,  ok2 ? LED_ON : LED_OFF);
+    drv_led_establecer(LED_BOT_LIMPIA,  ok3 ? LED_ON : LED_OFF);
+    drv_led_establecer(LED_BOT_SUELTAS, ok4 ? LED_ON : LED_OFF);
+}
+
+static void test_botones_cb(EVENTO_T ev, uint32_t aux) {
+    if (ev == ev_PULSAR_BOTON) {
+        if (s_pulsaciones < NUM_PULSACIONES)
+            s_ts[s_pulsaciones] = drv_botones_ts_pulsacion((uint8_t)aux);
+        s_pulsaciones++;
+    } else if (ev == ev_SOLTAR_BOTON) {
+        if (++s_liberaciones == NUM_PULSACIONES) veredicto();
+    }
+}
+
+/* ----------------- WRAPPER GENERAL ----------------- */
+bool test_botones_run(void) {
+    drv_leds_iniciar();
+    drv_tiempo_iniciar();
+    drv_consumo_iniciar();
+
+    rt_GE_iniciar(10);
+    drv_botones_iniciar(test_botones_cb, ev_PULSAR_BOTON, ev_SOLTAR_BOTON);
+    svc_GE_suscribir(ev_PULSAR_BOTON, 2, test_botones_cb);
+    svc_GE_suscribir(ev_SOLTAR_BOTON, 2, test_botones_cb);
+
+    rt_GE_lanzador();
+    return false;
+}
@@ -0,0 +1,20 @@
+/* *****************************************************************************
+ * P.H.2025: test_botones.h
+ *
+ * Modulo de pruebas del antirrebotes de drv_botones
+ * Autores: Alejandro Lacosta, Pablo Villa
+ *
+ * Define la interfaz de la prueba de rebotes, pensada para el simulador
+ * con el guion host/guiones/rebote.txt.
+ *
+ ******************************************************************************/
+
+#ifndef TEST_BOTONES_H
+#define TEST_BOTONES_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+bool test_botones_run(void);
+
+#endif // TEST_BOTONES_H
@@ -0,0 +1,108 @@
+/* *****************************************************************************
+ * P.H.2025: test_kv.c
+ *
+ * Pruebas funcionales del modulo svc_kv
+ * Autores: Alejandro Lacosta, Pablo Villa
+ *
+ * Comprueba el almacen clave/valor sobre la flash de datos:
+ * - Escritura diferida y lectura tras volver a montar
+ * - Escrituras repetidas sin cambios (no gastan flash)
+ * - Compactacion: el log da varias vueltas a las paginas sin perder claves
+ *
+ * Los resultados se muestran mediante LEDs de estado.
+ * Ojo: borra los datos guardados (record, historico, parametros).
+ *
+ ******************************************************************************/
+
+#include "test_kv.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include "svc_kv.h"
+#include "hal_flash.h"
+#include "drv_leds.h"
+#include "drv_tiempo.h"
+#include "drv_consumo.h"
+
+/* ----------------- CONFIGURACION LEDS ----------------- */
+#define LED_KV_MONTAR      1
+#define LED_KV_IGUAL       2
+#define LED_KV_COMPACTAR   3
+#define LED_KV_PENDIENTE   4
+
+#define CLAVE_A            6
+#define CLAVE_B            7
+
+/* ----------------- HELPERS ----------------- */
+static bool TEST_ASSERT(bool condition) {
+    return condition;
+}
+
+static uint32_t leer_u32(uint8_t clave) {
+    uint32_t v = 0;
+    return (svc_kv_leer(clave, &v, sizeof(v)) == sizeof(v)) ? v : 0xDEADu;
+}
+
+/* ----------------- TEST 1: Montar y leer ----------------- */
+static bool test_montar(void) {
+    uint32_t v = 0x12345678u;
+    svc_kv_iniciar();
+    svc_kv_escribir(CLAVE_A, &v, sizeof(v));
+    bool antes = TEST_ASSERT(leer_u32(CLAVE_A) == v && svc_kv_pendiente());
+
+    svc_kv_sincronizar();
+    svc_kv_iniciar();                       // vuelve a leer la flash
+    return antes && TEST_ASSERT(leer_u32(CLAVE_A) == v);
+}
+
+/* ----------------- TEST 2: Valor igual ----------------- */
+static bool test_igual(void) {
+    uint32_t v = leer_u32(CLAVE_A);
+    svc_kv_escribir(CLAVE_A, &v, sizeof(v));
+    return TEST_ASSERT(!svc_kv_pendiente());
+}
+
+/* ----------------- TEST 3: Compactacion ----------------- */
+static bool test_compactar(void) {
+    uint32_t b = 0xCAFEu;
+    svc_kv_escribir(CLAVE_B, &b, sizeof(b));
+    svc_kv_sincronizar();
+
+    // Cada registro ocupa 2 palabras: al menos dos vueltas completas
+    uint32_t n = 2u * hal_flash_palabras_pagina();
+    for (uint32_t i = 0; i < n; i++) {
+        svc_kv_escribir(CLAVE_A, &i, sizeof(i));
+        while (svc_kv_trabajar()) { }
+    }
+
+    svc_kv_iniciar();
+    return TEST_ASSERT(leer_u32(CLAVE_A) == n - 1u && leer_u32(CLAVE_B) == b);
+}
+
+/* ----------------- TEST 4: Nada pendiente ----------------- */
+static bool test_pendiente(void) {
+    uint32_t v = 7;
+    svc_kv_escribir(CLAVE_A, &v, sizeof(v));
+    svc_kv_escribir(CLAVE_B, &v, sizeof(v));
+    svc_kv_sincronizar();
+    return TEST_ASSERT(!svc_kv_pendiente() && leer_u32(CLAVE_B) == v);
+}
+
+/* ----------------- WRAPPER GENERAL ----------------- */
+bool test_kv_run(void) {
+    drv_leds_iniciar();
+    drv_tiempo_iniciar();
+
+    bool ok1 = test_montar();
+    bool ok2 = test_igual();
+    bool ok3 = test_compactar();
+    bool ok4 = test_pendiente();
+
+    drv_led_establecer(LED_KV_MONTAR,    ok1 ? LED_ON : LED_OFF);
+    drv_led_establecer(LED_KV_IGUAL,     ok2 ? LED_ON : LED_OFF);
+    drv_led_establecer(LED_KV_COMPACTAR, ok3 ? LED_ON : LED_OFF);
+    drv_led_establecer(LED_KV_PENDIENTE, ok4 ? LED_ON : LED_OFF);
+
+    while (1) {
+        drv_consumo_dormir();  // Mantener estado para inspeccion
+    }
+}
@@ -0,0 +1,20 @@
+/* *****************************************************************************
+ * P.H.2025: test_kv.h
+ *
+ * Modulo de pruebas para svc_kv
+ * Autores: Alejandro Lacosta, Pablo Villa
+ *
+ * Define la interfaz del conjunto de pruebas automaticas del almacen
+ * persistente.
+ *
+ ******************************************************************************/
+
+#ifndef TEST_KV_H
+#define TEST_KV_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+bool test_kv_run(void);
+
+#endif // TEST_KV_H